@@ -0,0 +1,680 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+"""
+Micro-benchmarks de los bloques gr-howto (GNU Radio 3.7).
+
+Cada caso arma un flowgraph corto (fuente -> head -> bloque -> null_sink),
+lo corre hasta el final y reporta el throughput en Msps.
+
+Uso:
+    howto_bench.py                 # corre todos los casos
+    howto_bench.py detector_exp    # solo los casos cuyo nombre empieza asi
+    howto_bench.py -n 20000000     # cambia la cantidad de muestras
+"""
+from __future__ import print_function
+import argparse
+import time
+from collections import OrderedDict
+
+import numpy as np
+import pmt
+from gnuradio import gr, blocks
+import howto
+
+BENCHES = OrderedDict()
+
+
+def bench(name):
+    """Registra un caso de benchmark bajo 'name'."""
+    def deco(fn):
+        BENCHES[name] = fn
+        return fn
+    return deco
+
+
+def run_tb(tb):
+    t0 = time.time()
+    tb.run()
+    return time.time() - t0
+
+
+def report(name, nitems, dt, extra=''):
+    print('%-36s %10d items %8.3f s %9.2f Msps  %s'
+          % (name, nitems, dt, nitems / dt / 1e6, extra))
+
+
+def float_source(n_unique=8192, tags=()):
+    x = np.random.randn(n_unique).astype(np.float32)
+    return blocks.vector_source_f(x.tolist(), True, 1, list(tags))
+
+
+# ---------------------------------------------------------------------------
+# detector_exp_ff: throughput con inundacion de tags (p.ej. rx_time por paquete)
+# ---------------------------------------------------------------------------
+def _rx_time_tags(n_unique, every):
+    tags = []
+    for off in range(0, n_unique, every):
+        t = gr.tag_t()
+        t.offset = off
+        t.key = pmt.intern('rx_time')
+        t.value = pmt.make_tuple(pmt.from_uint64(off), pmt.from_double(0.0))
+        tags.append(t)
+    return tags
+
+
+def _bench_detector_exp_tags(nitems, every):
+    n_unique = 8192
+    tb = gr.top_block()
+    tags = _rx_time_tags(n_unique, every) if every else []
+    src = float_source(n_unique, tags)
+    hd = blocks.head(gr.sizeof_float, nitems)
+    dut = howto.detector_exp_ff(50)
+    dut.set_Ton(1e9)                       # sin eventos: solo tags de entrada
+    snk0 = blocks.null_sink(gr.sizeof_float)
+    snk1 = blocks.tag_debug(gr.sizeof_float, 'env', 'rx_time')
+    snk1.set_display(False)
+    tb.connect(src, hd, dut)
+    tb.connect((dut, 0), snk0)
+    tb.connect((dut, 1), snk1)
+    dt = run_tb(tb)
+    ntags = snk1.num_tags()
+    return dt, ntags
+
+
+@bench('detector_exp_ff/no_tags')
+def b_detector_exp_no_tags(nitems):
+    dt, _ = _bench_detector_exp_tags(nitems, 0)
+    report('detector_exp_ff/no_tags', nitems, dt)
+
+
+@bench('detector_exp_ff/tags_every_64')
+def b_detector_exp_tags(nitems):
+    dt, ntags = _bench_detector_exp_tags(nitems, 64)
+    report('detector_exp_ff/tags_every_64', nitems, dt,
+           '%.2f Mtags/s (%d tags on env)' % (ntags / dt / 1e6, ntags))
+
+
+# ---------------------------------------------------------------------------
+# dual_decimate_ff: kernels especializados (D = 2..32) vs generico
+# ---------------------------------------------------------------------------
+def _bench_dual_decimate(nitems, D0, D1):
+    tb = gr.top_block()
+    src0 = float_source()
+    src1 = float_source()
+    hd0 = blocks.head(gr.sizeof_float, nitems)
+    hd1 = blocks.head(gr.sizeof_float, nitems)
+    dut = howto.dual_decimate_ff(D0, D1)
+    tb.connect(src0, hd0, (dut, 0))
+    tb.connect(src1, hd1, (dut, 1))
+    tb.connect((dut, 0), blocks.null_sink(gr.sizeof_float))
+    tb.connect((dut, 1), blocks.null_sink(gr.sizeof_float))
+    return run_tb(tb)
+
+
+def _make_dual_decimate_bench(D0, D1):
+    name = 'dual_decimate_ff/D%d_D%d' % (D0, D1)
+
+    def fn(nitems):
+        report(name, 2 * nitems, _bench_dual_decimate(nitems, D0, D1))
+    BENCHES[name] = fn
+
+for _D0, _D1 in [(2, 2), (4, 4), (8, 8), (16, 16), (32, 32), (7, 13), (100, 100)]:
+    _make_dual_decimate_bench(_D0, _D1)
+
+
+# ---------------------------------------------------------------------------
+# D asimetrico: dual_decimate_ff (lockstep) vs dual_decimate_lanes_ff.
+# Cada puerto recibe nitems; se reporta el throughput de entrada por puerto.
+# ---------------------------------------------------------------------------
+def _bench_dual_asym(nitems, make, D0, D1):
+    tb = gr.top_block()
+    dut = make(D0, D1)
+    sinks = []
+    for port in (0, 1):
+        src = float_source()
+        hd = blocks.head(gr.sizeof_float, nitems)
+        snk = blocks.null_sink(gr.sizeof_float)
+        tb.connect(src, hd, (dut, port))
+        tb.connect((dut, port), snk)
+    return run_tb(tb)
+
+
+def _make_dual_asym_bench(label, make, D0, D1):
+    name = 'dual_decimate_asym/%s_D%d_D%d' % (label, D0, D1)
+
+    def fn(nitems):
+        dt = _bench_dual_asym(nitems, make, D0, D1)
+        report(name, 2 * nitems, dt, '%.2f Msps/port' % (nitems / dt / 1e6))
+    BENCHES[name] = fn
+
+for _D0, _D1 in [(2, 1000), (4, 64)]:
+    _make_dual_asym_bench('lockstep', howto.dual_decimate_ff, _D0, _D1)
+    _make_dual_asym_bench('lanes', howto.dual_decimate_lanes_ff, _D0, _D1)
+
+
+# ---------------------------------------------------------------------------
+# Cadena de potencia: iq_mag_cf -> square_ff -> gain_ff vs pointwise_chain_cf
+# ---------------------------------------------------------------------------
+def complex_source(n_unique=8192):
+    x = (np.random.randn(n_unique) + 1j * np.random.randn(n_unique)).astype(np.complex64)
+    return blocks.vector_source_c(x.tolist(), True)
+
+
+@bench('power_chain/separate_blocks')
+def b_power_chain_separate(nitems):
+    tb = gr.top_block()
+    hd = blocks.head(gr.sizeof_gr_complex, nitems)
+    tb.connect(complex_source(), hd, howto.iq_mag_cf(1.0), howto.square_ff(),
+               howto.gain_ff(2.0), blocks.null_sink(gr.sizeof_float))
+    report('power_chain/separate_blocks', nitems, run_tb(tb))
+
+
+@bench('power_chain/pointwise_chain_cf')
+def b_power_chain_fused(nitems):
+    tb = gr.top_block()
+    hd = blocks.head(gr.sizeof_gr_complex, nitems)
+    tb.connect(complex_source(), hd, howto.pointwise_chain_cf(0, True, 2.0),
+               blocks.null_sink(gr.sizeof_float))
+    report('power_chain/pointwise_chain_cf', nitems, run_tb(tb))
+
+
+# ---------------------------------------------------------------------------
+# square_ff / gain_ff (sync_block + VOLK): costo por llamada a work().
+# Con max_noutput_items chico domina el overhead del scheduler; la diferencia
+# de tiempo entre tamanos de llamada estima los ns por llamada.
+# ---------------------------------------------------------------------------
+def _bench_pointwise_ff(nitems, make, max_nout):
+    tb = gr.top_block()
+    hd = blocks.head(gr.sizeof_float, nitems)
+    dut = make()
+    dut.set_max_noutput_items(max_nout)
+    tb.connect(float_source(), hd, dut, blocks.null_sink(gr.sizeof_float))
+    return run_tb(tb)
+
+
+def _make_call_overhead_bench(label, make):
+    name = '%s/call_overhead' % label
+
+    def fn(nitems):
+        times = {}
+        for max_nout in (64, 1024, 8192):
+            dt = _bench_pointwise_ff(nitems, make, max_nout)
+            times[max_nout] = dt
+            report('%s/max_nout_%d' % (label, max_nout), nitems, dt,
+                   '%.0f ns/call' % (dt / (float(nitems) / max_nout) * 1e9))
+        calls_small = float(nitems) / 64
+        calls_big = float(nitems) / 8192
+        per_call = (times[64] - times[8192]) / (calls_small - calls_big)
+        print('%-36s ~%.0f ns scheduler overhead per work() call' % (name, per_call * 1e9))
+    BENCHES[name] = fn
+
+_make_call_overhead_bench('square_ff', howto.square_ff)
+_make_call_overhead_bench('gain_ff', lambda: howto.gain_ff(0.5))
+
+
+# ---------------------------------------------------------------------------
+# Entrada sc16 del front end: conversion short-to-complex + bloque cf/cc
+# vs variantes sc16 nativas (la mitad de bytes de entrada, sin etapa extra)
+# ---------------------------------------------------------------------------
+def sc16_source(n_unique=8192):
+    x = np.random.randint(-32768, 32768, size=2 * n_unique)
+    return blocks.vector_source_s(x.tolist(), True, 2)
+
+
+def _bench_sc16(nitems, make_chain, out_size):
+    tb = gr.top_block()
+    hd = blocks.head(2 * gr.sizeof_short, nitems)
+    chain = make_chain()
+    tb.connect(sc16_source(), hd, chain[0])
+    for a, b in zip(chain, chain[1:]):
+        tb.connect(a, b)
+    tb.connect(chain[-1], blocks.null_sink(out_size))
+    return run_tb(tb)
+
+
+def _s2c():
+    return blocks.interleaved_short_to_complex(True, False)   # entrada vlen 2
+
+
+def _make_sc16_bench(label, make_chain, out_size):
+    name = 'sc16_input/%s' % label
+
+    def fn(nitems):
+        report(name, nitems, _bench_sc16(nitems, make_chain, out_size))
+    BENCHES[name] = fn
+
+_make_sc16_bench('s2c+iq_select_cf',
+                 lambda: [_s2c(), howto.iq_select_cf(1.0 / 32768, 0)], gr.sizeof_float)
+_make_sc16_bench('iq_select_sc16f',
+                 lambda: [howto.iq_select_sc16f(1.0, 0)], gr.sizeof_float)
+_make_sc16_bench('s2c+flex_fir_cc',
+                 lambda: [_s2c(), howto.flex_fir_cc(0, 1e6, 1e5, 0, 1e5, 1.0 / 32768)],
+                 gr.sizeof_gr_complex)
+_make_sc16_bench('flex_fir_sc16c/float',
+                 lambda: [howto.flex_fir_sc16c(0, 1e6, 1e5, 0, 1e5, 1.0, False)],
+                 gr.sizeof_gr_complex)
+_make_sc16_bench('flex_fir_sc16c/fixed',
+                 lambda: [howto.flex_fir_sc16c(0, 1e6, 1e5, 0, 1e5, 1.0, True)],
+                 gr.sizeof_gr_complex)
+
+
+# flex_fir_cf: filtro complejo + complex_to_real vs kernel de un solo carril
+def _make_flex_cf_bench(label, make_chain):
+    name = 'flex_fir_cf/%s' % label
+
+    def fn(nitems):
+        tb = gr.top_block()
+        hd = blocks.head(gr.sizeof_gr_complex, nitems)
+        chain = make_chain()
+        tb.connect(complex_source(), hd, chain[0])
+        for a, b in zip(chain, chain[1:]):
+            tb.connect(a, b)
+        tb.connect(chain[-1], blocks.null_sink(gr.sizeof_float))
+        report(name, nitems, run_tb(tb))
+    BENCHES[name] = fn
+
+_make_flex_cf_bench('cc+complex_to_real',
+                    lambda: [howto.flex_fir_cc(0, 1e6, 1e5, 0, 1e4, 1.0), blocks.complex_to_real()])
+_make_flex_cf_bench('real',
+                    lambda: [howto.flex_fir_cf(0, 1e6, 1e5, 0, 1e4, 1.0, 0)])
+_make_flex_cf_bench('mag',
+                    lambda: [howto.flex_fir_cf(0, 1e6, 1e5, 0, 1e4, 1.0, 2)])
+
+
+# flex_fir_ff: regla 4*fs/width vs largo Kaiser para la atenuacion pedida
+def _make_flex_spec_bench(atten):
+    name = 'flex_fir_ff/atten%d' % atten if atten else 'flex_fir_ff/legacy'
+
+    def fn(nitems):
+        tb = gr.top_block()
+        hd = blocks.head(gr.sizeof_float, nitems)
+        blk = howto.flex_fir_ff(0, 1e6, 1e5, 0, 1e4, 1.0, atten)
+        tb.connect(float_source(), hd, blk, blocks.null_sink(gr.sizeof_float))
+        report(name, nitems, run_tb(tb),
+               'taps=%d macs/sample=%d' % (blk.ntaps(), blk.macs_per_sample()))
+    BENCHES[name] = fn
+
+for _A in (0, 40, 60, 80):
+    _make_flex_spec_bench(_A)
+
+
+# fixed_fir (taps compilados, generados con howto_fixed_fir_gen.py) vs
+# filter.fir_filter_ccf con los mismos taps (largo de runtime)
+def _make_fixed_fir_bench(label, make):
+    name = 'fixed_fir/%s' % label
+
+    def fn(nitems):
+        from gnuradio import filter as grfilter
+        fixed = make()
+        D = fixed.decimation()
+        for tag, blk in (('runtime', grfilter.fir_filter_ccf(D, fixed.taps())), ('fixed', fixed)):
+            tb = gr.top_block()
+            hd = blocks.head(gr.sizeof_gr_complex, nitems)
+            tb.connect(complex_source(), hd, blk, blocks.null_sink(gr.sizeof_gr_complex))
+            report('%s/%s' % (name, tag), nitems, run_tb(tb), 'taps=%d D=%d' % (len(fixed.taps()), D))
+    BENCHES[name] = fn
+
+_make_fixed_fir_bench('N15', howto.fixed_lp15_cc)
+_make_fixed_fir_bench('N31', howto.fixed_lp31_cc)
+_make_fixed_fir_bench('N63', howto.fixed_lp63_cc)
+_make_fixed_fir_bench('N63_D4', howto.fixed_aa_decim4_cc)
+
+
+# flex_fir_cc de ~2000 taps (20 MS/s, transicion 40 kHz) repartido en N hilos
+def _make_flex_threads_bench(nthreads):
+    name = 'flex_fir_cc/T2001/threads%d' % nthreads
+
+    def fn(nitems):
+        tb = gr.top_block()
+        hd = blocks.head(gr.sizeof_gr_complex, nitems // 10)
+        blk = howto.flex_fir_cc(0, 20e6, 1e6, 0, 4e4, 1.0)
+        blk.set_threads(nthreads, list(range(1, nthreads)))
+        tb.connect(complex_source(), hd, blk, blocks.null_sink(gr.sizeof_gr_complex))
+        report(name, nitems // 10, run_tb(tb), 'macs/sample=%d' % blk.macs_per_sample())
+    BENCHES[name] = fn
+
+for _T in (1, 2, 4, 8):
+    _make_flex_threads_bench(_T)
+
+
+# set_accumulation() en un flex_fir_cc de ~4000 taps: throughput de cada politica
+# y su error contra double, con una entrada de rango dinamico alto (picos de 60 dB)
+ACC_NAMES = ('float', 'split', 'double')
+
+
+def _flex_acc_out(acc, x):
+    blk = howto.flex_fir_cc(0, 1e6, 1e5, 0, 1e3, 1.0)
+    blk.set_accumulation(acc)
+    tb = gr.top_block()
+    snk = blocks.vector_sink_c()
+    tb.connect(blocks.vector_source_c(x.tolist(), False), blk, snk)
+    tb.run()
+    return np.array(snk.data(), dtype=np.complex64)
+
+
+def _make_acc_bench(acc):
+    name = 'flex_fir_cc/T4001/acc_%s' % ACC_NAMES[acc]
+
+    def fn(nitems):
+        rng = np.random.RandomState(1)
+        x = (rng.randn(50000) + 1j * rng.randn(50000)).astype(np.complex64)
+        x[::101] *= 1e3
+        y, ref = _flex_acc_out(acc, x), _flex_acc_out(2, x)
+        err = np.max(np.abs(y - ref)) / np.max(np.abs(ref))
+        tb = gr.top_block()
+        hd = blocks.head(gr.sizeof_gr_complex, nitems // 10)
+        blk = howto.flex_fir_cc(0, 1e6, 1e5, 0, 1e3, 1.0)
+        blk.set_accumulation(acc)
+        tb.connect(complex_source(), hd, blk, blocks.null_sink(gr.sizeof_gr_complex))
+        report(name, nitems // 10, run_tb(tb),
+               'max err vs double = %.1e of peak (%.0f dB)' % (err, 20 * np.log10(err + 1e-30)))
+    BENCHES[name] = fn
+
+for _A in range(3):
+    _make_acc_bench(_A)
+
+
+# ---------------------------------------------------------------------------
+# decimate_fir_cc: taps firdes (simetricos -> producto plegado)
+# ---------------------------------------------------------------------------
+def _bench_decimate_fir(nitems, D, trans_frac=0.1, make=None):
+    fs = 1e6
+    cutoff = 0.4 * fs / D
+    trans = trans_frac * fs / D
+    tb = gr.top_block()
+    hd = blocks.head(gr.sizeof_gr_complex, nitems)
+    if make is None:
+        dut = howto.decimate_fir_cc(D, fs, cutoff, trans, 0, 6.76)  # WIN_HAMMING
+    else:
+        dut = make(D, fs, cutoff, trans)
+    tb.connect(complex_source(), hd, dut, blocks.null_sink(gr.sizeof_gr_complex))
+    return run_tb(tb)
+
+
+def _make_decimate_fir_bench(D):
+    name = 'decimate_fir_cc/D%d' % D
+
+    def fn(nitems):
+        report(name, nitems, _bench_decimate_fir(nitems, D))
+    BENCHES[name] = fn
+
+for _D in (2, 8, 32):
+    _make_decimate_fir_bench(_D)
+
+
+# cutoff en el Nyquist de salida: cascada half-band vs FIR unico (cutoff 1% abajo)
+def _make_halfband_bench(D):
+    fs = 1e6
+
+    def hb(nitems):
+        name = 'decimate_fir_cc/halfband_D%d' % D
+        make = lambda D_, fs_, c_, t_: howto.decimate_fir_cc(D_, fs_, fs_ / (2 * D_), t_, 0, 6.76, True)
+        report(name, nitems, _bench_decimate_fir(nitems, D, make=make))
+
+    def single(nitems):
+        name = 'decimate_fir_cc/single_D%d' % D
+        make = lambda D_, fs_, c_, t_: howto.decimate_fir_cc(D_, fs_, 0.98 * fs_ / (2 * D_), t_, 0, 6.76)
+        report(name, nitems, _bench_decimate_fir(nitems, D, make=make))
+    BENCHES['decimate_fir_cc/halfband_D%d' % D] = hb
+    BENCHES['decimate_fir_cc/single_D%d' % D] = single
+
+for _D in (2, 8):
+    _make_halfband_bench(_D)
+
+
+# planner multi-etapa vs FIR unico, cutoff 0.4*fs/D y transicion 0.1*fs/D
+def _make_multistage_bench(D):
+    name = 'decimate_fir_cc/plan_D%d' % D
+
+    def fn(nitems):
+        for ms in (False, True):
+            plan = []
+
+            def make(D_, fs_, c_, t_):
+                blk = howto.decimate_fir_cc(D_, fs_, c_, t_, 0, 6.76, ms)
+                plan.append(blk.plan())
+                return blk
+            dt = _bench_decimate_fir(nitems, D, make=make)
+            report('%s/%s' % (name, 'multi' if ms else 'single'), nitems, dt, plan[0])
+    BENCHES[name] = fn
+
+for _D in (16, 64, 256, 1024):
+    _make_multistage_bench(_D)
+
+
+# cic_decim_cc (R = D/2, N = 4) + compensador decimando x2 vs FIR unico
+def _make_cic_bench(D):
+    name = 'cic_decim_cc/D%d' % D
+
+    def fn(nitems):
+        def cic(D_, fs_, c_, t_):
+            return howto.cic_decim_cc(D_ // 2, 4, fs_, True, 2, c_, t_, 0, 6.76)
+
+        def fir(D_, fs_, c_, t_):
+            return howto.decimate_fir_cc(D_, fs_, c_, t_, 0, 6.76, False)
+        report(name + '/cic_comp', nitems, _bench_decimate_fir(nitems, D, make=cic))
+        report(name + '/fir_single', nitems, _bench_decimate_fir(nitems, D, make=fir))
+    BENCHES[name] = fn
+
+for _D in (100, 1000):
+    _make_cic_bench(_D)
+
+
+# rational_resampler_cc vs filter.rational_resampler_ccf con los mismos taps
+def _make_resampler_bench(L, M):
+    name = 'rational_resampler_cc/%d_%d' % (L, M)
+
+    def fn(nitems):
+        from gnuradio import filter as grfilter
+        fs = 1e6
+        fo = min(fs, fs * L / float(M))
+        dut = howto.rational_resampler_cc(L, M, fs, 0.4 * fo, 0.1 * fo, 0, 6.76)
+        ref = grfilter.rational_resampler_ccf(L, M, dut.taps())
+        for label, blk in (('howto', dut), ('gr_filter', ref)):
+            tb = gr.top_block()
+            hd = blocks.head(gr.sizeof_gr_complex, nitems)
+            tb.connect(complex_source(), hd, blk, blocks.null_sink(gr.sizeof_gr_complex))
+            report('%s/%s' % (name, label), nitems, run_tb(tb),
+                   '%d MAC/out' % dut.taps_per_phase())
+    BENCHES[name] = fn
+
+for _L, _M in ((3, 2), (2, 3), (147, 160), (625, 768), (4, 1), (1, 4)):
+    _make_resampler_bench(_L, _M)
+
+
+# rotator_cc -> decimate_fir_cc (FIR unico) vs freq_xlating_decimate_fir_cc
+def _make_xlating_bench(D):
+    name = 'freq_xlating_decimate_fir_cc/D%d' % D
+
+    def fn(nitems):
+        fs, f0 = 1e6, 0.123 * 1e6
+        cutoff, trans = 0.4 * fs / D, 0.1 * fs / D
+        for label in ('rotator+decim', 'fused'):
+            tb = gr.top_block()
+            hd = blocks.head(gr.sizeof_gr_complex, nitems)
+            if label == 'fused':
+                chain = [howto.freq_xlating_decimate_fir_cc(D, fs, f0, cutoff, trans, 0, 6.76)]
+            else:
+                chain = [blocks.rotator_cc(-2 * np.pi * f0 / fs),
+                         howto.decimate_fir_cc(D, fs, cutoff, trans, 0, 6.76, False)]
+            tb.connect(complex_source(), hd, *chain)
+            tb.connect(chain[-1], blocks.null_sink(gr.sizeof_gr_complex))
+            report('%s/%s' % (name, label), nitems, run_tb(tb))
+    BENCHES[name] = fn
+
+for _D in (4, 16):
+    _make_xlating_bench(_D)
+
+
+# pfb_channelizer_cc vs M freq_xlating_decimate_fir_cc en paralelo
+def _make_channelizer_bench(M):
+    name = 'pfb_channelizer_cc/M%d' % M
+
+    def fn(nitems):
+        fs = 1e6
+        cutoff, trans = 0.5 * fs / M, 0.2 * fs / M
+        for label in ('xlating_x%d' % M, 'pfb'):
+            tb = gr.top_block()
+            hd = blocks.head(gr.sizeof_gr_complex, nitems)
+            tb.connect(complex_source(), hd)
+            if label == 'pfb':
+                pfb = howto.pfb_channelizer_cc(M, fs, cutoff, trans)
+                tb.connect(hd, pfb)
+                outs = [(pfb, k) for k in range(M)]
+            else:
+                outs = [howto.freq_xlating_decimate_fir_cc(M, fs, k * fs / M, cutoff, trans, 0, 6.76)
+                        for k in range(M)]
+                for o in outs:
+                    tb.connect(hd, o)
+            for o in outs:
+                tb.connect(o, blocks.null_sink(gr.sizeof_gr_complex))
+            report('%s/%s' % (name, label), nitems, run_tb(tb))
+    BENCHES[name] = fn
+
+for _M in (8, 32):
+    _make_channelizer_bench(_M)
+
+
+# flex_fir_bank_ff vs K flex_fir_ff sobre la misma entrada
+def _make_flex_bank_bench(K):
+    name = 'flex_fir_bank_ff/K%d' % K
+
+    def fn(nitems):
+        fs = 1e6
+        # K pasabandas contiguos, mismo ancho de transicion (mismo largo de taps)
+        bw = 0.5 * fs / K
+        f1 = [max((b + 0.2) * bw, 1e3) for b in range(K)]
+        f2 = [(b + 0.8) * bw for b in range(K)]
+        width = [0.1 * bw] * K
+        for label in ('flex_fir_ff_x%d' % K, 'bank'):
+            tb = gr.top_block()
+            hd = blocks.head(gr.sizeof_float, nitems)
+            tb.connect(float_source(), hd)
+            if label == 'bank':
+                bank = howto.flex_fir_bank_ff(fs, [2] * K, f1, f2, width, [1.0] * K)
+                tb.connect(hd, bank)
+                outs = [(bank, b) for b in range(K)]
+                extra = 'taps=%d' % bank.ntaps()
+            else:
+                outs = [howto.flex_fir_ff(2, fs, f1[b], f2[b], width[b], 1.0) for b in range(K)]
+                for o in outs:
+                    tb.connect(hd, o)
+                extra = ''
+            for o in outs:
+                tb.connect(o, blocks.null_sink(gr.sizeof_float))
+            report('%s/%s' % (name, label), nitems, run_tb(tb), extra)
+    BENCHES[name] = fn
+
+for _K in (4, 8, 16):
+    _make_flex_bank_bench(_K)
+
+
+# flex_fir_cc -> decimate_fir_cc -> iq_mag_cf -> detector_ff: bloques sueltos vs
+# fir_pipeline_cf (una etapa por core, anillos SPSC) -> detector_ff
+def _make_pipeline_bench(D):
+    name = 'fir_pipeline_cf/D%d' % D
+
+    def fn(nitems):
+        fs = 1e6
+        fir = (0, fs, 0.3 * fs, 0.0, 0.01 * fs, 1.0)         # ~400 taps
+        dec = (D, fs, 0.4 * fs / D, 0.1 * fs / D)
+        for label in ('blocks', 'pipeline'):
+            tb = gr.top_block()
+            hd = blocks.head(gr.sizeof_gr_complex, nitems)
+            det = howto.detector_ff(1.5, 1.0, 64)
+            if label == 'blocks':
+                chain = [howto.flex_fir_cc(*fir),
+                         howto.decimate_fir_cc(*(dec + (0, 6.76, True))),
+                         howto.iq_mag_cf(1.0)]
+            else:
+                pipe = howto.fir_pipeline_cf(*(fir + dec[:1] + dec[2:] + (1.0, [1, 2, 3])))
+                det.set_processor_affinity([0])
+                chain = [pipe]
+            tb.connect(complex_source(), hd, *chain)
+            tb.connect(chain[-1], det, blocks.null_sink(gr.sizeof_float))
+            dt = run_tb(tb)
+            extra = ''
+            if label == 'pipeline':
+                extra = 'util=[%s] %s' % (', '.join('%.2f' % u for u in pipe.stage_utilization()),
+                                          pipe.describe())
+            report('%s/%s' % (name, label), nitems, dt, extra)
+    BENCHES[name] = fn
+
+for _D in (4, 16):
+    _make_pipeline_bench(_D)
+
+
+# downsample_cc en modo conmutador (D salidas, una pasada) vs D downsample_cc
+# detras de skiphead(k)
+def _make_commutator_bench(D):
+    name = 'downsample_cc/commutator_D%d' % D
+
+    def fn(nitems):
+        for label in ('skiphead_x%d' % D, 'commutator'):
+            tb = gr.top_block()
+            hd = blocks.head(gr.sizeof_gr_complex, nitems)
+            tb.connect(complex_source(), hd)
+            if label == 'commutator':
+                ds = howto.downsample_cc(D, 0, True)
+                tb.connect(hd, ds)
+                outs = [(ds, k) for k in range(D)]
+            else:
+                outs = []
+                for k in range(D):
+                    outs.append(howto.downsample_cc(D))
+                    tb.connect(hd, blocks.skiphead(gr.sizeof_gr_complex, k), outs[k])
+            for o in outs:
+                tb.connect(o, blocks.null_sink(gr.sizeof_gr_complex))
+            report('%s/%s' % (name, label), nitems, run_tb(tb))
+    BENCHES[name] = fn
+
+for _D in (4, 16):
+    _make_commutator_bench(_D)
+
+
+# N iq_select_cf sobre la misma entrada vs un iq_select_multi_cf con N salidas
+def _make_iq_multi_bench(label, modes):
+    name = 'iq_select_multi_cf/%s' % label
+
+    def fn(nitems):
+        for impl in ('iq_select_cf_x%d' % len(modes), 'multi'):
+            tb = gr.top_block()
+            hd = blocks.head(gr.sizeof_gr_complex, nitems)
+            tb.connect(complex_source(), hd)
+            if impl == 'multi':
+                blk = howto.iq_select_multi_cf(1.0, modes)
+                tb.connect(hd, blk)
+                outs = [(blk, k) for k in range(len(modes))]
+            else:
+                outs = [howto.iq_select_cf(1.0, m) for m in modes]
+                for o in outs:
+                    tb.connect(hd, o)
+            for o in outs:
+                tb.connect(o, blocks.null_sink(gr.sizeof_float))
+            report('%s/%s' % (name, impl), nitems, run_tb(tb))
+    BENCHES[name] = fn
+
+_make_iq_multi_bench('mag_pow_re_im', [0, 1, 3, 4])
+_make_iq_multi_bench('mag_pow_phase_re', [0, 1, 2, 3])
+
+
+def main():
+    ap = argparse.ArgumentParser(description='gr-howto micro-benchmarks')
+    ap.add_argument('names', nargs='*', help='prefijos de casos a correr')
+    ap.add_argument('-n', '--nitems', type=int, default=10 * 1000 * 1000)
+    ap.add_argument('-l', '--list', action='store_true', help='lista los casos')
+    args = ap.parse_args()
+
+    if args.list:
+        for name in BENCHES:
+            print(name)
+        return
+
+    for name, fn in BENCHES.items():
+        if args.names and not any(name.startswith(p) for p in args.names):
+            continue
+        fn(args.nitems)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,192 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+"""
+Genera un bloque FIR de taps fijos (fixed_fir) a partir de un archivo de taps.
+
+Los taps quedan compilados en el bloque: el lazo de taps se desenrolla
+entero y cada tap es una constante (ver lib/fixed_fir.h). Sirve para los
+filtros de produccion que nunca cambian (p.ej. anti-alias antes de
+downsample_cc); para taps que cambian en runtime usar flex_fir_* o
+decimate_fir_cc.
+
+Archivo de taps: numeros separados por espacios, comas o saltos de linea;
+'#' comenta hasta fin de linea. Las lineas de comentario del principio se
+copian a la documentacion del bloque.
+
+Uso (desde la raiz del modulo):
+    apps/howto_fixed_fir_gen.py lib/fixed_taps/aa_decim4.taps fixed_aa_decim4_cc \\
+        --type cc --decim 4
+
+Escribe include/howto/<name>.h, lib/<name>_impl.cc y grc/howto_<name>.xml e
+imprime las lineas a agregar en los CMakeLists.txt y en swig/howto_swig.i.
+"""
+from __future__ import print_function
+import argparse
+import os
+import re
+import sys
+
+MAX_TAPS = 256   # mas alla el desenrollado completo deja de convenir
+
+TYPES = {
+    # type: (C++ sample type, grc type, descripcion)
+    'ff': ('float', 'float', 'float -> float'),
+    'cc': ('gr_complex', 'complex', 'complex -> complex, real taps'),
+}
+
+
+def read_taps(path):
+    doc, taps, header = [], [], True
+    with open(path) as f:
+        for line in f:
+            body, _, comment = line.partition('#')
+            if header and not body.strip():
+                if comment.strip():
+                    doc.append(comment.strip())
+                continue
+            header = False
+            taps += [float(t) for t in re.split(r'[\s,]+', body.strip()) if t]
+    return taps, doc
+
+
+def is_symmetric(taps):
+    amax = max(abs(t) for t in taps)
+    n = len(taps)
+    return n >= 2 and all(abs(taps[k] - taps[n - 1 - k]) <= 1e-6 * amax for k in range(n // 2))
+
+
+HEADER = '''/* -*- c++ -*- */
+/* Generado por apps/howto_fixed_fir_gen.py desde {src}; no editar. */
+#ifndef {guard}
+#define {guard}
+
+#include <howto/api.h>
+#include <gnuradio/sync_decimator.h>
+#include <vector>
+
+namespace gr {{ namespace howto {{
+
+/*!
+ * \\brief Fixed {N}-tap FIR ({desc}), decimation {D}.
+ * \\details Taps compiled in (fixed_fir: fully unrolled, taps as constants).
+{doc} */
+class HOWTO_API {name} : virtual public gr::sync_decimator
+{{
+public:
+  typedef boost::shared_ptr<{name}> sptr;
+
+  static sptr make();
+
+  virtual ~{name}() {{}}
+
+  virtual std::vector<float> taps() const = 0;
+}};
+
+}}}} // namespace
+#endif
+'''
+
+IMPL = '''/* -*- c++ -*- */
+/* Generado por apps/howto_fixed_fir_gen.py desde {src}; no editar. */
+#include <howto/{name}.h>
+#include "fixed_fir_impl.h"
+
+namespace gr {{ namespace howto {{
+
+namespace {{
+
+struct {name}_taps
+{{
+  static constexpr int   N = {N};
+  static constexpr bool  symmetric = {sym};
+  static constexpr float h[N] = {{
+{taps}
+  }};
+}};
+
+constexpr float {name}_taps::h[];
+
+}} // namespace
+
+{name}::sptr {name}::make()
+{{
+  return gnuradio::get_initial_sptr(
+      new fixed_fir_impl<{name}, {name}_taps, {T}, {D}>("{name}"));
+}}
+
+}}}} // namespace
+'''
+
+GRC = '''<?xml version="1.0"?>
+<block>
+  <name>{name}</name>
+  <key>howto_{name}</key>
+  <category>[HOWTO]</category>
+  <import>import howto</import>
+  <make>howto.{name}()</make>
+
+  <sink>
+    <name>in</name>
+    <type>{grc}</type>
+  </sink>
+
+  <source>
+    <name>out</name>
+    <type>{grc}</type>
+  </source>
+
+  <doc>
+    FIR de {N} taps fijos ({desc}), decimacion {D}. Generado desde {src}.
+{grcdoc}
+  </doc>
+</block>
+'''
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Genera un bloque FIR de taps fijos')
+    ap.add_argument('taps', help='archivo de taps')
+    ap.add_argument('name', help='nombre del bloque (p.ej. fixed_aa_decim4_cc)')
+    ap.add_argument('--type', choices=sorted(TYPES), default='cc')
+    ap.add_argument('--decim', type=int, default=1)
+    ap.add_argument('--root', default='.', help='raiz del modulo (default: .)')
+    args = ap.parse_args()
+
+    if not re.match(r'^[a-z_][a-z0-9_]*$', args.name):
+        sys.exit('nombre invalido: %s' % args.name)
+    if args.decim < 1:
+        sys.exit('--decim debe ser >= 1')
+    taps, doc = read_taps(args.taps)
+    if not 1 <= len(taps) <= MAX_TAPS:
+        sys.exit('se esperan 1..%d taps, hay %d' % (MAX_TAPS, len(taps)))
+
+    T, grc, desc = TYPES[args.type]
+    src = os.path.relpath(args.taps, args.root).replace(os.sep, '/')
+    fields = dict(
+        name=args.name, N=len(taps), D=args.decim, T=T, grc=grc, desc=desc, src=src,
+        guard='INCLUDED_HOWTO_%s_H' % args.name.upper(),
+        sym='true' if is_symmetric(taps) else 'false',
+        doc=''.join(' *          %s\n' % d for d in doc),
+        grcdoc='\n'.join('    %s' % d for d in doc),
+        taps=',\n'.join('    ' + ', '.join('%.9ef' % t for t in taps[i:i + 4])
+                        for i in range(0, len(taps), 4)))
+
+    out = [('include/howto/%s.h' % args.name, HEADER),
+           ('lib/%s_impl.cc' % args.name, IMPL),
+           ('grc/howto_%s.xml' % args.name, GRC)]
+    for rel, tmpl in out:
+        with open(os.path.join(args.root, rel), 'w') as f:
+            f.write(tmpl.format(**fields))
+        print('escrito', rel)
+
+    print('\nAgregar:')
+    print('  include/howto/CMakeLists.txt:  %s.h' % args.name)
+    print('  lib/CMakeLists.txt (howto_sources):  %s_impl.cc' % args.name)
+    print('  grc/CMakeLists.txt:  howto_%s.xml' % args.name)
+    print('  swig/howto_swig.i:  #include "howto/%s.h"' % args.name)
+    print('                      %%include "howto/%s.h"' % args.name)
+    print('                      GR_SWIG_BLOCK_MAGIC2(howto, %s);' % args.name)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,69 @@
+#ifndef INCLUDED_HOWTO_CIC_DECIM_FF_H
+#define INCLUDED_HOWTO_CIC_DECIM_FF_H
+
+#include <howto/api.h>
+#include <gnuradio/block.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * \brief Multiplier-free CIC decimator (float) with optional compensation FIR.
+ * \details N integrators / decimate by R / N combs in wrapping 64-bit integer
+ *          arithmetic, unity DC gain; inputs up to +/-256 full scale
+ *          (larger ones saturate rather than wrap). With compensate, a FIR
+ *          at the CIC output rate (decimate_fir_cc engine: folded taps, own
+ *          delay line) flattens the sinc^N droop up to
+ *          cutoff and low-passes with the given transition, decimating by a
+ *          further comp_decim. Total decimation is R * comp_decim.
+ *          Setters apply lazily (next work() re-designs and realigns), as in
+ *          decimate_fir_cc::set_decimation.
+ */
+class HOWTO_API cic_decim_ff : virtual public gr::block
+{
+public:
+  typedef boost::shared_ptr<cic_decim_ff> sptr;
+
+  /*!
+   * \param decim       CIC decimation R (>= 2)
+   * \param order       CIC order N (1..6)
+   * \param samp_rate   input sample rate [Hz]
+   * \param compensate  run the compensation FIR after the CIC
+   * \param comp_decim  compensator decimation (>= 1)
+   * \param cutoff      compensator cutoff [Hz]
+   * \param transition  compensator transition width [Hz]; cutoff +
+   *        transition/2 must not exceed samp_rate / (2 * decim * comp_decim)
+   * \param window      firdes window id for the compensator
+   * \param kaiser_beta Kaiser beta (only used if window == WIN_KAISER)
+   */
+  static sptr make(int decim, int order, double samp_rate,
+                   bool compensate = false, int comp_decim = 1,
+                   double cutoff = 0.0, double transition = 0.0,
+                   int window = 0, double kaiser_beta = 6.76);
+
+  virtual int    decimation() const noexcept = 0;
+  virtual int    order() const noexcept = 0;
+  virtual double samp_rate() const noexcept = 0;
+  virtual bool   compensate() const noexcept = 0;
+  virtual int    comp_decimation() const noexcept = 0;
+  virtual double cutoff() const noexcept = 0;
+  virtual double transition() const noexcept = 0;
+
+  //! Both throw (ValueError) if N log2(R) leaves too little integrator
+  //! precision, as make() does; change R and N in the order that keeps
+  //! every intermediate pair valid
+  virtual void set_decimation(int decim) = 0;
+  virtual void set_order(int order) = 0;
+  virtual void set_samp_rate(double fs) = 0;
+  virtual void set_compensate(bool on) = 0;
+  virtual void set_comp_decimation(int d) = 0;
+  virtual void set_cutoff(double fc) = 0;
+  virtual void set_transition(double tw) = 0;
+
+  //! Compensator taps in use (empty without compensation)
+  virtual std::vector<float> comp_taps() const = 0;
+};
+
+}} // namespace gr::howto
+#endif
@@ -4,13 +4,36 @@
 #include <howto/api.h>
 #include <gnuradio/block.h>
 #include <boost/shared_ptr.hpp>
+#include <string>
 
 namespace gr { namespace howto {
 
 /*!
  * \brief Complex FIR decimator with runtime-changeable decimation and taps.
  * \details Anti-alias low-pass via firdes. Window selectable (incl. Kaiser).
- *          Uses set_history(L) and general_block to support D changes at runtime.
+ *          A general_block with history(1): every stage keeps its own delay
+ *          line and the block keeps the last inputs it consumed, so D and
+ *          the taps change at runtime without touching the scheduler.
+ *
+ *          Setters return at once; a designer thread builds the new plan and
+ *          work() swaps it in between two outputs, after running the last
+ *          inputs through it. Output continues on the next input sample as
+ *          if the new filter had always been there: no stall, no dropped or
+ *          repeated samples, no zero transient. A runtime design that fails
+ *          (e.g. firdes rejects the cutoff) is logged and the plan in use
+ *          stays; make() still throws on a bad initial design.
+ *
+ *          With multistage a planner factors D into
+ *          CIC -> half-band x h -> FIR stages and runs the plan with the fewest
+ *          MACs per output inside this block; e.g. D = 2^n with cutoff =
+ *          samp_rate/(2D) becomes n half-band stages. Only the last stage needs
+ *          the requested transition, so large D no longer means very long taps.
+ *          plan() and macs_per_output() report the design in use (a setter
+ *          shows there once work() has applied it). A CIC stage integrates
+ *          in 64-bit integers with headroom for |I|, |Q| <= 65536 (full
+ *          scale sc16 fits) and saturates beyond that; plans without a CIC,
+ *          and multistage = false (the default, a single FIR as before),
+ *          take any float input.
  */
 class HOWTO_API decimate_fir_cc : virtual public gr::block
 {
@@ -24,13 +47,15 @@ public:
    * \param transition  Transition width [Hz]
    * \param window      firdes window id (e.g., firdes::WIN_HAMMING)
    * \param kaizer_beta Kaiser beta (only used if window == WIN_KAISER)
+   * \param multistage  allow multi-stage plans (default false: single FIR)
    */
   static sptr make(int decim,
                    double samp_rate,
                    double cutoff,
                    double transition,
                    int window,
-                   double kaiser_beta);
+                   double kaiser_beta,
+                   bool multistage = false);
 
   // Read-only query helpers
   virtual int    decimation()  const noexcept = 0;
@@ -40,6 +65,15 @@ public:
   virtual int    window()      const noexcept = 0;
   virtual double kaiser_beta() const noexcept = 0;
 
+  //! Number of half-band stages in the current plan
+  virtual int    halfband_stages() const noexcept = 0;
+  virtual bool   multistage()  const noexcept = 0;
+
+  //! Current plan and its cost, e.g. "HB(11 taps) -> FIR(D=4, 97 taps): 61.0 MAC + 0 add / out"
+  virtual std::string plan() const = 0;
+  //! Predicted multiplies per output sample of the current plan
+  virtual double macs_per_output() const noexcept = 0;
+
   // Runtime setters (thread-safe)
   virtual void set_decimation(int decim) = 0;
   virtual void set_samp_rate(double fs) = 0;
@@ -47,6 +81,13 @@ public:
   virtual void set_transition(double tw) = 0;
   virtual void set_window(int w) = 0;
   virtual void set_kaiser_beta(double beta) = 0;
+  virtual void set_multistage(bool on) = 0;
+
+  //! Accumulation of the FIR dot products, as in flex_fir_ff:
+  //! 0 = float (default), 1 = split, 2 = double. Half-band and CIC stages
+  //! of a multi-stage plan are short and keep float.
+  virtual void set_accumulation(int acc) = 0;
+  virtual int  accumulation() const noexcept = 0;
 };
 
 }} // namespace gr::howto
@@ -31,8 +31,12 @@ namespace gr {
     /*!
     * \brief Exponential energy detector with hysteresis.
     * Streams: out (passthrough), env (exponential envelope).
+    * Envelope: env[n] = a*env[n-1] + (1-a)*x[n]^2 with a = exp(-1/length), i.e.
+    * a time constant of 'length' samples. With decay_length > 0 the envelope is
+    * dual-rate: 'length' applies while rising (attack), 'decay_length' while falling.
     * Message: state_msg (START/STOP events).
     * Tags on 'out': "state" and "env" at event sample offsets.
+    * Input tags are propagated by the runtime (all-to-all) to both streams.
     */
     class HOWTO_API detector_exp_ff : virtual public gr::sync_block
     {
@@ -40,14 +44,21 @@ namespace gr {
       typedef boost::shared_ptr<detector_exp_ff> sptr;
 
       /*!
-      * \param length moving window size kept for priming/compatibility
+      * \param length       envelope time constant in samples (attack when dual-rate)
+      * \param decay_length decay time constant in samples; 0 = single-rate (same as length)
       */
-      static sptr make(int length);
+      static sptr make(int length, int decay_length = 0);
 
       // Runtime controls
       virtual void set_length(int n) noexcept = 0;
+      virtual void set_decay_length(int n) noexcept = 0;
       virtual void set_Ton(float t) noexcept = 0;
       virtual void set_Toff(float t) noexcept = 0;
+
+      // Queries
+      virtual int   length() const noexcept = 0;
+      virtual int   decay_length() const noexcept = 0;
+      virtual float alpha() const noexcept = 0;        //!< attack/single-rate smoothing factor
     };
 
   } // namespace howto
@@ -9,7 +9,18 @@ namespace gr { namespace howto {
 
 /*!
  * \brief Complex-to-complex decimator that simply picks 1 of every D samples.
- * \details No filtering, no phase control. Expect aliasing.
+ * \details No filtering. Expect aliasing.
+ *
+ *          out[n] = in[n*D + phase]; set_phase() moves the pick at the next
+ *          work() call (the step between two outputs then differs by the
+ *          phase change once).
+ *
+ *          With commutator = true the block has D outputs and deinterleaves
+ *          instead: out_k[n] = in[n*D + (phase + k) mod D], all D streams
+ *          written in one SSE pass over the input (2x2 complex transposes),
+ *          e.g. to feed the branches of a polyphase filter. With phase 0 this
+ *          is D downsample_cc blocks behind skiphead(k), reading the input
+ *          once instead of D times.
  */
 class HOWTO_API downsample_cc : virtual public gr::sync_decimator
 {
@@ -17,15 +28,20 @@ public:
   typedef boost::shared_ptr<downsample_cc> sptr;
 
   /*!
-   * \param decim Decimation factor (D >= 2)
+   * \param decim      Decimation factor (D >= 2)
+   * \param phase      Sample of each group of D to keep (0..D-1)
+   * \param commutator D outputs, one per phase
    */
-  static sptr make(int decim);
+  static sptr make(int decim, int phase = 0, bool commutator = false);
 
   // Convenience accessor
   virtual int decimation() const = 0;
+
+  virtual int  phase() const = 0;
+  virtual void set_phase(int phase) = 0;   //!< throws outside 0..D-1
+  virtual bool commutator() const = 0;
 };
 
 }} // namespace gr::howto
 
 #endif /* INCLUDED_HOWTO_DOWNSAMPLE_CC_H */
-
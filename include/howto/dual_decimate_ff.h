@@ -13,6 +13,8 @@ namespace howto {
  * \brief Dual decimator with two inputs and two outputs.
  * Each output i emits the average over non-overlapping windows of Di from input i.
  * Runtime setters mark a realign flag used by general_work().
+ * Both ports share one scheduler call, so they advance in lockstep; use
+ * dual_decimate_lanes_ff when each port must run at its own rate.
  */
 class HOWTO_API dual_decimate_ff : virtual public gr::block
 {
@@ -0,0 +1,37 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_DUAL_DECIMATE_LANES_FF_H
+#define INCLUDED_HOWTO_DUAL_DECIMATE_LANES_FF_H
+
+#include <howto/api.h>
+#include <gnuradio/hier_block2.h>
+#include <boost/shared_ptr.hpp>
+
+namespace gr {
+namespace howto {
+
+/*!
+ * \brief Dual block-mean decimator with independently scheduled lanes.
+ * Same math as dual_decimate_ff (output i = mean over windows of Di from
+ * input i), but each port runs in its own block/thread, so a starved input
+ * or a full output on one port never throttles the other. Output lengths
+ * are n0/D0 and n1/D1 instead of the lockstep min(...) of dual_decimate_ff.
+ */
+class HOWTO_API dual_decimate_lanes_ff : virtual public gr::hier_block2
+{
+public:
+  typedef boost::shared_ptr<dual_decimate_lanes_ff> sptr;
+  static sptr make(int D0, int D1);
+
+  virtual ~dual_decimate_lanes_ff() noexcept {}
+
+  virtual void set_D0(int D0) noexcept = 0;
+  virtual void set_D1(int D1) noexcept = 0;
+
+  virtual int D0() const noexcept = 0;
+  virtual int D1() const noexcept = 0;
+};
+
+} // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_DUAL_DECIMATE_LANES_FF_H */
@@ -0,0 +1,70 @@
+#ifndef INCLUDED_HOWTO_FIR_PIPELINE_CF_H
+#define INCLUDED_HOWTO_FIR_PIPELINE_CF_H
+
+#include <howto/api.h>
+#include <gnuradio/block.h>
+#include <string>
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * \brief flex_fir_cc -> decimate_fir_cc -> iq_mag_cf as one block, one
+ *        pinned thread per stage.
+ * \details out = scale * |decim(fir(x))|, with the same designs as those
+ *          blocks (decimation stage skipped when decim == 1). Each stage
+ *          runs on its own thread (stage k bound to cores[k % size] if
+ *          given) and the stages hand samples to each other through
+ *          lock-free single-producer/single-consumer rings, chunks of at
+ *          most 1024 input samples, without going through the scheduler.
+ *          The block thread only copies samples into the first ring and
+ *          out of the last one.
+ *
+ *          Put detector_ff right after it (tags and messages need the
+ *          scheduler); set_processor_affinity() pins that one.
+ *
+ *          Settings are fixed at construction. Samples consumed are always
+ *          returned: calls hand back whatever has come through while more
+ *          input is queued, and a call that takes the last queued input
+ *          waits until either new input arrives or the chain is empty, so
+ *          nothing is left inside at the end of a stream. With a slow
+ *          source that means the block thread waits on the chain between
+ *          its bursts (the stages themselves keep running).
+ */
+class HOWTO_API fir_pipeline_cf : virtual public gr::block
+{
+public:
+  typedef boost::shared_ptr<fir_pipeline_cf> sptr;
+
+  /*!
+   * \param mode, samp_rate, f1, f2, width, gain   FIR stage, as flex_fir_cc
+   * \param decim, cutoff, transition              decimation stage, as
+   *        decimate_fir_cc (Hamming, multi-stage plan); decim >= 1
+   * \param scale       magnitude stage, as iq_mag_cf
+   * \param cores       one core per stage (empty: not pinned)
+   * \param ring_kbytes size of each ring; 0 = a quarter of the L2
+   */
+  static sptr make(int mode, float samp_rate,
+                   float f1, float f2, float width, float gain,
+                   int decim, double cutoff, double transition,
+                   float scale,
+                   const std::vector<int>& cores = std::vector<int>(),
+                   int ring_kbytes = 0);
+
+  virtual ~fir_pipeline_cf() {}
+
+  virtual int decimation() const = 0;
+  virtual int stages() const = 0;
+  //! e.g. "FIR(D=1, 129 taps) | HB(11 taps) -> FIR(D=4, 97 taps) | |x|*1"
+  virtual std::string describe() const = 0;
+  //! Items per ring, input ring first
+  virtual std::vector<int> ring_items() const = 0;
+
+  //! Fraction of wall time each stage thread spent processing since
+  //! start or the last reset_utilization(); the largest is the bottleneck
+  virtual std::vector<float> stage_utilization() const = 0;
+  virtual void reset_utilization() = 0;
+};
+
+}} // namespace
+#endif
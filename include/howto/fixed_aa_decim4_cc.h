@@ -0,0 +1,31 @@
+/* -*- c++ -*- */
+/* Generado por apps/howto_fixed_fir_gen.py desde lib/fixed_taps/aa_decim4.taps; no editar. */
+#ifndef INCLUDED_HOWTO_FIXED_AA_DECIM4_CC_H
+#define INCLUDED_HOWTO_FIXED_AA_DECIM4_CC_H
+
+#include <howto/api.h>
+#include <gnuradio/sync_decimator.h>
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * \brief Fixed 63-tap FIR (complex -> complex, real taps), decimation 4.
+ * \details Taps compiled in (fixed_fir: fully unrolled, taps as constants).
+ *          Anti-alias low-pass for 4:1 decimation: 63 taps, cutoff 0.1 fs
+ *          (0.4 of the output rate; windowed sinc, Kaiser beta 6.76), unity DC gain.
+ */
+class HOWTO_API fixed_aa_decim4_cc : virtual public gr::sync_decimator
+{
+public:
+  typedef boost::shared_ptr<fixed_aa_decim4_cc> sptr;
+
+  static sptr make();
+
+  virtual ~fixed_aa_decim4_cc() {}
+
+  virtual std::vector<float> taps() const = 0;
+};
+
+}} // namespace
+#endif
@@ -0,0 +1,31 @@
+/* -*- c++ -*- */
+/* Generado por apps/howto_fixed_fir_gen.py desde lib/fixed_taps/lp31.taps; no editar. */
+#ifndef INCLUDED_HOWTO_FIXED_LP31_CC_H
+#define INCLUDED_HOWTO_FIXED_LP31_CC_H
+
+#include <howto/api.h>
+#include <gnuradio/sync_decimator.h>
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * \brief Fixed 31-tap FIR (complex -> complex, real taps), decimation 1.
+ * \details Taps compiled in (fixed_fir: fully unrolled, taps as constants).
+ *          31-tap low-pass, cutoff 0.125 fs (windowed sinc, Kaiser beta 6.76), unity DC gain.
+ *          Tap-count sweep for the fixed_fir benchmark (apps/howto_bench.py).
+ */
+class HOWTO_API fixed_lp31_cc : virtual public gr::sync_decimator
+{
+public:
+  typedef boost::shared_ptr<fixed_lp31_cc> sptr;
+
+  static sptr make();
+
+  virtual ~fixed_lp31_cc() {}
+
+  virtual std::vector<float> taps() const = 0;
+};
+
+}} // namespace
+#endif
@@ -0,0 +1,51 @@
+#ifndef INCLUDED_HOWTO_FLEX_FIR_BANK_FF_H
+#define INCLUDED_HOWTO_FLEX_FIR_BANK_FF_H
+
+#include <howto/api.h>
+#include <gnuradio/sync_block.h>
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * \brief K flex_fir_ff bands on one input: one delay line, K outputs.
+ * \details Band b is designed exactly like flex_fir_ff(modes[b], samp_rate,
+ *          f1[b], f2[b], width[b], gain[b]) and output b matches that block
+ *          sample for sample. The tap sets are zero-padded to the longest
+ *          one and stored interleaved (tap k of every band side by side),
+ *          so each input sample is loaded once and broadcast to all bands
+ *          with SIMD. Trailing outputs may be left unconnected.
+ *          Cost per sample is (longest band) x K rounded up to 4, so keep
+ *          the widths similar for best results.
+ */
+class HOWTO_API flex_fir_bank_ff : virtual public gr::sync_block
+{
+public:
+  typedef boost::shared_ptr<flex_fir_bank_ff> sptr;
+
+  //! All vectors hold one entry per band (1..64 bands)
+  static sptr make(float samp_rate,
+                   const std::vector<int>& modes,
+                   const std::vector<float>& f1,
+                   const std::vector<float>& f2,
+                   const std::vector<float>& width,
+                   const std::vector<float>& gain);
+
+  virtual ~flex_fir_bank_ff() {}
+
+  virtual int   nbands() const noexcept = 0;
+
+  virtual void  set_samp_rate(float fs) noexcept = 0;
+  virtual float samp_rate() const noexcept = 0;
+
+  //! Re-designs one band (applied at the next work()); throws on a bad index
+  virtual void  set_band(int band, int mode, float f1, float f2, float width, float gain) = 0;
+
+  //! Taps of one band as designed (before padding)
+  virtual std::vector<float> taps(int band) const = 0;
+  //! Common (padded) length
+  virtual int   ntaps() const noexcept = 0;
+};
+
+}} // namespace
+#endif
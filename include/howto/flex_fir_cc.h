@@ -14,7 +14,8 @@ public:
   typedef boost::shared_ptr<flex_fir_cc> sptr;
 
   static sptr make(int mode, float samp_rate,
-                   float f1, float f2, float width, float gain);
+                   float f1, float f2, float width, float gain,
+                   float atten_db = 0.0f, float ripple_db = 0.0f);
 
   virtual ~flex_fir_cc() {}
 
@@ -37,6 +38,28 @@ public:
   virtual float gain() const noexcept = 0;
 
   virtual std::vector<float> taps() const = 0;
+
+  //! Spec-driven design (dB), as in flex_fir_ff
+  virtual void  set_attenuation(float db) noexcept = 0;
+  virtual float attenuation() const noexcept = 0;
+
+  virtual void  set_ripple(float db) noexcept = 0;
+  virtual float ripple() const noexcept = 0;
+
+  virtual int   ntaps() const noexcept = 0;
+  //! Real MACs per output sample
+  virtual int   macs_per_sample() const noexcept = 0;
+
+  //! Opt-in data parallelism for long filters: each work() call's outputs
+  //! are split between the block thread and nthreads-1 persistent workers
+  //! (worker k bound to cores[k % size] if given). 1 = off (default).
+  //! Calls with less than ~256k MACs stay on the block thread.
+  virtual void  set_threads(int nthreads, const std::vector<int>& cores = std::vector<int>()) = 0;
+  virtual int   threads() const noexcept = 0;
+
+  //! 0 = float, 1 = split, 2 = double accumulation, as in flex_fir_ff
+  virtual void  set_accumulation(int acc) = 0;
+  virtual int   accumulation() const noexcept = 0;
 };
 
 }} // namespace
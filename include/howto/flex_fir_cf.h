@@ -8,13 +8,24 @@
 
 namespace gr { namespace howto {
 
+/*!
+ * \brief Flexible FIR, complex in, one real-valued part of the output out.
+ * \details output selects what is emitted: 0 = Re{y}, 1 = Im{y}, 2 = |y|.
+ *          The taps are real, so Re/Im only filter that input lane (half
+ *          the MACs of the complex filter); |y| runs the full complex
+ *          filter. Fixed at construction: each choice is its own kernel.
+ */
 class HOWTO_API flex_fir_cf : virtual public gr::sync_block
 {
 public:
   typedef boost::shared_ptr<flex_fir_cf> sptr;
 
+  enum output_t { OUT_REAL = 0, OUT_IMAG = 1, OUT_MAG = 2 };
+
   static sptr make(int mode, float samp_rate,
-                   float f1, float f2, float width, float gain);
+                   float f1, float f2, float width, float gain,
+                   int output = OUT_REAL,
+                   float atten_db = 0.0f, float ripple_db = 0.0f);
 
   virtual ~flex_fir_cf() {}
 
@@ -37,6 +48,28 @@ public:
   virtual float gain() const noexcept = 0;
 
   virtual std::vector<float> taps() const = 0;
+
+  //! Spec-driven design (dB), as in flex_fir_ff
+  virtual void  set_attenuation(float db) noexcept = 0;
+  virtual float attenuation() const noexcept = 0;
+
+  virtual void  set_ripple(float db) noexcept = 0;
+  virtual float ripple() const noexcept = 0;
+
+  virtual int   ntaps() const noexcept = 0;
+  //! Real MACs per output sample
+  virtual int   macs_per_sample() const noexcept = 0;
+
+  //! Opt-in data parallelism, as in flex_fir_cc
+  virtual void  set_threads(int nthreads, const std::vector<int>& cores = std::vector<int>()) = 0;
+  virtual int   threads() const noexcept = 0;
+
+  //! 0 = float, 1 = split, 2 = double accumulation, as in flex_fir_ff
+  virtual void  set_accumulation(int acc) = 0;
+  virtual int   accumulation() const noexcept = 0;
+
+  //! Part of y emitted (output_t)
+  virtual int   output() const noexcept = 0;
 };
 
 }} // namespace
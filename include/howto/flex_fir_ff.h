@@ -13,7 +13,8 @@ public:
   typedef boost::shared_ptr<flex_fir_ff> sptr;
 
   static sptr make(int mode, float samp_rate,
-                   float f1, float f2, float width, float gain);
+                   float f1, float f2, float width, float gain,
+                   float atten_db = 0.0f, float ripple_db = 0.0f);
 
   virtual ~flex_fir_ff() {}
 
@@ -36,6 +37,31 @@ public:
   virtual float gain() const noexcept = 0;
 
   virtual std::vector<float> taps() const = 0;
+
+  //! Spec-driven design (dB): stopband attenuation and peak passband ripple.
+  //! Either > 0 selects a Kaiser window with the shortest length that meets
+  //! it; both <= 0 keep the Hamming N ~ 4*fs/width rule.
+  virtual void  set_attenuation(float db) noexcept = 0;
+  virtual float attenuation() const noexcept = 0;
+
+  virtual void  set_ripple(float db) noexcept = 0;
+  virtual float ripple() const noexcept = 0;
+
+  //! Tap count for the current parameters
+  virtual int   ntaps() const noexcept = 0;
+  //! Real multiply-accumulates per output sample (after symmetric folding)
+  virtual int   macs_per_sample() const noexcept = 0;
+
+  //! Opt-in data parallelism, as in flex_fir_cc
+  virtual void  set_threads(int nthreads, const std::vector<int>& cores = std::vector<int>()) = 0;
+  virtual int   threads() const noexcept = 0;
+
+  //! Accumulation of the long dot products: 0 = float (default, fastest),
+  //! 1 = split (16 partial sums, same speed, ~2x less rounding error on
+  //! long filters), 2 = double (error independent of the length, ~2.5x
+  //! slower). Throws std::invalid_argument for anything else.
+  virtual void  set_accumulation(int acc) = 0;
+  virtual int   accumulation() const noexcept = 0;
 };
 
 }} // namespace
@@ -0,0 +1,75 @@
+#ifndef INCLUDED_HOWTO_FLEX_FIR_SC16C_H
+#define INCLUDED_HOWTO_FLEX_FIR_SC16C_H
+
+#include <howto/api.h>
+#include <gnuradio/sync_block.h>
+#include <vector>
+#include <complex>
+
+namespace gr { namespace howto {
+
+/*!
+ * Flexible FIR for interleaved int16 IQ (sc16 -> complex). Same tap design
+ * and callbacks as flex_fir_cc; input is taken as full scale (x / 32768).
+ *
+ * fixed_point = false: samples are widened to float and filtered with the
+ * float taps. fixed_point = true: taps are quantized to int16 with the
+ * largest shift that cannot overflow the int32 accumulator and the MAC runs
+ * on integers (SSE2 pmaddwd); taps_shift() reports the Q format used.
+ */
+class HOWTO_API flex_fir_sc16c : virtual public gr::sync_block
+{
+public:
+  typedef boost::shared_ptr<flex_fir_sc16c> sptr;
+
+  static sptr make(int mode, float samp_rate,
+                   float f1, float f2, float width, float gain,
+                   bool fixed_point = false,
+                   float atten_db = 0.0f, float ripple_db = 0.0f);
+
+  virtual ~flex_fir_sc16c() {}
+
+  virtual void  set_mode(int mode) noexcept = 0;
+  virtual int   mode() const noexcept = 0;
+
+  virtual void  set_samp_rate(float fs) noexcept = 0;
+  virtual float samp_rate() const noexcept = 0;
+
+  virtual void  set_f1(float f) noexcept = 0;
+  virtual float f1() const noexcept = 0;
+
+  virtual void  set_f2(float f) noexcept = 0;
+  virtual float f2() const noexcept = 0;
+
+  virtual void  set_width(float w) noexcept = 0;
+  virtual float width() const noexcept = 0;
+
+  virtual void  set_gain(float g) noexcept = 0;
+  virtual float gain() const noexcept = 0;
+
+  virtual void  set_fixed_point(bool on) noexcept = 0;
+  virtual bool  fixed_point() const noexcept = 0;
+
+  //! Q format of the integer taps (-1 if the float path is in use:
+  //! fixed_point off, or taps too large for int16). Like taps() and
+  //! macs_per_sample() it follows the taps in use: a tap setter shows
+  //! there once work() has applied it
+  virtual int   taps_shift() const noexcept = 0;
+
+  virtual std::vector<float> taps() const = 0;
+
+  //! Spec-driven design (dB), as in flex_fir_ff
+  virtual void  set_attenuation(float db) noexcept = 0;
+  virtual float attenuation() const noexcept = 0;
+
+  virtual void  set_ripple(float db) noexcept = 0;
+  virtual float ripple() const noexcept = 0;
+
+  virtual int   ntaps() const noexcept = 0;
+  //! Real MACs per output sample of the path that runs: after symmetric
+  //! folding on the float path, 2 * taps on the int16 one (no folding)
+  virtual int   macs_per_sample() const noexcept = 0;
+};
+
+}} // namespace
+#endif
@@ -0,0 +1,65 @@
+#ifndef INCLUDED_HOWTO_FREQ_XLATING_DECIMATE_FIR_CC_H
+#define INCLUDED_HOWTO_FREQ_XLATING_DECIMATE_FIR_CC_H
+
+#include <howto/api.h>
+#include <gnuradio/block.h>
+#include <gnuradio/gr_complex.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * \brief decimate_fir_cc with the mixer folded in: shifts center_freq to DC,
+ *        low-passes and decimates by D.
+ * \details Replaces rotator -> decimate_fir_cc. The mix moves into
+ *          complex-rotated copies of the firdes low-pass taps and only the
+ *          remaining phase is applied, once per output, so the full-rate
+ *          complex multiply and its buffer disappear. The rotated taps stay
+ *          conjugate symmetric, so the product is folded like
+ *          decimate_fir_cc's.
+ *          set_center_freq() is glitch-free: new taps are swapped in at the
+ *          next work() boundary and the output phase carries on from where it
+ *          was (no history change, no stall). The other setters re-design
+ *          lazily, as in decimate_fir_cc. Single FIR stage.
+ */
+class HOWTO_API freq_xlating_decimate_fir_cc : virtual public gr::block
+{
+public:
+  typedef boost::shared_ptr<freq_xlating_decimate_fir_cc> sptr;
+
+  /*!
+   * \param decim       decimation factor (>= 1)
+   * \param samp_rate   input sample rate [Hz]
+   * \param center_freq frequency moved to DC [Hz]
+   * \param cutoff      low-pass cutoff [Hz]
+   * \param transition  transition width [Hz]
+   * \param window      firdes window id (e.g., firdes::WIN_HAMMING)
+   * \param kaiser_beta Kaiser beta (only used if window == WIN_KAISER)
+   */
+  static sptr make(int decim, double samp_rate, double center_freq,
+                   double cutoff, double transition,
+                   int window = 0, double kaiser_beta = 6.76);
+
+  virtual int    decimation()  const noexcept = 0;
+  virtual double samp_rate()   const noexcept = 0;
+  virtual double center_freq() const noexcept = 0;
+  virtual double cutoff()      const noexcept = 0;
+  virtual double transition()  const noexcept = 0;
+  virtual int    window()      const noexcept = 0;
+  virtual double kaiser_beta() const noexcept = 0;
+
+  //! Rotated taps in use (centre tap real)
+  virtual std::vector<gr_complex> taps() const = 0;
+
+  virtual void set_center_freq(double fc) = 0;
+  virtual void set_decimation(int decim) = 0;
+  virtual void set_samp_rate(double fs) = 0;
+  virtual void set_cutoff(double fc) = 0;
+  virtual void set_transition(double tw) = 0;
+  virtual void set_window(int w) = 0;
+  virtual void set_kaiser_beta(double beta) = 0;
+};
+
+}} // namespace gr::howto
+#endif
@@ -0,0 +1,49 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifndef INCLUDED_HOWTO_IQ_SELECT_MULTI_CF_H
+#define INCLUDED_HOWTO_IQ_SELECT_MULTI_CF_H
+
+#include <howto/api.h>
+#include <gnuradio/sync_block.h>
+#include <vector>
+
+namespace gr {
+  namespace howto {
+
+  /*!
+   * \brief Several iq_select_cf modes from one input, in a single pass.
+   *
+   * Output k is  scale * f_k(x)  with f_k = modes[k], using the iq_select_cf
+   * codes:
+   *   0: |x|   1: |x|^2   2: arg(x)   3: Re{x}   4: Im{x}   5: |arg(x)|
+   *
+   * Replaces N iq_select_cf blocks on the same stream: the input is read
+   * once, re^2 + im^2 is computed once for |x| and |x|^2, and atan2 once
+   * for arg(x) and |arg(x)|. Only the connected outputs are computed; an
+   * output whose mode is out of range (e.g. -1, or k >= modes.size())
+   * is zeros and costs nothing else. set_modes() re-routes the outputs
+   * at the next work() call.
+   */
+  class HOWTO_API iq_select_multi_cf : virtual public gr::sync_block
+    {
+    public:
+        typedef boost::shared_ptr<iq_select_multi_cf> sptr;
+
+        /*!
+         * \param scale multiplicative scale (all outputs)
+         * \param modes mode of each output (0..5)
+         */
+        static sptr make(float scale, const std::vector<int>& modes);
+
+        virtual void  set_scale(float scale) = 0;
+        virtual float scale() const = 0;
+
+        virtual void  set_modes(const std::vector<int>& modes) = 0;
+        virtual std::vector<int> modes() const = 0;
+
+        virtual ~iq_select_multi_cf() {}
+    };
+
+  }} // namespace gr::howto
+
+#endif /* INCLUDED_HOWTO_IQ_SELECT_MULTI_CF_H */
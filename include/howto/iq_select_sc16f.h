@@ -0,0 +1,43 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifndef INCLUDED_HOWTO_IQ_SELECT_SC16F_H
+#define INCLUDED_HOWTO_IQ_SELECT_SC16F_H
+
+#include <howto/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr { 
+  namespace howto {
+
+  /*!
+   * \brief I/Q selectable processor for interleaved int16 IQ (sc16 -> float)
+   *
+   * Same modes as iq_select_cf (mode 0 is iq_mag_cf), reading sc16 samples
+   * straight from the front end. Samples are taken as full scale [-1, 1)
+   * (x / 32768), so the output matches a normalized short-to-complex
+   * conversion followed by iq_select_cf, without the intermediate stream.
+   */
+  class HOWTO_API iq_select_sc16f : virtual public gr::sync_block
+    {
+    public:
+        typedef boost::shared_ptr<iq_select_sc16f> sptr;
+
+        /*!
+         * \brief Factory
+         * \param scale multiplicative scale
+         * \param mode  processing mode (0..5, as iq_select_cf)
+         */
+        static sptr make(float scale, int mode);
+
+        virtual void  set_scale(float scale)  = 0;
+        virtual float scale() const  = 0;
+
+        virtual void  set_mode(int mode)  = 0;
+        virtual int   mode() const  = 0;
+
+        virtual ~iq_select_sc16f() {}
+    };
+
+  }} // namespace gr::howto
+
+#endif /* INCLUDED_HOWTO_IQ_SELECT_SC16F_H */
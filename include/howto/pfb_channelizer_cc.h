@@ -0,0 +1,66 @@
+#ifndef INCLUDED_HOWTO_PFB_CHANNELIZER_CC_H
+#define INCLUDED_HOWTO_PFB_CHANNELIZER_CC_H
+
+#include <howto/api.h>
+#include <gnuradio/sync_decimator.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * \brief Polyphase filter-bank channelizer: one wideband input, nchans outputs.
+ * \details Output k is the band centred on k * samp_rate / nchans (k above
+ *          nchans/2 are the negative frequencies), i.e. what a
+ *          freq_xlating_decimate_fir_cc at that frequency would give, for all
+ *          channels at once: a polyphase FIR (ceil(T/nchans) MACs per branch)
+ *          plus one nchans-point FFT per output frame, O(log nchans) per input
+ *          sample instead of O(nchans).
+ *          oversample = 1 gives critically sampled channels (rate
+ *          samp_rate / nchans), 2 gives twice that (nchans must be even),
+ *          which keeps band edges alias-free when transition spills past
+ *          the channel spacing.
+ *          The prototype is the firdes low-pass decimate_fir_cc uses
+ *          (cutoff/transition in Hz at samp_rate). Unconnected trailing
+ *          outputs are allowed and cost nothing beyond the FFT.
+ */
+class HOWTO_API pfb_channelizer_cc : virtual public gr::sync_decimator
+{
+public:
+  typedef boost::shared_ptr<pfb_channelizer_cc> sptr;
+
+  /*!
+   * \param nchans      number of channels M (>= 2)
+   * \param samp_rate   input sample rate [Hz]
+   * \param cutoff      prototype cutoff [Hz] (e.g. samp_rate / (2M))
+   * \param transition  prototype transition width [Hz]
+   * \param oversample  1 (critically sampled) or 2
+   * \param window      firdes window id (e.g., firdes::WIN_HAMMING)
+   * \param kaiser_beta Kaiser beta (only used if window == WIN_KAISER)
+   */
+  static sptr make(int nchans, double samp_rate, double cutoff, double transition,
+                   int oversample = 1, int window = 0, double kaiser_beta = 6.76);
+
+  virtual int    nchans() const noexcept = 0;
+  virtual int    oversample() const noexcept = 0;
+  virtual double samp_rate() const noexcept = 0;
+  virtual double cutoff() const noexcept = 0;
+  virtual double transition() const noexcept = 0;
+  virtual int    window() const noexcept = 0;
+  virtual double kaiser_beta() const noexcept = 0;
+
+  //! Prototype taps in use
+  virtual std::vector<float> taps() const = 0;
+  //! Taps per polyphase branch
+  virtual int taps_per_branch() const noexcept = 0;
+
+  // Prototype changes apply at the next work(); the delay lines and the
+  // channel phase carry over (a longer prototype starts with zero history)
+  virtual void set_cutoff(double fc) = 0;
+  virtual void set_transition(double tw) = 0;
+  virtual void set_window(int w) = 0;
+  virtual void set_kaiser_beta(double beta) = 0;
+};
+
+}} // namespace gr::howto
+#endif
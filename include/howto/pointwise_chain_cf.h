@@ -0,0 +1,51 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifndef INCLUDED_HOWTO_POINTWISE_CHAIN_CF_H
+#define INCLUDED_HOWTO_POINTWISE_CHAIN_CF_H
+
+#include <howto/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace howto {
+
+  /*!
+   * \brief Fused point-wise chain (complex -> float) in a single pass.
+   *
+   * Computes  out = gain * f(x)        (square = false)
+   *      or   out = gain * f(x)^2      (square = true)
+   * where f is the iq_select_cf mode:
+   *   0: |x|   1: |x|^2   2: arg(x)   3: Re{x}   4: Im{x}   5: |arg(x)|
+   *
+   * Replaces chains such as iq_mag_cf -> square_ff -> gain_ff without the
+   * intermediate buffers: mode 0 + square collapses to re^2 + im^2 (no sqrt).
+   * Fold any per-stage scale into 'gain' (iq_mag_cf(s) -> square_ff -> gain_ff(g)
+   * equals mode 0, square, gain = g*s*s).
+   */
+  class HOWTO_API pointwise_chain_cf : virtual public gr::sync_block
+    {
+    public:
+        typedef boost::shared_ptr<pointwise_chain_cf> sptr;
+
+        /*!
+         * \param mode   selector stage (0..5, as iq_select_cf)
+         * \param square square the selector output
+         * \param gain   final multiplicative gain
+         */
+        static sptr make(int mode, bool square, float gain);
+
+        virtual void  set_mode(int mode) = 0;
+        virtual int   mode() const = 0;
+
+        virtual void  set_square(bool square) = 0;
+        virtual bool  square() const = 0;
+
+        virtual void  set_gain(float gain) = 0;
+        virtual float gain() const = 0;
+
+        virtual ~pointwise_chain_cf() {}
+    };
+
+  }} // namespace gr::howto
+
+#endif /* INCLUDED_HOWTO_POINTWISE_CHAIN_CF_H */
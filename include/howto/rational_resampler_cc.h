@@ -0,0 +1,66 @@
+#ifndef INCLUDED_HOWTO_RATIONAL_RESAMPLER_CC_H
+#define INCLUDED_HOWTO_RATIONAL_RESAMPLER_CC_H
+
+#include <howto/api.h>
+#include <gnuradio/block.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * \brief Complex rational resampler: output rate = samp_rate * interp / decim.
+ * \details Polyphase form of "zero-stuff by L, low-pass, keep every M-th":
+ *          only the branch each output needs is evaluated, ceil(T/L) MACs
+ *          per output. The low-pass comes from the same firdes design as
+ *          decimate_fir_cc (cutoff/transition in Hz at samp_rate, designed at
+ *          L * samp_rate with gain L); keep cutoff + transition/2 below
+ *          min(samp_rate, output rate) / 2. interp/decim are reduced by their
+ *          gcd, e.g. (625, 768) for 30.72 -> 25 MS/s.
+ *          Tags are moved to the first output whose window contains the
+ *          tagged sample (exact integer mapping, no rounding drift).
+ *          Setters apply lazily (next work() re-designs), as in
+ *          decimate_fir_cc.
+ */
+class HOWTO_API rational_resampler_cc : virtual public gr::block
+{
+public:
+  typedef boost::shared_ptr<rational_resampler_cc> sptr;
+
+  /*!
+   * \param interp      interpolation L (>= 1)
+   * \param decim       decimation M (>= 1)
+   * \param samp_rate   input sample rate [Hz]
+   * \param cutoff      low-pass cutoff [Hz]
+   * \param transition  transition width [Hz]
+   * \param window      firdes window id (e.g., firdes::WIN_HAMMING)
+   * \param kaiser_beta Kaiser beta (only used if window == WIN_KAISER)
+   */
+  static sptr make(int interp, int decim, double samp_rate,
+                   double cutoff, double transition,
+                   int window = 0, double kaiser_beta = 6.76);
+
+  //! Reduced L and M in use
+  virtual int    interpolation() const noexcept = 0;
+  virtual int    decimation() const noexcept = 0;
+  virtual double samp_rate() const noexcept = 0;
+  virtual double cutoff() const noexcept = 0;
+  virtual double transition() const noexcept = 0;
+  virtual int    window() const noexcept = 0;
+  virtual double kaiser_beta() const noexcept = 0;
+
+  //! Prototype length / L (= MACs per output)
+  virtual int taps_per_phase() const noexcept = 0;
+  //! Prototype taps (at L * samp_rate, gain L)
+  virtual std::vector<float> taps() const = 0;
+
+  virtual void set_rate(int interp, int decim) = 0;
+  virtual void set_samp_rate(double fs) = 0;
+  virtual void set_cutoff(double fc) = 0;
+  virtual void set_transition(double tw) = 0;
+  virtual void set_window(int w) = 0;
+  virtual void set_kaiser_beta(double beta) = 0;
+};
+
+}} // namespace gr::howto
+#endif
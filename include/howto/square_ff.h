@@ -23,17 +23,17 @@
 #define INCLUDED_HOWTO_SQUARE_FF_H
 
 #include <howto/api.h>
-#include <gnuradio/block.h>
+#include <gnuradio/sync_block.h>
 
 namespace gr {
   namespace howto {
 
     /*!
-     * \brief <+description of block+>
+     * \brief Squares each sample: out[i] = in[i]^2 (1:1 sync block).
      * \ingroup howto
      *
      */
-    class HOWTO_API square_ff : virtual public gr::block
+    class HOWTO_API square_ff : virtual public gr::sync_block
     {
      public:
       typedef boost::shared_ptr<square_ff> sptr;
@@ -0,0 +1,203 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_CIC_DECIM_H
+#define INCLUDED_HOWTO_CIC_DECIM_H
+
+#include "decim_stage.h"
+#include "decim_planner.h"
+#include <gnuradio/filter/firdes.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include <stdint.h>
+#include <stdexcept>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * CIC decimator (Hogenauer): N integrators at the input rate, decimate
+	 * by R, N combs at the output rate. No multiplies at all, but a
+	 * sinc^N response:
+	 *
+	 *   |H(f)| = |sin(pi f R) / (R sin(pi f))|^N     (f in cycles/input sample)
+	 *
+	 * The integrators run in wrapping 64-bit integer arithmetic (the only
+	 * exact way: float integrators drift), on the input scaled by 2^s. s is
+	 * chosen so the bit growth N*log2(R) plus headroom_bits (8 by default:
+	 * inputs up to +/-256) fits in 63 bits; inputs beyond max_input()
+	 * saturate there instead of wrapping. The output is normalized to unity
+	 * DC gain.
+	 */
+	class cic_decim_stage : public decim_stage
+	{
+	public:
+	  enum { MAX_ORDER = 6, HEADROOM_BITS = 8, MIN_FRAC_BITS = 14 };
+
+	  //! ceil(N log2 R)
+	  static int bit_growth(int R, int N)
+	  {
+	    return (int)std::ceil(N * std::log(double(R)) / std::log(2.0) - 1e-9);
+	  }
+
+	  //! true if (R, N) leaves at least MIN_FRAC_BITS of input precision
+	  static bool fits(int R, int N, int headroom_bits = HEADROOM_BITS)
+	  {
+	    return 62 - headroom_bits - bit_growth(R, N) >= MIN_FRAC_BITS;
+	  }
+
+	  //! |H(f)|, f in cycles per input sample
+	  static double response(double f, int R, int N)
+	  {
+	    const double s = std::sin(M_PI * f);
+	    if (std::fabs(s) < 1e-12) return 1.0;
+	    return std::pow(std::fabs(std::sin(M_PI * f * R) / (R * s)), N);
+	  }
+
+	  cic_decim_stage(int R, int N, int headroom_bits = HEADROOM_BITS)
+	  : d_R(R), d_N(N)
+	  {
+	    if (R < 2) throw std::invalid_argument("CIC decimation must be >= 2");
+	    if (N < 1 || N > MAX_ORDER) throw std::invalid_argument("CIC order must be 1..6");
+	    if (!fits(R, N, headroom_bits)) throw std::invalid_argument("CIC bit growth too large");
+	    const int s = std::min(30, 62 - headroom_bits - bit_growth(R, N));
+	    d_scale_in  = std::ldexp(1.0, s);
+	    d_scale_out = 1.0 / (d_scale_in * std::pow(double(R), N));
+	    d_max_in    = std::ldexp(1.0, 62 - s - bit_growth(R, N));
+	    reset();
+	  }
+
+	  int decimation() const { return d_R; }
+	  int order() const { return d_N; }
+	  //! Largest |input| (per rail) that cannot wrap the integrators
+	  double max_input() const { return d_max_in; }
+
+	  // The impulse response is only N(R-1)+1 long, but the integrators
+	  // start from zero after a reset: the N combs cancel that offset once
+	  // they hold N outputs of their own.
+	  int memory() const { return d_N * d_R; }
+
+	  void reset()
+	  {
+	    d_phase = 0;
+	    for (int n = 0; n < MAX_ORDER; ++n) {
+	      d_int_i[n] = d_int_q[n] = 0;
+	      d_comb_i[n] = d_comb_q[n] = 0;
+	    }
+	  }
+
+	  // The output is taken at the first sample of every group of R, like
+	  // the FIR stages (output k sees input k*R as its newest sample).
+	  int process(const gr_complex* in, int nin, gr_complex* out)
+	  {
+	    const int N = d_N;
+	    int nout = 0;
+	    for (int k = 0; k < nin; ++k) {
+	      uint64_t ai = (uint64_t)(int64_t)std::llrint(clip_(in[k].real()) * d_scale_in);
+	      uint64_t aq = (uint64_t)(int64_t)std::llrint(clip_(in[k].imag()) * d_scale_in);
+	      for (int n = 0; n < N; ++n) {
+		d_int_i[n] += ai; ai = d_int_i[n];
+		d_int_q[n] += aq; aq = d_int_q[n];
+	      }
+	      if (d_phase == 0) {
+		for (int n = 0; n < N; ++n) {
+		  const uint64_t yi = ai - d_comb_i[n]; d_comb_i[n] = ai; ai = yi;
+		  const uint64_t yq = aq - d_comb_q[n]; d_comb_q[n] = aq; aq = yq;
+		}
+		out[nout++] = gr_complex((float)((double)(int64_t)ai * d_scale_out),
+					 (float)((double)(int64_t)aq * d_scale_out));
+	      }
+	      if (++d_phase == d_R) d_phase = 0;
+	    }
+	    return nout;
+	  }
+
+	  //! Real-input version (uses the I integrators only)
+	  int process(const float* in, int nin, float* out)
+	  {
+	    const int N = d_N;
+	    int nout = 0;
+	    for (int k = 0; k < nin; ++k) {
+	      uint64_t a = (uint64_t)(int64_t)std::llrint(clip_(in[k]) * d_scale_in);
+	      for (int n = 0; n < N; ++n) { d_int_i[n] += a; a = d_int_i[n]; }
+	      if (d_phase == 0) {
+		for (int n = 0; n < N; ++n) { const uint64_t y = a - d_comb_i[n]; d_comb_i[n] = a; a = y; }
+		out[nout++] = (float)((double)(int64_t)a * d_scale_out);
+	      }
+	      if (++d_phase == d_R) d_phase = 0;
+	    }
+	    return nout;
+	  }
+
+	  double macs_per_output() const { return 0.0; }
+	  double adds_per_output() const { return double(d_N) * (d_R + 1); }
+
+	  std::string describe() const
+	  {
+	    char s[64];
+	    snprintf(s, sizeof(s), "CIC(R=%d, N=%d)", d_R, d_N);
+	    return s;
+	  }
+
+	private:
+	  double clip_(float x) const { return std::max(-d_max_in, std::min(d_max_in, (double)x)); }
+
+	  int d_R, d_N, d_phase;
+	  double d_scale_in, d_scale_out, d_max_in;
+	  uint64_t d_int_i[MAX_ORDER], d_int_q[MAX_ORDER];    // wrap-around is intended
+	  uint64_t d_comb_i[MAX_ORDER], d_comb_q[MAX_ORDER];
+	};
+
+	/*!
+	 * Compensation FIR for a CIC(R, N), to run at the CIC output rate fs.
+	 *
+	 * Windowed frequency sampling of
+	 *   A(f) = 1 / |H_cic(f)|          for f <= cutoff - trans/2
+	 *   A(f) = raised-cosine to 0      across the transition
+	 * with the firdes tap count for (window, trans), so it reads like a
+	 * firdes::low_pass whose passband also undoes the CIC droop (the
+	 * correction is capped at +6 dB). Unity DC gain, symmetric taps.
+	 */
+	static inline std::vector<float>
+	design_cic_compensator(int R, int N, double fs, double cutoff, double trans,
+			       gr::filter::firdes::win_type window, double beta)
+	{
+	  if (!(cutoff > 0.0 && trans > 0.0 && cutoff + 0.5 * trans <= 0.5 * fs))
+	    throw std::invalid_argument("compensator cutoff/transition out of range");
+
+	  const double atten = window_attenuation_db(window, beta);
+	  int ntaps = (int)(atten * fs / (22.0 * trans));
+	  if ((ntaps & 1) == 0) ntaps++;
+	  const int c = ntaps / 2;
+
+	  // dense grid over [0, cutoff + trans/2], trapezoidal weights
+	  const double fp = std::max(0.0, cutoff - 0.5 * trans);
+	  const double fe = cutoff + 0.5 * trans;
+	  const int    G  = std::max(64, 8 * ntaps);
+	  std::vector<double> A(G + 1);
+	  for (int k = 0; k <= G; ++k) {
+	    const double f = fe * k / G;
+	    double a = std::min(2.0, 1.0 / cic_decim_stage::response(f / (fs * R), R, N));
+	    if (f > fp) a *= 0.5 * (1.0 + std::cos(M_PI * (f - fp) / trans));
+	    A[k] = (k == 0 || k == G) ? 0.5 * a : a;
+	  }
+
+	  const std::vector<float> w = gr::filter::firdes::window(window, ntaps, beta);
+	  std::vector<float> h(ntaps);
+	  double sum = 0.0;
+	  for (int n = 0; n < ntaps; ++n) {
+	    double acc = 0.0;
+	    for (int k = 0; k <= G; ++k)
+	      acc += A[k] * std::cos(2.0 * M_PI * (fe * k / G) * (n - c) / fs);
+	    h[n] = (float)(acc * w[n]);
+	    sum += h[n];
+	  }
+	  for (int n = 0; n < ntaps; ++n) h[n] = (float)(h[n] / sum);
+	  return h;
+	}
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_CIC_DECIM_H */
@@ -0,0 +1,35 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <howto/cic_decim_cc.h>
+#include <howto/cic_decim_ff.h>
+#include "cic_decim_impl.h"
+
+namespace gr { namespace howto {
+
+cic_decim_cc::sptr cic_decim_cc::make(int decim, int order, double samp_rate,
+                                      bool compensate, int comp_decim,
+                                      double cutoff, double transition,
+                                      int window, double kaiser_beta)
+{
+    return gnuradio::get_initial_sptr(
+        new cic_decim_impl<gr_complex, cic_decim_cc>("cic_decim_cc", decim, order, samp_rate,
+                                                     compensate, comp_decim, cutoff, transition,
+                                                     window, kaiser_beta));
+}
+
+cic_decim_ff::sptr cic_decim_ff::make(int decim, int order, double samp_rate,
+                                      bool compensate, int comp_decim,
+                                      double cutoff, double transition,
+                                      int window, double kaiser_beta)
+{
+    return gnuradio::get_initial_sptr(
+        new cic_decim_impl<float, cic_decim_ff>("cic_decim_ff", decim, order, samp_rate,
+                                                compensate, comp_decim, cutoff, transition,
+                                                window, kaiser_beta));
+}
+
+}} // namespace gr::howto
@@ -0,0 +1,206 @@
+#ifndef INCLUDED_HOWTO_CIC_DECIM_IMPL_H
+#define INCLUDED_HOWTO_CIC_DECIM_IMPL_H
+
+#include "cic_decim.h"
+#include "fir_decim.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/filter/firdes.h>
+#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <stdexcept>
+#include <algorithm>
+
+namespace gr {
+
+   namespace howto {
+
+	/*
+	 * Shared implementation of cic_decim_cc / cic_decim_ff (T = gr_complex
+	 * or float). The CIC and the compensator keep their own state, so the
+	 * block runs with history(1) and consumes exactly D per output.
+	 */
+	template<class T, class Iface>
+	class cic_decim_impl final : public Iface
+	{
+	private:
+	  // Parameters guarded by d_mutex
+	  mutable boost::mutex d_mutex;
+	  int    d_R, d_N, d_comp_decim;
+	  double d_fs, d_cutoff, d_trans;
+	  gr::filter::firdes::win_type d_window;
+	  double d_beta;
+	  bool   d_comp;
+	  bool   d_dirty;
+
+	  // Engine, only touched from the ctor and work()
+	  boost::shared_ptr<cic_decim_stage> d_cic;
+	  boost::shared_ptr<fir_decim_stage> d_fir;
+	  std::vector<T> d_mid;
+	  int    d_D;              // applied total decimation
+
+	  static void check_cic_(int R, int N)
+	  {
+	    if (R < 2) throw std::invalid_argument("decim must be >= 2");
+	    if (N < 1 || N > cic_decim_stage::MAX_ORDER) throw std::invalid_argument("order must be 1..6");
+	  }
+
+	  void design_locked()
+	  {
+	    // The ctor and the R/N setters only accept pairs that fit
+	    const int N = d_N;
+	    d_cic.reset(new cic_decim_stage(d_R, N));
+
+	    d_fir.reset();
+	    int D = d_R;
+	    if (d_comp) {
+	      const double fs_c = d_fs / d_R;
+	      // the stop band has to clear the Nyquist after the compensator's
+	      // own decimation, not just the CIC output rate
+	      const double nyq = 0.5 * fs_c / d_comp_decim;
+	      double fc = d_cutoff, tw = d_trans;
+	      const double edge = fc + 0.5 * tw;
+	      if (edge > nyq) { fc *= nyq / edge; tw *= nyq / edge; }
+	      d_fir.reset(new fir_decim_stage(
+		design_cic_compensator(d_R, N, fs_c, fc, tw, d_window, d_beta), d_comp_decim));
+	      D *= d_comp_decim;
+	    }
+	    d_D = D;
+	    this->set_relative_rate(1.0 / static_cast<double>(D));
+	    d_dirty = false;
+	  }
+
+	public:
+	  cic_decim_impl(const char* name, int decim, int order, double fs,
+			 bool compensate, int comp_decim, double cutoff, double trans,
+			 int window, double beta) /* may throw */
+	  : gr::block(name,
+		      gr::io_signature::make(1, 1, sizeof(T)),
+		      gr::io_signature::make(1, 1, sizeof(T))),
+	    d_R(decim), d_N(order), d_comp_decim(comp_decim),
+	    d_fs(fs), d_cutoff(cutoff), d_trans(trans),
+	    d_window(static_cast<gr::filter::firdes::win_type>(window)), d_beta(beta),
+	    d_comp(compensate), d_dirty(true), d_D(decim)
+	  {
+	    check_cic_(d_R, d_N);
+	    if (!cic_decim_stage::fits(d_R, d_N)) throw std::invalid_argument("decim/order bit growth too large");
+	    if (d_fs <= 0.0)      throw std::invalid_argument("samp_rate must be > 0");
+	    if (d_comp_decim < 1) throw std::invalid_argument("comp_decim must be >= 1");
+	    if (d_comp && (d_cutoff <= 0.0 || d_trans <= 0.0 ||
+			   d_cutoff + 0.5 * d_trans > 0.5 * d_fs / (d_R * d_comp_decim)))
+	      throw std::invalid_argument("compensator cutoff + transition/2 must be within (0, fs/(2*decim*comp_decim)]");
+
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    design_locked();
+	  }
+
+	  ~cic_decim_impl() override {}
+
+	  // Queries
+	  int    decimation() const noexcept override      { boost::lock_guard<boost::mutex> lk(d_mutex); return d_R; }
+	  int    order() const noexcept override           { boost::lock_guard<boost::mutex> lk(d_mutex); return d_N; }
+	  double samp_rate() const noexcept override       { boost::lock_guard<boost::mutex> lk(d_mutex); return d_fs; }
+	  bool   compensate() const noexcept override      { boost::lock_guard<boost::mutex> lk(d_mutex); return d_comp; }
+	  int    comp_decimation() const noexcept override { boost::lock_guard<boost::mutex> lk(d_mutex); return d_comp_decim; }
+	  double cutoff() const noexcept override          { boost::lock_guard<boost::mutex> lk(d_mutex); return d_cutoff; }
+	  double transition() const noexcept override      { boost::lock_guard<boost::mutex> lk(d_mutex); return d_trans; }
+
+	  std::vector<float> comp_taps() const override
+	  {
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    return d_fir ? d_fir->taps() : std::vector<float>();
+	  }
+
+	  // Setters (mark dirty, cheap)
+	  void set_decimation(int decim) override
+	  {
+	    if (decim < 2) throw std::invalid_argument("decim must be >= 2");
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (!cic_decim_stage::fits(decim, d_N)) throw std::invalid_argument("decim/order bit growth too large");
+	    if (decim != d_R) { d_R = decim; d_dirty = true; }
+	  }
+	  void set_order(int order) override
+	  {
+	    if (order < 1 || order > cic_decim_stage::MAX_ORDER) throw std::invalid_argument("order must be 1..6");
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (!cic_decim_stage::fits(d_R, order)) throw std::invalid_argument("decim/order bit growth too large");
+	    if (order != d_N) { d_N = order; d_dirty = true; }
+	  }
+	  void set_samp_rate(double fs) override
+	  {
+	    if (fs <= 0.0) throw std::invalid_argument("samp_rate must be > 0");
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (fs != d_fs) { d_fs = fs; d_dirty = true; }
+	  }
+	  void set_compensate(bool on) override
+	  {
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (on != d_comp) { d_comp = on; d_dirty = true; }
+	  }
+	  void set_comp_decimation(int d) override
+	  {
+	    if (d < 1) throw std::invalid_argument("comp_decim must be >= 1");
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (d != d_comp_decim) { d_comp_decim = d; d_dirty = true; }
+	  }
+	  void set_cutoff(double fc) override
+	  {
+	    if (fc <= 0.0) throw std::invalid_argument("cutoff must be > 0");
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (fc != d_cutoff) { d_cutoff = fc; d_dirty = true; }
+	  }
+	  void set_transition(double tw) override
+	  {
+	    if (tw <= 0.0) throw std::invalid_argument("transition must be > 0");
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (tw != d_trans) { d_trans = tw; d_dirty = true; }
+	  }
+
+	  // GNURadio API
+	  void forecast(int noutput_items, gr_vector_int &ninput_items_required) override
+	  {
+	    int D;
+	    {
+	      boost::lock_guard<boost::mutex> lk(d_mutex);
+	      D = d_D;
+	    }
+	    ninput_items_required[0] = std::max(D * noutput_items, D);
+	  }
+
+	  int general_work(int noutput_items,
+			   gr_vector_int &ninput_items,
+			   gr_vector_const_void_star &input_items,
+			   gr_vector_void_star &output_items) override
+	  {
+	    const T* in  = static_cast<const T*>(input_items[0]);
+	    T*       out = static_cast<T*>(output_items[0]);
+
+	    int D;
+	    {
+	      boost::lock_guard<boost::mutex> lk(d_mutex);
+	      if (d_dirty) {
+		// New rate: let the scheduler pick up the new relative_rate first
+		design_locked();
+		return 0;
+	      }
+	      D = d_D;
+	    }
+
+	    const int nout = std::min(noutput_items, ninput_items[0] / D);
+	    if (nout <= 0) return 0;
+
+	    if (d_fir) {
+	      const int nmid = nout * d_fir->decimation();
+	      d_mid.resize(nmid);
+	      d_cic->process(in, nout * D, &d_mid[0]);
+	      d_fir->process(&d_mid[0], nmid, out);
+	    } else {
+	      d_cic->process(in, nout * D, out);
+	    }
+
+	    this->consume_each(nout * D);
+	    return nout;
+	  }
+	};
+
+}} // namespace gr::howto
+#endif
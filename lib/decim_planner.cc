@@ -0,0 +1,241 @@
+/* -*- c++ -*- */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "decim_planner.h"
+#include "fir_decim.h"
+#include "halfband_decim.h"
+#include "cic_decim.h"
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+
+using gr::filter::firdes;
+
+namespace gr {
+    namespace howto {
+
+	// ---- decim_chain ----
+
+	void decim_chain::reset()
+	{
+	  for (size_t i = 0; i < d_stages.size(); ++i) d_stages[i]->reset();
+	}
+
+	int decim_chain::process(const gr_complex* in, int nin, gr_complex* out)
+	{
+	  const int n = stages();
+	  const gr_complex* src = in;
+	  int len = nin;
+	  for (int i = 0; i < n; ++i) {
+	    gr_complex* dst;
+	    if (i == n - 1) {
+	      dst = out;
+	    } else {
+	      std::vector<gr_complex>& s = d_scratch[i & 1];
+	      s.resize(len / d_stages[i]->decimation());
+	      dst = &s[0];
+	    }
+	    len = d_stages[i]->process(src, len, dst);
+	    src = dst;
+	  }
+	  return len;
+	}
+
+	int decim_chain::decimation() const
+	{
+	  int D = 1;
+	  for (int i = 0; i < stages(); ++i) D *= d_stages[i]->decimation();
+	  return D;
+	}
+
+	int decim_chain::memory() const
+	{
+	  // stage i sees every R-th chain input, R = decimation before it
+	  int m = 0, R = 1;
+	  for (int i = 0; i < stages(); ++i) {
+	    m += d_stages[i]->memory() * R;
+	    R *= d_stages[i]->decimation();
+	  }
+	  return m;
+	}
+
+	double decim_chain::macs_per_output() const
+	{
+	  double c = 0.0, rate = 1.0;     // stage output rate relative to the chain output
+	  for (int i = stages() - 1; i >= 0; --i) {
+	    c += rate * d_stages[i]->macs_per_output();
+	    rate *= d_stages[i]->decimation();
+	  }
+	  return c;
+	}
+
+	double decim_chain::adds_per_output() const
+	{
+	  double c = 0.0, rate = 1.0;
+	  for (int i = stages() - 1; i >= 0; --i) {
+	    c += rate * d_stages[i]->adds_per_output();
+	    rate *= d_stages[i]->decimation();
+	  }
+	  return c;
+	}
+
+	double decim_chain::cost() const
+	{
+	  return macs_per_output() + DECIM_CIC_ADD_COST * adds_per_output();
+	}
+
+	std::string decim_chain::describe() const
+	{
+	  std::string s;
+	  for (int i = 0; i < stages(); ++i) {
+	    if (i) s += " -> ";
+	    s += d_stages[i]->describe();
+	  }
+	  char c[96];
+	  snprintf(c, sizeof(c), ": %.1f MAC + %.0f add / out", macs_per_output(), adds_per_output());
+	  return s + c;
+	}
+
+	// ---- planner ----
+
+	double window_attenuation_db(firdes::win_type w, double beta)
+	{
+	  // Same table firdes uses to size its filters
+	  switch (w) {
+	    case firdes::WIN_HAMMING:         return 53.0;
+	    case firdes::WIN_HANN:            return 44.0;
+	    case firdes::WIN_BLACKMAN:        return 74.0;
+	    case firdes::WIN_RECTANGULAR:     return 21.0;
+	    case firdes::WIN_KAISER:          return beta / 0.1102 + 8.7;
+	    case firdes::WIN_BLACKMAN_hARRIS: return 92.0;
+	    default:                          return 53.0;
+	  }
+	}
+
+	std::vector<float> design_lowpass(const decim_spec& s, double gain, double fs)
+	{
+	  const std::vector<float> taps =
+	    firdes::low_pass(gain, fs, s.cutoff, s.trans, s.window, s.beta);
+	  if (taps.empty())
+	    throw std::runtime_error("firdes::low_pass returned empty taps");
+	  return taps;
+	}
+
+	// firdes::low_pass tap count (compute_ntaps)
+	static int fir_ntaps_(double atten, double fs, double trans)
+	{
+	  int n = (int)(atten * fs / (22.0 * trans));
+	  if ((n & 1) == 0) n++;
+	  return n;
+	}
+
+	// Smallest CIC order meeting the alias and droop limits, 0 if none
+	static int cic_order_(int R, double fs, const decim_spec& s, double atten)
+	{
+	  const double protect = s.cutoff + 0.5 * s.trans;             // alias-free band
+	  const double pass    = std::max(0.0, s.cutoff - 0.5 * s.trans);
+	  const double fs_out  = fs / R;
+	  if (protect >= 0.5 * fs_out) return 0;
+
+	  for (int N = 1; N <= cic_decim_stage::MAX_ORDER; ++N) {
+	    if (!cic_decim_stage::fits(R, N, DECIM_CIC_HEADROOM_BITS)) return 0;
+	    // worst alias: the images around k*fs_out folding onto [0, protect]
+	    double worst = 0.0;
+	    for (int k = 1; k <= R / 2; ++k)
+	      worst = std::max(worst, cic_decim_stage::response((k * fs_out - protect) / fs, R, N));
+	    if (20.0 * std::log10(worst + 1e-300) > -atten) continue;
+	    const double droop = -20.0 * std::log10(cic_decim_stage::response(pass / fs, R, N));
+	    return droop <= 0.2 ? N : 0;       // higher orders only droop more
+	  }
+	  return 0;
+	}
+
+	// Intermediate half-bands use this fraction of the widest alias-safe transition,
+	// so their own passband roll-off stays clear of the final passband edge
+	static const double HB_TW_FRAC = 0.7;
+
+	struct plan_candidate_
+	{
+	  int cic_R, cic_N, hb, fir_D;
+	  bool fir;
+	  double cost;
+	};
+
+	void plan_decimation(const decim_spec& s, bool multistage, decim_chain& chain)
+	{
+	  const int    D      = s.decim;
+	  const double atten  = window_attenuation_db(s.window, s.beta);
+	  const double fs_out = s.fs / D;
+	  const double protect = s.cutoff + 0.5 * s.trans;
+	  const bool   hb_final_ok =
+	    std::fabs(s.cutoff - 0.5 * fs_out) <= 0.01 * fs_out && s.trans < fs_out;
+
+	  // Single stage: the reference every plan has to beat
+	  plan_candidate_ best = { 1, 0, 0, D, true,
+				   double((fir_ntaps_(atten, s.fs, s.trans) + 1) / 2) };
+
+	  if (multistage) {
+	    for (int R = 1; R <= D; ++R) {
+	      if (D % R) continue;
+	      int N = 0;
+	      if (R > 1) {
+		N = cic_order_(R, s.fs, s, atten);
+		if (N == 0) continue;
+	      }
+	      const double cic_cost = (R > 1)
+		? DECIM_CIC_ADD_COST * N * (R + 1) * double(D / R) : 0.0;
+
+	      const int rem = D / R;
+	      for (int h = 0; (rem >> h) >= 1 && (rem % (1 << h)) == 0; ++h) {
+		const int f = rem >> h;
+		const bool fir = !(f == 1 && h > 0 && hb_final_ok);
+		double cost = cic_cost;
+		double fs_i = s.fs / R;
+		bool ok = true;
+		for (int i = 0; i < h && ok; ++i) {
+		  const bool last = (i == h - 1) && !fir;
+		  const double tw = last ? s.trans : HB_TW_FRAC * (0.5 * fs_i - 2.0 * protect);
+		  if (tw <= 0.0) { ok = false; break; }
+		  const int K = halfband_stage::estimate_K(std::min(tw / fs_i, 0.45), atten);
+		  cost += double(f << (h - 1 - i)) * (K + 1);
+		  fs_i *= 0.5;
+		}
+		if (!ok) continue;
+		if (fir) {
+		  if (s.cutoff >= 0.5 * fs_i) continue;
+		  cost += (fir_ntaps_(atten, fs_i, s.trans) + 1) / 2;
+		}
+		if (cost < best.cost) {
+		  plan_candidate_ c = { R, N, h, f, fir, cost };
+		  best = c;
+		}
+	      }
+	    }
+	  }
+
+	  // Design the winner
+	  chain.clear();
+	  double fs_i = s.fs;
+	  if (best.cic_R > 1) {
+	    chain.add(boost::shared_ptr<decim_stage>(new cic_decim_stage(best.cic_R, best.cic_N, DECIM_CIC_HEADROOM_BITS)));
+	    fs_i /= best.cic_R;
+	  }
+	  for (int i = 0; i < best.hb; ++i) {
+	    const bool last = (i == best.hb - 1) && !best.fir;
+	    const double tw = last ? s.trans : HB_TW_FRAC * (0.5 * fs_i - 2.0 * protect);
+	    halfband_stage* hb = new halfband_stage();
+	    chain.add(boost::shared_ptr<decim_stage>(hb));
+	    hb->design(std::min(tw / fs_i, 0.45), s.window, s.beta);
+	    fs_i *= 0.5;
+	  }
+	  if (best.fir) {
+	    chain.add(boost::shared_ptr<decim_stage>(
+	      new fir_decim_stage(design_lowpass(s, 1.0, fs_i), best.fir_D)));
+	  }
+	}
+
+    } // namespace howto
+} // namespace gr
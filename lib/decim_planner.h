@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_DECIM_PLANNER_H
+#define INCLUDED_HOWTO_DECIM_PLANNER_H
+
+#include "decim_stage.h"
+#include <gnuradio/filter/firdes.h>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <string>
+
+namespace gr {
+
+    namespace howto {
+
+	//! What decimate_fir_cc is asked for (firdes low-pass semantics)
+	struct decim_spec
+	{
+	  int    decim;
+	  double fs, cutoff, trans;
+	  gr::filter::firdes::win_type window;
+	  double beta;
+	};
+
+	/*
+	 * A chain of decimation stages run back to back inside one block, with
+	 * two ping-pong scratch buffers between stages.
+	 */
+	class decim_chain
+	{
+	public:
+	  void clear() { d_stages.clear(); }
+	  void add(const boost::shared_ptr<decim_stage>& s) { d_stages.push_back(s); }
+
+	  int stages() const { return (int)d_stages.size(); }
+	  const decim_stage& stage(int i) const { return *d_stages[i]; }
+
+	  void reset();
+
+	  //! FIR_ACC_* for every stage that uses it
+	  void set_accumulation(int acc)
+	  { for (size_t i = 0; i < d_stages.size(); ++i) d_stages[i]->set_accumulation(acc); }
+
+	  //! nin must be a multiple of the total decimation
+	  int process(const gr_complex* in, int nin, gr_complex* out);
+
+	  //! Product of the stage decimations
+	  int decimation() const;
+
+	  //! decim_stage::memory() of the whole chain, in chain input samples
+	  //! (not rounded to the total decimation)
+	  int memory() const;
+
+	  //! Per output sample of the whole chain
+	  double macs_per_output() const;
+	  double adds_per_output() const;
+	  double cost() const;
+
+	  //! e.g. "CIC(R=8, N=4) -> HB(11 taps) -> FIR(D=4, 97 taps): 41.0 MAC + 72 add / out"
+	  std::string describe() const;
+
+	private:
+	  std::vector<boost::shared_ptr<decim_stage> > d_stages;
+	  std::vector<gr_complex> d_scratch[2];
+	};
+
+	//! Cost of one CIC addition relative to one MAC in decim_chain::cost()
+	static const double DECIM_CIC_ADD_COST = 0.25;
+
+	//! Input headroom of a planned CIC stage: |x| up to 2^16 per rail, so
+	//! full-scale sc16 samples converted to float (+/-32767) go through
+	static const int DECIM_CIC_HEADROOM_BITS = 16;
+
+	//! Stop-band attenuation firdes assumes for each window (dB)
+	double window_attenuation_db(gr::filter::firdes::win_type w, double beta);
+
+	/*!
+	 * The low-pass every FIR stage here is cut from: firdes::low_pass with
+	 * spec's cutoff/transition/window at rate fs (spec.fs is ignored, so
+	 * later stages and polyphase prototypes can pass their own rate).
+	 * Throws std::runtime_error if firdes returns no taps.
+	 */
+	std::vector<float> design_lowpass(const decim_spec& spec, double gain, double fs);
+
+	/*!
+	 * Fills 'chain' with the cheapest plan for 'spec':
+	 *
+	 *   [CIC R, N] -> [half-band] x h -> [FIR D_f]      (R * 2^h * D_f = D)
+	 *
+	 * Every factorization is costed (MACs per output, CIC adds weighted by
+	 * DECIM_CIC_ADD_COST) with the firdes length rules, and only the winner
+	 * is designed. Intermediate stages only keep aliases out of
+	 * [0, cutoff + trans/2]; the last FIR (or half-band, when the cutoff is
+	 * the output Nyquist) sets the requested response. A CIC is only used
+	 * when its aliases meet the window attenuation and its droop at the
+	 * passband edge stays under 0.2 dB and DECIM_CIC_HEADROOM_BITS still
+	 * leave it enough precision. multistage = false gives the classic
+	 * single-FIR design.
+	 */
+	void plan_decimation(const decim_spec& spec, bool multistage, decim_chain& chain);
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_DECIM_PLANNER_H */
@@ -0,0 +1,51 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_DECIM_STAGE_H
+#define INCLUDED_HOWTO_DECIM_STAGE_H
+
+#include <gnuradio/gr_complex.h>
+#include <string>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * One stage of a multi-stage decimator (FIR, half-band, CIC). Each stage
+	 * owns its delay line, so stages chain inside a single block: feeding
+	 * a multiple of decimation() always yields exactly nin / decimation().
+	 */
+	class decim_stage
+	{
+	public:
+	  virtual ~decim_stage() {}
+
+	  virtual int decimation() const = 0;
+
+	  //! nin must be a multiple of decimation(); returns nin / decimation()
+	  virtual int process(const gr_complex* in, int nin, gr_complex* out) = 0;
+
+	  //! Clears the delay line (zeros, as a fresh scheduler history)
+	  virtual void reset() = 0;
+
+	  //! Real multiplies per stage output sample (after folding / zero skipping)
+	  virtual double macs_per_output() const = 0;
+
+	  //! Additions per stage output sample that are not part of a MAC (CIC)
+	  virtual double adds_per_output() const { return 0.0; }
+
+	  virtual std::string describe() const = 0;
+
+	  //! Inputs before the newest one that still reach an output: a reset
+	  //! stage fed at least this many (a multiple of decimation()) carries
+	  //! on exactly as if it had always been running
+	  virtual int memory() const = 0;
+
+	  //! FIR_ACC_* policy for the dot products (fir_fold.h); only the FIR
+	  //! stages are long enough to care, the rest ignore it
+	  virtual void set_accumulation(int /*acc*/) {}
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_DECIM_STAGE_H */
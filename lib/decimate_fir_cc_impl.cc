@@ -3,10 +3,14 @@
 #endif
 
 #include "decimate_fir_cc_impl.h"
+#include "halfband_decim.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/filter/firdes.h>
+#include <gnuradio/logger.h>
+#include <boost/bind.hpp>
 #include <stdexcept>
 #include <algorithm>
+#include <string>
 
 using gr::filter::firdes;
 using std::size_t;
@@ -20,10 +24,12 @@ namespace gr {
 		              double cutoff,
 		              double trans,
 		              int window,
-		              double beta)
+		              double beta,
+		              bool multistage)
 	{
 	  return decimate_fir_cc::sptr(
-	    new decimate_fir_cc_impl(decim, fs, cutoff, trans, static_cast<firdes::win_type>(window), beta)
+	    new decimate_fir_cc_impl(decim, fs, cutoff, trans, static_cast<firdes::win_type>(window), beta,
+		                     multistage)
 	  );
 	}
 
@@ -34,7 +40,8 @@ namespace gr {
 		                                   double cutoff,
 		                                   double trans,
 		                                   firdes::win_type window,
-		                                   double beta)
+		                                   double beta,
+		                                   bool multistage)
 	: gr::block("decimate_fir_cc",
 		    gr::io_signature::make(1, 1, sizeof(gr_complex)),
 		    gr::io_signature::make(1, 1, sizeof(gr_complex))),
@@ -44,74 +51,120 @@ namespace gr {
 	  d_trans(trans),
 	  d_window(window),
 	  d_beta(beta),
-	  d_dirty(true),
-	  d_L(0)
+	  d_multistage(multistage),
+	  d_acc(FIR_ACC_FLOAT),
+	  d_chain_decim(decim),
+	  d_req(0),
+	  d_designed(0),
+	  d_stop(false),
+	  d_keep(0),
+	  d_trimmed(false)
 	{
 	  if (d_decim < 2)     throw std::invalid_argument("decim must be >= 2");
 	  if (d_fs <= 0.0)     throw std::invalid_argument("samp_rate must be > 0");
 	  if (d_cutoff <= 0.0) throw std::invalid_argument("cutoff must be > 0");
 	  if (d_trans <= 0.0)  throw std::invalid_argument("transition must be > 0");
 
-	  // Initial taps + scheduler alignment
+	  // The first plan is designed here (so make() throws on a bad design);
+	  // the stages start from zeros like a fresh delay line and the block
+	  // keeps history(1) for good.
+	  d_chain.reset(new decim_chain);
+	  plan_decimation(spec_locked(), d_multistage, *d_chain);
+	  d_keep = d_chain->memory();
+	  this->set_relative_rate(1.0 / static_cast<double>(d_decim));
+
+	  d_designer.reset(new gr::thread::thread(
+	      boost::bind(&decimate_fir_cc_impl::designer_, this)));
+	}
+
+	decimate_fir_cc_impl::~decimate_fir_cc_impl()
+	{
 	  {
 	    boost::lock_guard<boost::mutex> lk(d_mutex);
-	    design_taps_locked();
-	    apply_new_config_locked();
+	    d_stop = true;
 	  }
+	  d_wake.notify_all();
+	  d_designer->join();
 	}
 
-	void decimate_fir_cc_impl::design_taps_locked()
+	decim_spec decimate_fir_cc_impl::spec_locked() const
 	{
-	  // Gain=1.0. firdes::low_pass expects absolute Hz when fs provided.
-	  // If window is Kaiser, beta must be set; otherwise beta is ignored.
-	  d_taps = firdes::low_pass(1.0f,            // gain
-		                    static_cast<float>(d_fs),
-		                    static_cast<float>(d_cutoff),
-		                    static_cast<float>(d_trans),
-		                    d_window,
-		                    static_cast<float>(d_beta));
-	  if (d_taps.empty())
-	    throw std::runtime_error("firdes::low_pass returned empty taps");
+	  const decim_spec spec = { d_decim, d_fs, d_cutoff, d_trans, d_window, d_beta };
+	  return spec;
+	}
 
-	  d_L = d_taps.size();
+	void decimate_fir_cc_impl::request_design_locked()
+	{
+	  ++d_req;
+	  d_wake.notify_one();
 	}
 
-	void decimate_fir_cc_impl::apply_new_config_locked()
+	// Runs plan_decimation() (firdes, the planner's costing) off the
+	// streaming thread; work() picks the result up from d_pending. A design
+	// that fails is logged here and the plan in use stays.
+	void decimate_fir_cc_impl::designer_()
 	{
-	  // History = L to access last L samples per output
-	  this->set_history(static_cast<int>(d_L));
-	  // Relative rate is 1/D
-	  this->set_relative_rate(1.0 / static_cast<double>(d_decim));
-	  d_dirty = false;
+	  for (;;) {
+	    decim_spec spec;
+	    bool ms;
+	    unsigned req;
+	    {
+	      boost::unique_lock<boost::mutex> lk(d_mutex);
+	      while (d_req == d_designed && !d_stop) d_wake.wait(lk);
+	      if (d_stop) return;
+	      req = d_req;
+	      spec = spec_locked();
+	      ms = d_multistage;
+	    }
+
+	    chain_sptr c(new decim_chain);
+	    std::string err;
+	    try {
+	      plan_decimation(spec, ms, *c);
+	    }
+	    catch (const std::exception& e) {
+	      err = e.what();
+	    }
+
+	    {
+	      boost::lock_guard<boost::mutex> lk(d_mutex);
+	      d_designed = req;
+	      if (req != d_req) continue;    // settings moved on meanwhile: redesign
+	      if (err.empty()) d_pending = c;
+	      else             d_pending.reset();  // an older design is stale too
+	    }
+	    if (!err.empty())
+	      GR_LOG_ERROR(d_logger, "redesign failed, keeping the current plan: " + err);
+	  }
 	}
 
-	// ---- setters: cheap, just mark dirty ----
+	// ---- setters: cheap, the designer thread does the rest ----
 	void decimate_fir_cc_impl::set_decimation(int decim)
 	{
 	  if (decim < 2) throw std::invalid_argument("decim must be >= 2");
 	  boost::lock_guard<boost::mutex> lk(d_mutex);
-	  if (decim != d_decim) { d_decim = decim; d_dirty = true; }
+	  if (decim != d_decim) { d_decim = decim; request_design_locked(); }
 	}
 
 	void decimate_fir_cc_impl::set_samp_rate(double fs)
 	{
 	  if (fs <= 0.0) throw std::invalid_argument("samp_rate must be > 0");
 	  boost::lock_guard<boost::mutex> lk(d_mutex);
-	  if (fs != d_fs) { d_fs = fs; d_dirty = true; }
+	  if (fs != d_fs) { d_fs = fs; request_design_locked(); }
 	}
 
 	void decimate_fir_cc_impl::set_cutoff(double fc)
 	{
 	  if (fc <= 0.0) throw std::invalid_argument("cutoff must be > 0");
 	  boost::lock_guard<boost::mutex> lk(d_mutex);
-	  if (fc != d_cutoff) { d_cutoff = fc; d_dirty = true; }
+	  if (fc != d_cutoff) { d_cutoff = fc; request_design_locked(); }
 	}
 
 	void decimate_fir_cc_impl::set_transition(double tw)
 	{
 	  if (tw <= 0.0) throw std::invalid_argument("transition must be > 0");
 	  boost::lock_guard<boost::mutex> lk(d_mutex);
-	  if (tw != d_trans) { d_trans = tw; d_dirty = true; }
+	  if (tw != d_trans) { d_trans = tw; request_design_locked(); }
 	}
 	
 	static bool is_valid_window(int w) {
@@ -133,24 +186,128 @@ namespace gr {
 	  boost::lock_guard<boost::mutex> lk(d_mutex);
           if (!is_valid_window(w)) throw std::invalid_argument("invalid firdes window id");
 	  firdes::win_type neww = static_cast<firdes::win_type>(w);
-	  if (neww != d_window) { d_window = neww; d_dirty = true; }
+	  if (neww != d_window) { d_window = neww; request_design_locked(); }
 	}
 
 	void decimate_fir_cc_impl::set_kaiser_beta(double beta)
 	{
 	  boost::lock_guard<boost::mutex> lk(d_mutex);
-	  if (beta != d_beta) { d_beta = beta; d_dirty = true; }
+	  if (beta != d_beta) { d_beta = beta; request_design_locked(); }
+	}
+
+	void decimate_fir_cc_impl::set_multistage(bool on)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (on != d_multistage) { d_multistage = on; request_design_locked(); }
+	}
+
+	void decimate_fir_cc_impl::set_accumulation(int acc)
+	{
+	  if (acc < FIR_ACC_FLOAT || acc > FIR_ACC_DOUBLE)
+	    throw std::invalid_argument("accumulation must be 0 (float), 1 (split) or 2 (double)");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  d_acc = acc;
+	}
+
+	int decimate_fir_cc_impl::accumulation() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_acc;
+	}
+
+	bool decimate_fir_cc_impl::multistage() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_multistage;
+	}
+
+	// Plan queries reflect the plan in use: a retune shows up once work()
+	// has swapped it in
+	int decimate_fir_cc_impl::halfband_stages() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  int n = 0;
+	  for (int i = 0; i < d_chain->stages(); ++i)
+	    if (dynamic_cast<const halfband_stage*>(&d_chain->stage(i))) ++n;
+	  return n;
+	}
+
+	std::string decimate_fir_cc_impl::plan() const
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_chain->describe();
+	}
+
+	double decimate_fir_cc_impl::macs_per_output() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_chain->macs_per_output();
+	}
+
+	// ---- history and plan swaps (work() thread only) ----
+
+	void decimate_fir_cc_impl::remember_(const gr_complex* in, int n)
+	{
+	  const size_t un = static_cast<size_t>(n);
+	  if (un >= d_keep) {
+	    d_trimmed = d_trimmed || !d_raw.empty() || un > d_keep;
+	    d_raw.assign(in + (un - d_keep), in + un);
+	    return;
+	  }
+	  d_raw.insert(d_raw.end(), in, in + un);
+	  // trim in batches rather than shifting on every call
+	  if (d_raw.size() > 2 * d_keep) {
+	    d_raw.erase(d_raw.begin(), d_raw.end() - d_keep);
+	    d_trimmed = true;
+	  }
+	}
+
+	// The swap happens between two work() calls, i.e. right after an output
+	// of the old plan (consumed input is a multiple of its D). The new plan
+	// first filters the last W inputs (W >= its memory, a multiple of its D)
+	// and drops those outputs: its delay lines then hold exactly what they
+	// would had it been running all along, and its next output has the
+	// next input as its newest sample, so no sample is dropped, repeated
+	// or filtered against zeros. If d_raw is short (the new plan is longer
+	// than anything kept so far) the old plan keeps running until it is not.
+	bool decimate_fir_cc_impl::swap_in_(const chain_sptr& next, int acc)
+	{
+	  const int    Dn = next->decimation();
+	  const size_t W  = static_cast<size_t>((next->memory() + Dn - 1) / Dn) * Dn;
+	  d_keep = std::max(d_keep, W);
+	  if (d_raw.size() < W) {
+	    if (d_trimmed) return false;
+	    // nothing lost yet: the stream is preceded by zeros
+	    d_raw.insert(d_raw.begin(), W - d_raw.size(), gr_complex(0.0f, 0.0f));
+	  }
+
+	  next->set_accumulation(acc);
+	  if (W > 0) {
+	    d_prime.resize(W / Dn);
+	    next->process(&d_raw[d_raw.size() - W], static_cast<int>(W), &d_prime[0]);
+	  }
+
+	  {
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    d_chain = next;
+	    d_chain_decim = Dn;
+	    if (d_pending == next) d_pending.reset();
+	  }
+	  d_keep = W;
+	  this->set_relative_rate(1.0 / static_cast<double>(Dn));
+	  return true;
 	}
 
 	// ---- scheduler functions ----
 
 	void decimate_fir_cc_impl::forecast (int noutput_items, gr_vector_int &ninput_items_required)
 	{
-	  // Need D samples per output plus history(L)-1 already accounted by scheduler.
+	  // D samples per output of the plan in use; history(1), the stages
+	  // keep their own state
 	  int D = 0;
 	  {
 	    boost::lock_guard<boost::mutex> lk(d_mutex);
-	    D = d_decim;
+	    D = d_chain_decim;
 	  }
 	  ninput_items_required[0] = std::max(D * noutput_items, D);
 	}
@@ -163,55 +320,32 @@ namespace gr {
 	  const gr_complex* in  = static_cast<const gr_complex*>(input_items[0]);
 	  gr_complex*       out = static_cast<gr_complex*>(output_items[0]);
 
-	  // Snapshot config without holding the lock during the hot loop
-	  int    D;      // decimation
-	  size_t L;      // taps length
-	  std::vector<float> taps;
-	  bool need_realign = false;
-
+	  // Snapshot without holding the lock during the hot loop
+	  chain_sptr chain, next;
+	  int D, acc;
 	  {
 	    boost::lock_guard<boost::mutex> lk(d_mutex);
-	    if (d_dirty) {
-	      // Recompute taps and sync scheduler contract
-	      design_taps_locked();
-	      apply_new_config_locked();
-	      // Force scheduler to realign buffers with new history/rate
-	      return 0;
-	    }
-	    D = d_decim;
-	    L = d_L;
-	    taps = d_taps; // local copy to avoid shared access in loop
+	    chain = d_chain;
+	    next = d_pending;
+	    D = d_chain_decim;
+	    acc = d_acc;
 	  }
 
-	  // With set_history(L), the input pointer includes L-1 prior samples.
-	  // Valid outputs limited by available inputs:
-	  // usable_inputs = ninput_items[0]; but first (L-1) are history.
-	  // We can produce at most floor((ninput_items[0] - (L - 1)) / D)
-	  const int max_out = static_cast<int>((ninput_items[0] - static_cast<int>(L) + 1) / D);
-	  const int nout = std::max(0, std::min(noutput_items, max_out));
-	  if (nout <= 0) {
-	    // Ask for more input
-	    return 0;
+	  if (next && swap_in_(next, acc)) {
+	    chain = next;
+	    D = next->decimation();
 	  }
 
-	  // Base points to the "current" sample including history.
-	  // For each output j, align to p = in + (L-1) + j*D, then convolve backwards.
-	  const gr_complex* base = in + (L - 1);
-	  for (int j = 0; j < nout; ++j) {
-	    const gr_complex* p = base + j * D;
-	    gr_complex acc(0.0f, 0.0f);
-	    // Manual dot-product: y[n] = sum_{k=0..L-1} taps[k] * x[n - k]
-	    for (size_t k = 0; k < L; ++k) {
-	      acc += static_cast<float>(taps[k]) * p[-static_cast<int>(k)];
-	    }
-	    out[j] = acc;
-	  }
+	  const int nout = std::min(noutput_items, ninput_items[0] / D);
+	  if (nout <= 0) return 0;
+
+	  // only this thread runs the chain, so its stages are safe to touch here
+	  chain->set_accumulation(acc);
+	  chain->process(in, nout * D, out);
+	  remember_(in, nout * D);
 
-	  // Consume exactly D per output produced
 	  consume_each(nout * D);
 	  return nout;
 	}
 
 }} // namespace gr::howto
-
-
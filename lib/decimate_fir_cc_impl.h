@@ -2,7 +2,13 @@
 #define INCLUDED_HOWTO_DECIMATE_FIR_CC_IMPL_H
 
 #include <howto/decimate_fir_cc.h>
+#include "fir_fold.h"
+#include "decim_planner.h"
+#include <gnuradio/thread/thread.h>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <vector>
 
 #include <gnuradio/filter/firdes.h>
@@ -23,15 +29,36 @@ namespace gr {
 	  double d_trans;
 	  firdes::win_type d_window;
 	  double d_beta;
+	  bool   d_multistage;
+	  int    d_acc;      // FIR_ACC_* (fir_fold.h)
 
-	  // FIR taps (float for firdes), copied locally when updated
-	  std::vector<float> d_taps;
-	  bool   d_dirty;    // taps or decim changed
-	  size_t d_L;        // taps length snapshot
+	  // Plans (pointers guarded by d_mutex). Only work() runs d_chain; the
+	  // designer thread builds d_pending, work() primes and swaps it in.
+	  typedef boost::shared_ptr<decim_chain> chain_sptr;
+	  chain_sptr d_chain;    // plan in use
+	  chain_sptr d_pending;  // designed, not applied yet
+	  int    d_chain_decim;  // total decimation of d_chain
+
+	  // Designer thread: redesigns when d_req moves past d_designed
+	  boost::scoped_ptr<gr::thread::thread> d_designer;
+	  boost::condition_variable d_wake;
+	  unsigned d_req;
+	  unsigned d_designed;
+	  bool   d_stop;
+
+	  // Last inputs consumed (work() thread only), oldest first; primes a
+	  // new plan so it starts with its delay lines full
+	  std::vector<gr_complex> d_raw;
+	  std::vector<gr_complex> d_prime;   // discarded priming outputs
+	  size_t d_keep;     // inputs d_raw has to cover
+	  bool   d_trimmed;  // d_raw lost samples (else zeros precede it)
 
 	  // Internal helpers
-	  void   design_taps_locked();   // assumes d_mutex locked
-	  void   apply_new_config_locked(); // set_history + set_relative_rate + L cache
+	  decim_spec spec_locked() const;      // assumes d_mutex locked
+	  void   request_design_locked();      // ditto
+	  void   designer_();
+	  bool   swap_in_(const chain_sptr& next, int acc);
+	  void   remember_(const gr_complex* in, int n);
 
 	public:
 	  // Ctor/Dtor
@@ -40,9 +67,10 @@ namespace gr {
 		               double cutoff,
 		               double trans,
 		               firdes::win_type d_window,   
-		               double beta); /* may throw */
+		               double beta,
+		               bool multistage); /* may throw */
 
-	  ~decimate_fir_cc_impl() override = default;
+	  ~decimate_fir_cc_impl() override;
 
 	  // Queries
 	  int    decimation()  const noexcept override { return d_decim; }
@@ -51,14 +79,21 @@ namespace gr {
 	  double transition()  const noexcept override { return d_trans; }
 	  int    window()      const noexcept override { return static_cast<int>(d_window); } // getter sigue devolviendo int
 	  double kaiser_beta() const noexcept override { return d_beta; }
+	  int    halfband_stages() const noexcept override;
+	  bool   multistage()  const noexcept override;
+	  std::string plan() const override;
+	  double macs_per_output() const noexcept override;
 
-	  // Setters (mark dirty, cheap)
+	  // Setters (wake the designer, cheap)
 	  void set_decimation(int decim) override;
 	  void set_samp_rate(double fs) override;
 	  void set_cutoff(double fc) override;
 	  void set_transition(double tw) override;
 	  void set_window(int w) override;
 	  void set_kaiser_beta(double beta) override;
+	  void set_multistage(bool on) override;
+	  void set_accumulation(int acc) override;
+	  int  accumulation() const noexcept override;
 
 	  // GNURadio API
 	  void forecast (int noutput_items, gr_vector_int &ninput_items_required) override;
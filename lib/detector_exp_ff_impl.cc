@@ -23,49 +23,96 @@
 #endif
 
 #include "detector_exp_ff_impl.h"
+#include "threshold_scan.h"
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace gr {
   namespace howto {
 
     // Factory
-    detector_exp_ff::sptr detector_exp_ff::make(int length)
+    detector_exp_ff::sptr detector_exp_ff::make(int length, int decay_length)
     {
-      return gnuradio::get_initial_sptr(new detector_exp_ff_impl(length));
+      return gnuradio::get_initial_sptr(new detector_exp_ff_impl(length, decay_length));
     }
 
     // Constructor
-    detector_exp_ff_impl::detector_exp_ff_impl(int length)
+    detector_exp_ff_impl::detector_exp_ff_impl(int length, int decay_length)
       : gr::sync_block("detector_exp_ff",
           gr::io_signature::make(1, 1, sizeof(float)),   // in
           gr::io_signature::make(2, 2, sizeof(float)))   // out, env
       , d_length(std::max(1, length))
+      , d_decay_length(std::max(0, decay_length))
       , d_env(0.0f)
-      , d_alpha(0.95f)
+      , d_alpha(0.0f)
+      , d_alpha_decay(0.0f)
       , d_Ton(0.20f)
       , d_Toff(0.10f)
       , d_state(false)
     {
+      update_alphas_locked();
+
       // One message port for START/STOP
       message_port_register_out(pmt::mp("state_msg"));
 
-      // If strict alignment via history is desired, enable:
-      // set_history(d_length);
+      // Input tags reach 'out' and 'env' through the runtime's own propagation
+      // (1:1 rate, no copies in work()); we only add our event tags.
+      set_tag_propagation_policy(TPP_ALL_TO_ALL);
+
+      // No set_history(): the envelope is recursive, so history() stays 1 and
+      // 'out'/'env' remain sample-aligned with the input (tag offsets map 1:1).
+      // Changing the length only changes alpha; no scheduler realign is needed.
     }
 
     // Destructor
     detector_exp_ff_impl::~detector_exp_ff_impl() = default;
 
-    // Controls
+    // Time constant N samples -> alpha = exp(-1/N) (1/e step response after N samples)
+    float detector_exp_ff_impl::alpha_from_length(int n) noexcept
+    {
+      return std::exp(-1.0f / static_cast<float>(std::max(1, n)));
+    }
+
+    void detector_exp_ff_impl::update_alphas_locked() noexcept
+    {
+      d_alpha       = alpha_from_length(d_length);
+      d_alpha_decay = d_decay_length > 0 ? alpha_from_length(d_decay_length) : d_alpha;
+    }
+
+    // Controls (alpha is derived here, never in work())
     void detector_exp_ff_impl::set_length(int n) noexcept
     {
       boost::mutex::scoped_lock lk(d_mtx);
       d_length = std::max(1, n);
-      // If using history: consider realignment when length changes.
-      // if (d_length != history()) { set_history(d_length); }
+      update_alphas_locked();
+    }
+
+    void detector_exp_ff_impl::set_decay_length(int n) noexcept
+    {
+      boost::mutex::scoped_lock lk(d_mtx);
+      d_decay_length = std::max(0, n);
+      update_alphas_locked();
+    }
+
+    int detector_exp_ff_impl::length() const noexcept
+    {
+      boost::mutex::scoped_lock lk(d_mtx);
+      return d_length;
+    }
+
+    int detector_exp_ff_impl::decay_length() const noexcept
+    {
+      boost::mutex::scoped_lock lk(d_mtx);
+      return d_decay_length;
+    }
+
+    float detector_exp_ff_impl::alpha() const noexcept
+    {
+      boost::mutex::scoped_lock lk(d_mtx);
+      return d_alpha;
     }
 
     void detector_exp_ff_impl::set_Ton(float t) noexcept
@@ -107,23 +154,6 @@ namespace gr {
       add_item_tag(out_port, abs_off, key_env,   val_env);
     }
 
-    // Propagate input tags to 'out' (port 0) preserving offsets
-    void detector_exp_ff_impl::passthrough_tags(uint64_t abs_read,
-                                                uint64_t abs_write,
-                                                int noutput_items) noexcept
-    {
-      std::vector<tag_t> tags;
-      const uint64_t beg = abs_read;
-      const uint64_t end = abs_read + static_cast<uint64_t>(noutput_items);
-      get_tags_in_range(tags, 0, beg, end);
-
-      for (size_t k = 0; k < tags.size(); ++k) {
-        const uint64_t rel = tags[k].offset - beg;
-        const uint64_t dst = abs_write + rel;
-        add_item_tag(0, dst, tags[k].key, tags[k].value);
-      }
-    }
-
     // work()
     int detector_exp_ff_impl::work(int noutput_items,
                                   gr_vector_const_void_star &input_items,
@@ -134,42 +164,57 @@ namespace gr {
       float* out_env   = static_cast<float*>(output_items[1]); // d_env
 
       // Snapshot params
-      float Ton, Toff, alpha;
+      float Ton, Toff, alpha, alpha_dec;
       {
         boost::mutex::scoped_lock lk(d_mtx);
-        Ton   = d_Ton;
-        Toff  = d_Toff;
-        alpha = d_alpha;
+        Ton       = d_Ton;
+        Toff      = d_Toff;
+        alpha     = d_alpha;
+        alpha_dec = d_alpha_decay;
       }
 
-      const uint64_t abs_read  = nitems_read(0);
       const uint64_t abs_write = nitems_written(0);
 
-      // Tag passthrough from input to 'out'
-      passthrough_tags(abs_read, abs_write, noutput_items);
-
-      for (int i = 0; i < noutput_items; ++i) {
-        // 1) Passthrough
-        const float x = in[i];
-        out_sig[i] = x;
-
-        // 2) Exponential energy envelope
-        const float x2 = x * x;
-        d_env = alpha * d_env + (1.0f - alpha) * x2;
-        out_env[i] = d_env;
-
-        // 3) Hysteresis events and annotations at sample offset
-        const uint64_t abs_off = abs_write + static_cast<uint64_t>(i);
-        if (!d_state && d_env >= Ton) {
-          d_state = true;
-          publish_event("START", abs_off, d_env);
-          tag_event(0, abs_off, "START", d_env); // tag on 'out'
-        } else if (d_state && d_env <= Toff) {
-          d_state = false;
-          publish_event("STOP", abs_off, d_env);
-          tag_event(0, abs_off, "STOP", d_env); // tag on 'out'
+      // 1) Passthrough
+      std::memcpy(out_sig, in, sizeof(float) * noutput_items);
+
+      // 2) Exponential energy envelope for the whole chunk (written straight to 'env')
+      float env = d_env;
+      if (alpha_dec == alpha) {
+        const float beta = 1.0f - alpha;
+        for (int i = 0; i < noutput_items; ++i) {
+          const float x = in[i];
+          env = alpha * env + beta * (x * x);
+          out_env[i] = env;
+        }
+      } else {
+        // Dual-rate: attack coefficient while rising, decay coefficient while falling
+        for (int i = 0; i < noutput_items; ++i) {
+          const float x2 = in[i] * in[i];
+          const float a  = (x2 > env) ? alpha : alpha_dec;
+          env = x2 + a * (env - x2);
+          out_env[i] = env;
         }
       }
+      d_env = env;
+
+      // 3) Hysteresis events: jump from crossing to crossing, annotate at sample offset
+      int i = 0;
+      while (i < noutput_items) {
+        const int n = noutput_items - i;
+        const int j = d_state
+          ? i + scan_first<SCAN_LE>(out_env + i, n, Toff)   // STOP  when env <= Toff
+          : i + scan_first<SCAN_GE>(out_env + i, n, Ton);   // START when env >= Ton
+        if (j >= noutput_items)
+          break;
+
+        d_state = !d_state;
+        const char* ev = d_state ? "START" : "STOP";
+        const uint64_t abs_off = abs_write + static_cast<uint64_t>(j);
+        publish_event(ev, abs_off, out_env[j]);
+        tag_event(0, abs_off, ev, out_env[j]); // tag on 'out'
+        i = j + 1;
+      }
 
       return noutput_items;
     }
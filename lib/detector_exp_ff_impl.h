@@ -34,29 +34,36 @@ namespace gr {
     class detector_exp_ff_impl final : public detector_exp_ff
     {
     private:
-      int   d_length;   //!< kept for priming/compatibility
-      float d_env;      //!< exponential envelope
-      float d_alpha;    //!< smoothing factor (0<alpha<1)
+      int   d_length;       //!< time constant (samples); attack when dual-rate
+      int   d_decay_length; //!< decay time constant (samples); 0 = single-rate
+      float d_env;          //!< exponential envelope
+      float d_alpha;        //!< smoothing factor from d_length (0<alpha<1)
+      float d_alpha_decay;  //!< smoothing factor while falling (== d_alpha if single-rate)
       float d_Ton;      //!< threshold ON
       float d_Toff;     //!< threshold OFF
       bool  d_state;    //!< current state (true = active)
-      boost::mutex d_mtx;
+      mutable boost::mutex d_mtx;
+
+      static float alpha_from_length(int n) noexcept;
+      void update_alphas_locked() noexcept;   // assumes d_mtx locked
 
       void publish_event(const char* ev, uint64_t idx, float env) noexcept;
       void tag_event(int out_port, uint64_t abs_off,
                     const char* ev, float env) noexcept;
-      void passthrough_tags(uint64_t abs_read,
-                            uint64_t abs_write,
-                            int noutput_items) noexcept;
 
     public:
-      explicit detector_exp_ff_impl(int length);
+      detector_exp_ff_impl(int length, int decay_length);
       ~detector_exp_ff_impl() override;
 
       void set_length(int n) noexcept override;
+      void set_decay_length(int n) noexcept override;
       void set_Ton(float t) noexcept override;
       void set_Toff(float t) noexcept override;
 
+      int   length() const noexcept override;
+      int   decay_length() const noexcept override;
+      float alpha() const noexcept override;
+
       int work(int noutput_items,
               gr_vector_const_void_star &input_items,
               gr_vector_void_star &output_items) override;
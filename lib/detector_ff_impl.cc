@@ -23,9 +23,11 @@
 #endif
 
 #include "detector_ff_impl.h"
+#include "threshold_scan.h"
 #include <gnuradio/io_signature.h>
 #include <boost/thread/lock_guard.hpp>
 #include <algorithm>
+#include <cstring>
 
 
 namespace gr { 
@@ -67,13 +69,13 @@ namespace gr {
     detector_ff_impl::~detector_ff_impl() {}
 
     // ---------- Publish PMT event ----------
-    void detector_ff_impl::publish_event(bool start, double level)
+    void detector_ff_impl::publish_event(bool start, double level, uint64_t count)
     {
       // Build dictionary: {event: START/STOP, level: <avg>, count: <processed_samples>}
       pmt::pmt_t m = pmt::make_dict();
       m = pmt::dict_add(m, k_event, start ? v_START : v_STOP);
       m = pmt::dict_add(m, k_level, pmt::from_double(level));
-      m = pmt::dict_add(m, pmt::intern("count"), pmt::from_uint64(d_count));
+      m = pmt::dict_add(m, pmt::intern("count"), pmt::from_uint64(count));
 
       // Publish the message on the "out" port
       message_port_pub(pmt::mp("out_sms"), m);
@@ -112,49 +114,57 @@ namespace gr {
         d_primed = false;
       }
 
-      // Process samples
-      for (int i = 0; i < noutput_items; ++i) {
-        // Pass-through: copy input to output
-        out[i] = in[i];
+      // Pass-through: copy input to output
+      std::memcpy(out, in, sizeof(float) * noutput_items);
 
-        // Rolling average update in O(1)
+      // Phase 1: rolling average for the whole chunk, O(1) per sample
+      if ((int)d_avg.size() < noutput_items)
+        d_avg.resize(noutput_items);
+      double *avg = &d_avg[0];
+      const double dwin = (double)win;
+      for (int i = 0; i < noutput_items; ++i) {
         float p = in[i];                // sample value (assumed power)
         float old = d_buf[d_head];      // value leaving the window
         d_sum += (double)p - (double)old;
         d_buf[d_head] = p;              // store new sample in circular buffer
-        d_head = (d_head + 1) % win;    // advance head index
-
-        // Warm-up: wait until window filled before any detection
-        if (!d_primed) {
-          if (d_count + 1 >= (uint64_t)win)
-            d_primed = true;
-          d_count++;
-          continue; // skip detection until primed
-        }
-
-        // Compute mean power over the window
-        double avg = d_sum / (double)win;
+        if (++d_head == win) d_head = 0;
+        avg[i] = d_sum / dwin;          // kept in double: compared and reported as is
+      }
 
-        // Hysteresis-based detection
-        if (d_state == IDLE && avg > thrH) {
-          // Transition to ACTIVE: signal detected (START)
-          d_state = ACTIVE;
-          uint64_t abs_off = nitems_written(0) + i; // absolute output item index
-          add_event_tag(abs_off, true);             // tag: event=START at exact sample
-          publish_event(true, avg);                 // PMT message: START with current avg
-        }
-        else if (d_state == ACTIVE && avg < thrL) {
-          // Transition to IDLE: signal gone (STOP)
-          d_state = IDLE;
-          uint64_t abs_off = nitems_written(0) + i;
-          add_event_tag(abs_off, false);            // tag: event=STOP
-          publish_event(false, avg);                // PMT message: STOP with current avg
+      // Warm-up: the sample that fills the window primes the detector,
+      // detection starts on the one after it.
+      int first = 0;
+      if (!d_primed) {
+        const uint64_t left = (d_count + 1 >= (uint64_t)win) ? 0 : (uint64_t)win - 1 - d_count;
+        if (left >= (uint64_t)noutput_items) {
+          d_count += noutput_items;
+          return noutput_items;         // still filling the window
         }
+        d_primed = true;
+        first = (int)left + 1;
+      }
 
-        // Global processed sample counter (used in 'count' field)
-        d_count++;
+      // Phase 2: jump straight to the next threshold crossing (hysteresis)
+      const uint64_t abs_base = nitems_written(0);
+      int i = first;
+      while (i < noutput_items) {
+        const bool start = (d_state == IDLE);
+        const int j = start
+          ? i + scan_first<SCAN_GT>(avg + i, noutput_items - i, (double)thrH)  // avg > thrH
+          : i + scan_first<SCAN_LT>(avg + i, noutput_items - i, (double)thrL); // avg < thrL
+        if (j >= noutput_items)
+          break;
+
+        // Transition: START (IDLE -> ACTIVE) or STOP (ACTIVE -> IDLE)
+        d_state = start ? ACTIVE : IDLE;
+        add_event_tag(abs_base + j, start);                 // tag at exact sample
+        publish_event(start, avg[j], d_count + j);          // PMT message with current avg
+        i = j + 1;
       }
 
+      // Global processed sample counter (used in 'count' field)
+      d_count += noutput_items;
+
       return noutput_items; // produced same number as requested (sync_block)
     }
 
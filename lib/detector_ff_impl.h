@@ -35,6 +35,7 @@ namespace gr {
   *  - Thresholds: d_thr_high (high detect), d_thr_low (low detect)
   *  - Window: d_win (moving-average length)
   *  - Rolling state: d_buf (circular), d_head (index), d_sum (sum), d_primed (window filled)
+  *  - Scratch: d_avg (per-chunk moving-average array scanned for crossings)
   *  - Counters: d_count (total processed samples)
   *  - FSM: d_state (IDLE/ACTIVE)
   *  - PMT keys/symbols: k_event, k_level, v_START, v_STOP
@@ -56,6 +57,7 @@ namespace gr {
         bool  d_primed;             // true once at least d_win samples have been seen
         double d_sum;               // running sum of samples inside the window
         uint64_t d_count;           // total processed samples since start (monotonic)
+        std::vector<double> d_avg;  // per-chunk moving average, reused across work() calls
 
         // -------- Finite state machine --------
         enum state_t { IDLE = 0, ACTIVE = 1 };
@@ -68,7 +70,8 @@ namespace gr {
         pmt::pmt_t v_STOP;          // PMT value symbol: "STOP"
 
         // -------- Helpers --------
-        void publish_event(bool start, double level);          // publish PMT dict event on port "out"
+        void publish_event(bool start, double level,
+                           uint64_t count);                    // publish PMT dict event on port "out"
         void add_event_tag(uint64_t abs_off, bool start);      // insert stream tag at absolute offset
 
       public:
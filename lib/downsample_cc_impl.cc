@@ -1,25 +1,79 @@
 #include "downsample_cc_impl.h"
 #include <gnuradio/gr_complex.h>
+#include <gnuradio/io_signature.h>
 #include <stdexcept>
 
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
 namespace gr { namespace howto {
 
-downsample_cc::sptr downsample_cc::make(int decim)
+downsample_cc::sptr downsample_cc::make(int decim, int phase, bool commutator)
 {
   if (decim < 2)
     throw std::invalid_argument("decimation must be >= 2");
+  if (phase < 0 || phase >= decim)
+    throw std::invalid_argument("phase must be in 0..decimation-1");
 
-  return downsample_cc::sptr(new downsample_cc_impl(decim));
+  return downsample_cc::sptr(new downsample_cc_impl(decim, phase, commutator));
 }
 
-downsample_cc_impl::downsample_cc_impl(int decim)
+downsample_cc_impl::downsample_cc_impl(int decim, int phase, bool commutator)
 : gr::sync_decimator("downsample_cc",
                      gr::io_signature::make(1, 1, sizeof(gr_complex)),
-                     gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                     gr::io_signature::make(commutator ? decim : 1,
+                                            commutator ? decim : 1, sizeof(gr_complex)),
                      decim),
-  d_decim(decim)
+  d_decim(decim),
+  d_commutator(commutator),
+  d_phase(phase),
+  d_outs(commutator ? decim : 0)
+{
+  // No filtering, no history: every output comes from its own group of D.
+}
+
+int downsample_cc_impl::phase() const
+{
+  boost::lock_guard<boost::mutex> lk(d_mutex);
+  return d_phase;
+}
+
+void downsample_cc_impl::set_phase(int phase)
 {
-  // No filtering, no history. Pure pick-every-D behavior.
+  if (phase < 0 || phase >= d_decim)
+    throw std::invalid_argument("phase must be in 0..decimation-1");
+  boost::lock_guard<boost::mutex> lk(d_mutex);
+  d_phase = phase;
+}
+
+// out[j][n] = in[n*D + j] for every phase j, one pass over the input.
+// Two groups at a time: phases j, j+1 of groups n, n+1 are a 2x2 matrix
+// of complex samples (64 bits each), which movelh/movehl transpose.
+static void deinterleave_(const gr_complex* in, int D, int nout, gr_complex* const* out)
+{
+  int n = 0;
+#if defined(__SSE__)
+  for (; n + 2 <= nout; n += 2) {
+    const float* a = reinterpret_cast<const float*>(in + n * D);   // group n
+    const float* b = a + 2 * D;                                    // group n+1
+    int j = 0;
+    for (; j + 2 <= D; j += 2) {
+      const __m128 u = _mm_loadu_ps(a + 2 * j);     // a_j  a_j+1
+      const __m128 v = _mm_loadu_ps(b + 2 * j);     // b_j  b_j+1
+      _mm_storeu_ps(reinterpret_cast<float*>(out[j] + n), _mm_movelh_ps(u, v));
+      _mm_storeu_ps(reinterpret_cast<float*>(out[j + 1] + n), _mm_movehl_ps(v, u));
+    }
+    if (j < D) {                                    // odd D: last phase alone
+      __m128 w = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(a + 2 * j));
+      w = _mm_loadh_pi(w, reinterpret_cast<const __m64*>(b + 2 * j));
+      _mm_storeu_ps(reinterpret_cast<float*>(out[j] + n), w);
+    }
+  }
+#endif
+  for (; n < nout; ++n)
+    for (int j = 0; j < D; ++j)
+      out[j][n] = in[n * D + j];
 }
 
 int downsample_cc_impl::work(int noutput_items,
@@ -27,14 +81,27 @@ int downsample_cc_impl::work(int noutput_items,
                              gr_vector_void_star &output_items)
 {
   const gr_complex *in = static_cast<const gr_complex*>(input_items[0]);
-  gr_complex *out = static_cast<gr_complex*>(output_items[0]);
 
   const int D = d_decim;
+  int p;
+  {
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    p = d_phase;
+  }
+
+  if (d_commutator) {
+    // phase j goes to port (j - p) mod D
+    for (int j = 0; j < D; ++j)
+      d_outs[j] = static_cast<gr_complex*>(output_items[(j - p + D) % D]);
+    deinterleave_(in, D, noutput_items, &d_outs[0]);
+    return noutput_items;
+  }
+
+  gr_complex *out = static_cast<gr_complex*>(output_items[0]);
   for (int i = 0; i < noutput_items; ++i)
-    out[i] = in[i * D];
+    out[i] = in[i * D + p];
 
   return noutput_items;
 }
 
 }} // namespace gr::howto
-
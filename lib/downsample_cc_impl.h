@@ -2,23 +2,34 @@
 #define INCLUDED_HOWTO_DOWNSAMPLE_CC_IMPL_H
 
 #include <howto/downsample_cc.h>
+#include <boost/thread/mutex.hpp>
+#include <vector>
 
 namespace gr { namespace howto {
 
 /*!
  * \brief Implementation of the trivial complex decimator.
- * \note D is fixed at construction time.
+ * \note D (and the number of outputs) is fixed at construction time.
  */
 class downsample_cc_impl final : public downsample_cc
 {
 private:
   const int d_decim;
+  const bool d_commutator;
+
+  mutable boost::mutex d_mutex;
+  int d_phase;
+
+  std::vector<gr_complex*> d_outs;   // per phase (commutator), work() only
 
 public:
-  explicit downsample_cc_impl(int decim);
+  downsample_cc_impl(int decim, int phase, bool commutator);
   ~downsample_cc_impl() override = default;
 
   int decimation() const override { return d_decim; }
+  int  phase() const override;
+  void set_phase(int phase) override;
+  bool commutator() const override { return d_commutator; }
 
   // Never noexcept in your template
   int work(int noutput_items,
@@ -29,4 +40,3 @@ public:
 }} // namespace gr::howto
 
 #endif /* INCLUDED_HOWTO_DOWNSAMPLE_CC_IMPL_H */
-
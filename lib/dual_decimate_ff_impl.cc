@@ -67,13 +67,16 @@ namespace gr {
 	  const int max0 = std::min(noutput_items, ninput[0] / D0s);
 	  const int max1 = std::min(noutput_items, ninput[1] / D1s);
 
-	  for (int i = 0; i < max0; ++i) {
-	    const float* w0 = &in0[i * D0s];
-	    out0[i] = mean_window(w0, D0s);
-	  }
-	  for (int i = 0; i < max1; ++i) {
-	    const float* w1 = &in1[i * D1s];
-	    out1[i] = mean_window(w1, D1s);
+	  const mean_decim_fn k0 = select_mean_decim(D0s);
+	  const mean_decim_fn k1 = select_mean_decim(D1s);
+	  const int tile = std::max(16, TILE_FLOATS / (D0s + D1s));
+	  const int maxn = std::max(max0, max1);
+
+	  for (int i = 0; i < maxn; i += tile) {
+	    const int n0 = std::min(tile, max0 - i);
+	    const int n1 = std::min(tile, max1 - i);
+	    if (n0 > 0) k0(in0 + (size_t)i * D0s, out0 + i, n0, D0s);
+	    if (n1 > 0) k1(in1 + (size_t)i * D1s, out1 + i, n1, D1s);
 	  }
 
 	  consume(0, max0 * D0s);
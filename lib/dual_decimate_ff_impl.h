@@ -4,6 +4,7 @@
 
 #include <howto/dual_decimate_ff.h>
 #include <boost/thread/mutex.hpp>
+#include "mean_decim_kernels.h"
 
 namespace gr {
     
@@ -17,12 +18,9 @@ namespace gr {
 	  int  d_D1;
 	  bool d_need_realign; // flagged by setters; consumed in general_work
 
-	  static inline float mean_window(const float* ptr, int len) noexcept
-	  {
-	    float acc = 0.0f;
-	    for (int i = 0; i < len; ++i) acc += ptr[i];
-	    return acc / (float)len;
-	  }
+	  // Both ports are walked in tiles of outputs whose inputs together fit
+	  // in ~16 KiB, alternating port 0 / port 1 (one interleaved pass).
+	  enum { TILE_FLOATS = 4096 };
 
 	public:
 	  explicit dual_decimate_ff_impl(int D0, int D1);
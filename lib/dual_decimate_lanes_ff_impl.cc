@@ -0,0 +1,100 @@
+/* -*- c++ -*- */
+#include "dual_decimate_lanes_ff_impl.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+#include <algorithm>
+
+namespace gr {
+
+    namespace howto {
+
+	// -------- lane --------
+
+	mean_decim_lane_ff::mean_decim_lane_ff(int D)
+	  : gr::block("mean_decim_lane_ff",
+		      gr::io_signature::make(1, 1, sizeof(float)),
+		      gr::io_signature::make(1, 1, sizeof(float))),
+	    d_D(D),
+	    d_need_realign(false)
+	{
+	  set_relative_rate(1.0 / (double)D);
+	}
+
+	void
+	mean_decim_lane_ff::forecast (int noutput_items, gr_vector_int &req)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  req[0] = d_D * noutput_items;
+	}
+
+	int
+	mean_decim_lane_ff::general_work(int noutput_items,
+		                         gr_vector_int &ninput,
+		                         gr_vector_const_void_star &input_items,
+		                         gr_vector_void_star &output_items)
+	{
+	  int D;
+	  {
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (d_need_realign) {
+	      d_need_realign = false;
+	      set_relative_rate(1.0 / (double)d_D);
+	      return 0; // scheduler will re-query forecast with new D
+	    }
+	    D = d_D;
+	  }
+
+	  const float* in = static_cast<const float*>(input_items[0]);
+	  float* out = static_cast<float*>(output_items[0]);
+
+	  const int nout = std::min(noutput_items, ninput[0] / D);
+	  select_mean_decim(D)(in, out, nout, D);
+
+	  consume_each(nout * D);
+	  return nout;
+	}
+
+	void mean_decim_lane_ff::set_D(int D) noexcept
+	{
+	  if (D < 1) return;
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (D != d_D) {
+	    d_D = D;
+	    d_need_realign = true;
+	  }
+	}
+
+	int mean_decim_lane_ff::D() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_D;
+	}
+
+	// -------- hier --------
+
+	dual_decimate_lanes_ff::sptr
+	dual_decimate_lanes_ff::make(int D0, int D1)
+	{
+	  return gnuradio::get_initial_sptr(new dual_decimate_lanes_ff_impl(D0, D1));
+	}
+
+	dual_decimate_lanes_ff_impl::dual_decimate_lanes_ff_impl(int D0, int D1)
+	  : gr::hier_block2("dual_decimate_lanes_ff",
+		            gr::io_signature::make2(2, 2, sizeof(float), sizeof(float)),
+		            gr::io_signature::make2(2, 2, sizeof(float), sizeof(float)))
+	{
+	  if (D0 < 1 || D1 < 1)
+	    throw std::invalid_argument("D0 and D1 must be >= 1");
+
+	  // Each lane is its own block: its own thread, forecast and buffers.
+	  d_lane0 = gnuradio::get_initial_sptr(new mean_decim_lane_ff(D0));
+	  d_lane1 = gnuradio::get_initial_sptr(new mean_decim_lane_ff(D1));
+
+	  connect(self(), 0, d_lane0, 0);
+	  connect(d_lane0, 0, self(), 0);
+	  connect(self(), 1, d_lane1, 0);
+	  connect(d_lane1, 0, self(), 1);
+	}
+
+} // namespace howto
+} // namespace gr
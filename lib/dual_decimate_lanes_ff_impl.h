@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_DUAL_DECIMATE_LANES_FF_IMPL_H
+#define INCLUDED_HOWTO_DUAL_DECIMATE_LANES_FF_IMPL_H
+
+#include <howto/dual_decimate_lanes_ff.h>
+#include <gnuradio/block.h>
+#include <boost/thread/mutex.hpp>
+#include "mean_decim_kernels.h"
+
+namespace gr {
+
+    namespace howto {
+
+	/*!
+	 * \brief One lane: 1-in/1-out block-mean decimator (internal, not exported).
+	 * Same realign-on-change contract as dual_decimate_ff.
+	 */
+	class mean_decim_lane_ff final : public gr::block
+	{
+	private:
+	  mutable boost::mutex d_mutex;
+	  int  d_D;
+	  bool d_need_realign;
+
+	public:
+	  explicit mean_decim_lane_ff(int D);
+	  ~mean_decim_lane_ff() noexcept override {}
+
+	  void forecast (int noutput_items, gr_vector_int &ninput_items_required) override;
+
+	  int general_work(int noutput_items,
+		           gr_vector_int &ninput_items,
+		           gr_vector_const_void_star &input_items,
+		           gr_vector_void_star &output_items) override;
+
+	  void set_D(int D) noexcept;
+	  int  D() const noexcept;
+	};
+
+	class dual_decimate_lanes_ff_impl final : public dual_decimate_lanes_ff
+	{
+	private:
+	  boost::shared_ptr<mean_decim_lane_ff> d_lane0;
+	  boost::shared_ptr<mean_decim_lane_ff> d_lane1;
+
+	public:
+	  dual_decimate_lanes_ff_impl(int D0, int D1);
+	  ~dual_decimate_lanes_ff_impl() noexcept override {}
+
+	  void set_D0(int D0) noexcept override { d_lane0->set_D(D0); }
+	  void set_D1(int D1) noexcept override { d_lane1->set_D(D1); }
+
+	  int D0() const noexcept override { return d_lane0->D(); }
+	  int D1() const noexcept override { return d_lane1->D(); }
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_DUAL_DECIMATE_LANES_FF_IMPL_H */
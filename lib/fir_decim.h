@@ -0,0 +1,110 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_FIR_DECIM_H
+#define INCLUDED_HOWTO_FIR_DECIM_H
+
+#include "decim_stage.h"
+#include "fir_fold.h"
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Decimating FIR stage: only every M-th output is computed, each one a
+	 * (folded, if the taps are symmetric) fir_dot over its window.
+	 */
+	class fir_decim_stage : public decim_stage
+	{
+	public:
+	  fir_decim_stage(const std::vector<float>& taps, int decim)
+	  : d_decim(decim), d_acc(FIR_ACC_FLOAT)
+	  {
+	    d_taps.set(taps);
+	    reset();
+	  }
+
+	  int decimation() const { return d_decim; }
+	  int ntaps() const { return d_taps.size(); }
+	  const std::vector<float>& taps() const { return d_taps.h; }
+	  int memory() const { return d_taps.size() - 1; }
+
+	  void reset()
+	  {
+	    d_buf.assign(d_taps.size() - 1, gr_complex(0.0f, 0.0f));
+	    d_fbuf.assign(d_taps.size() - 1, 0.0f);
+	  }
+
+	  int process(const gr_complex* in, int nin, gr_complex* out)
+	  {
+	    const int H = d_taps.size() - 1;
+	    const int nout = nin / d_decim;
+	    d_buf.resize(H + nin);
+	    std::copy(in, in + nin, d_buf.begin() + H);
+
+	    dots_(&d_buf[0], nout, out);
+
+	    d_buf.erase(d_buf.begin(), d_buf.begin() + nin);   // keep the last H
+	    return nout;
+	  }
+
+	  //! Real-input version (own delay line)
+	  int process(const float* in, int nin, float* out)
+	  {
+	    const int H = d_taps.size() - 1;
+	    const int nout = nin / d_decim;
+	    d_fbuf.resize(H + nin);
+	    std::copy(in, in + nin, d_fbuf.begin() + H);
+
+	    dots_(&d_fbuf[0], nout, out);
+
+	    d_fbuf.erase(d_fbuf.begin(), d_fbuf.begin() + nin);
+	    return nout;
+	  }
+
+	  double macs_per_output() const
+	  {
+	    const int T = d_taps.size();
+	    return d_taps.symmetric ? (T + 1) / 2 : T;
+	  }
+
+	  void set_accumulation(int acc) { d_acc = acc; }
+
+	  std::string describe() const
+	  {
+	    char s[64];
+	    snprintf(s, sizeof(s), "FIR(D=%d, %d taps)", d_decim, d_taps.size());
+	    return s;
+	  }
+
+	private:
+	  template<class Acc, typename T>
+	  void dots_(const T* w, int nout, T* out) const
+	  {
+	    for (int j = 0; j < nout; ++j)
+	      out[j] = fir_dot<Acc>(w + j * d_decim, d_taps);
+	  }
+
+	  template<typename T>
+	  void dots_(const T* w, int nout, T* out) const
+	  {
+	    switch (d_acc) {
+	    case FIR_ACC_SPLIT:  dots_<fir_acc_split>(w, nout, out); break;
+	    case FIR_ACC_DOUBLE: dots_<fir_acc_double>(w, nout, out); break;
+	    default:             dots_<fir_acc_float>(w, nout, out); break;
+	    }
+	  }
+
+	  int d_decim;
+	  int d_acc;                       // FIR_ACC_*
+	  fir_fold_taps d_taps;
+	  std::vector<gr_complex> d_buf;   // last T-1 inputs + current chunk
+	  std::vector<float> d_fbuf;       // same, real input
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_FIR_DECIM_H */
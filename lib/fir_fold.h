@@ -0,0 +1,300 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_FIR_FOLD_H
+#define INCLUDED_HOWTO_FIR_FOLD_H
+
+#include <gnuradio/gr_complex.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * FIR dot products over a window w[0..T-1] (oldest .. newest):
+	 *
+	 *   y = sum_k h[k] * w[T-1-k]
+	 *
+	 * Linear-phase taps (every windowed-sinc design in this module) satisfy
+	 * h[k] == h[T-1-k], so the window is folded first and only ceil(T/2)
+	 * multiplies are needed:
+	 *
+	 *   y = sum_{k<T/2} h[k] * (w[k] + w[T-1-k])  (+ h[T/2] * w[T/2] if T odd)
+	 *
+	 * fir_fold_taps::set() detects the symmetry once per tap update; any
+	 * other tap set runs the plain (non-folded) product.
+	 */
+	struct fir_fold_taps
+	{
+	  std::vector<float> h;      // natural order
+	  std::vector<float> h2;     // each tap twice, for interleaved complex
+	  bool symmetric;
+
+	  fir_fold_taps() : symmetric(false) {}
+
+	  void set(const std::vector<float>& taps)
+	  {
+	    h = taps;
+	    h2.resize(2 * h.size());
+	    for (size_t k = 0; k < h.size(); ++k) h2[2 * k] = h2[2 * k + 1] = h[k];
+	    symmetric = is_symmetric(h);
+	  }
+
+	  int size() const { return (int)h.size(); }
+
+	  static bool is_symmetric(const std::vector<float>& t)
+	  {
+	    if (t.size() < 2) return false;
+	    float amax = 0.0f;
+	    for (size_t k = 0; k < t.size(); ++k) amax = std::max(amax, std::fabs(t[k]));
+	    const float tol = 1e-6f * amax;
+	    for (size_t k = 0, j = t.size() - 1; k < j; ++k, --j)
+	      if (std::fabs(t[k] - t[j]) > tol) return false;
+	    return true;
+	  }
+	};
+
+#if defined(__SSE__)
+	//! w[k..k+3] + w[T-1-k .. T-4-k]: 4 folded real pairs
+	static inline __m128 fir_fold4_(const float* w, int T, int k)
+	{
+	  __m128 hi = _mm_loadu_ps(w + T - 4 - k);               // w[T-4-k .. T-1-k]
+	  hi = _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(0, 1, 2, 3));  // reversed
+	  return _mm_add_ps(_mm_loadu_ps(w + k), hi);
+	}
+
+	//! w[T-1-k .. T-4-k]: the window reversed against h[k..k+3]
+	static inline __m128 fir_rev4_(const float* w, int T, int k)
+	{
+	  const __m128 x = _mm_loadu_ps(w + T - 4 - k);
+	  return _mm_shuffle_ps(x, x, _MM_SHUFFLE(0, 1, 2, 3));
+	}
+
+	//! w[k], w[k+1] plus w[T-1-k], w[T-2-k] (interleaved complex)
+	static inline __m128 fir_fold2c_(const float* wf, int T, int k)
+	{
+	  __m128 hi = _mm_loadu_ps(wf + 2 * (T - 2 - k));         // w[T-2-k], w[T-1-k]
+	  hi = _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 0, 3, 2));   // swap the two samples
+	  return _mm_add_ps(_mm_loadu_ps(wf + 2 * k), hi);
+	}
+
+	//! h[T-1-k], h[T-2-k], each doubled
+	static inline __m128 fir_hrev2c_(const float* h2, int T, int k)
+	{
+	  const __m128 hv = _mm_loadu_ps(h2 + 2 * (T - 2 - k));   // h[T-2-k], h[T-1-k]
+	  return _mm_shuffle_ps(hv, hv, _MM_SHUFFLE(1, 0, 3, 2));
+	}
+#endif
+
+	/*
+	 * Accumulation policies (fir_dot's template parameter). A long FIR
+	 * adds thousands of products, and with a single float accumulator the
+	 * rounding error grows with the tap count; it also makes every add wait
+	 * for the previous one.
+	 *
+	 *   fir_acc_float   one vector accumulator (4 partial sums); the default
+	 *   fir_acc_split   4 vector accumulators (16 partial sums) combined
+	 *                   pairwise: each sum is 4x shorter, and the 4 add
+	 *                   chains are independent, so it is usually no slower
+	 *   fir_acc_double  products and sums in double (2 per vector): error no
+	 *                   longer grows with the length, about half the speed
+	 *
+	 * Folding (w[k] + w[T-1-k]) stays in float in every policy: it rounds
+	 * once per term and does not grow with T.
+	 */
+	enum { FIR_ACC_FLOAT = 0, FIR_ACC_SPLIT = 1, FIR_ACC_DOUBLE = 2 };
+
+	struct fir_acc_float
+	{
+	  typedef float scalar_t;
+#if defined(__SSE__)
+	  struct vacc
+	  {
+	    __m128 a;
+	    vacc() : a(_mm_setzero_ps()) {}
+	    template<int J> void mac(__m128 h, __m128 x) { a = _mm_add_ps(a, _mm_mul_ps(h, x)); }
+	    void lanes(float t[4]) const { _mm_storeu_ps(t, a); }
+	  };
+#endif
+	};
+
+	struct fir_acc_split
+	{
+	  typedef float scalar_t;
+#if defined(__SSE__)
+	  struct vacc
+	  {
+	    __m128 a0, a1, a2, a3;
+	    vacc() : a0(_mm_setzero_ps()), a1(a0), a2(a0), a3(a0) {}
+	    template<int J> void mac(__m128 h, __m128 x)
+	    {
+	      __m128& a = J == 0 ? a0 : J == 1 ? a1 : J == 2 ? a2 : a3;
+	      a = _mm_add_ps(a, _mm_mul_ps(h, x));
+	    }
+	    void lanes(float t[4]) const
+	    { _mm_storeu_ps(t, _mm_add_ps(_mm_add_ps(a0, a1), _mm_add_ps(a2, a3))); }
+	  };
+#endif
+	};
+
+	struct fir_acc_double
+	{
+	  typedef double scalar_t;
+#if defined(__SSE2__)
+	  struct vacc
+	  {
+	    __m128d lo, hi;    // lanes 0-1 and 2-3
+	    vacc() : lo(_mm_setzero_pd()), hi(lo) {}
+	    template<int J> void mac(__m128 h, __m128 x)
+	    {
+	      lo = _mm_add_pd(lo, _mm_mul_pd(_mm_cvtps_pd(h), _mm_cvtps_pd(x)));
+	      hi = _mm_add_pd(hi, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(h, h)),
+	                                     _mm_cvtps_pd(_mm_movehl_ps(x, x))));
+	    }
+	    void lanes(double t[4]) const { _mm_storeu_pd(t, lo); _mm_storeu_pd(t + 2, hi); }
+	  };
+#elif defined(__SSE__)
+	  struct vacc
+	  {
+	    double a[4];
+	    vacc() { a[0] = a[1] = a[2] = a[3] = 0.0; }
+	    template<int J> void mac(__m128 h, __m128 x)
+	    {
+	      float hv[4], xv[4];
+	      _mm_storeu_ps(hv, h);
+	      _mm_storeu_ps(xv, x);
+	      for (int i = 0; i < 4; ++i) a[i] += (double)hv[i] * xv[i];
+	    }
+	    void lanes(double t[4]) const { std::copy(a, a + 4, t); }
+	  };
+#endif
+	};
+
+#if defined(__SSE__)
+	//! Lane sums: one real sum, or (re, im) of interleaved complex lanes
+	template<class V, typename S>
+	static inline S fir_acc_sum_(const V& a)
+	{
+	  S t[4];
+	  a.lanes(t);
+	  return (t[0] + t[1]) + (t[2] + t[3]);
+	}
+
+	template<class V, typename S>
+	static inline void fir_acc_sum2_(const V& a, S& re, S& im)
+	{
+	  S t[4];
+	  a.lanes(t);
+	  re = t[0] + t[2];
+	  im = t[1] + t[3];
+	}
+#endif
+
+	// ---- float window ----
+	template<class Acc = fir_acc_float>
+	static inline float fir_dot(const float* w, const fir_fold_taps& ft)
+	{
+	  typedef typename Acc::scalar_t S;
+	  const int T = ft.size();
+	  const float* h = &ft.h[0];
+	  S acc = 0;
+	  int k = 0;
+	  if (ft.symmetric) {
+	    const int half = T / 2;
+#if defined(__SSE__)
+	    typename Acc::vacc a;
+	    for (; k + 16 <= half; k += 16) {
+	      a.template mac<0>(_mm_loadu_ps(h + k),      fir_fold4_(w, T, k));
+	      a.template mac<1>(_mm_loadu_ps(h + k + 4),  fir_fold4_(w, T, k + 4));
+	      a.template mac<2>(_mm_loadu_ps(h + k + 8),  fir_fold4_(w, T, k + 8));
+	      a.template mac<3>(_mm_loadu_ps(h + k + 12), fir_fold4_(w, T, k + 12));
+	    }
+	    for (; k + 4 <= half; k += 4)
+	      a.template mac<0>(_mm_loadu_ps(h + k), fir_fold4_(w, T, k));
+	    acc = fir_acc_sum_<typename Acc::vacc, S>(a);
+#endif
+	    for (; k < half; ++k) acc += (S)h[k] * (S)(w[k] + w[T - 1 - k]);
+	    if (T & 1) acc += (S)h[half] * (S)w[half];
+	  } else {
+#if defined(__SSE__)
+	    typename Acc::vacc a;
+	    for (; k + 16 <= T; k += 16) {
+	      a.template mac<0>(_mm_loadu_ps(h + k),      fir_rev4_(w, T, k));
+	      a.template mac<1>(_mm_loadu_ps(h + k + 4),  fir_rev4_(w, T, k + 4));
+	      a.template mac<2>(_mm_loadu_ps(h + k + 8),  fir_rev4_(w, T, k + 8));
+	      a.template mac<3>(_mm_loadu_ps(h + k + 12), fir_rev4_(w, T, k + 12));
+	    }
+	    for (; k + 4 <= T; k += 4)
+	      a.template mac<0>(_mm_loadu_ps(h + k), fir_rev4_(w, T, k));
+	    acc = fir_acc_sum_<typename Acc::vacc, S>(a);
+#endif
+	    for (; k < T; ++k) acc += (S)h[k] * (S)w[T - 1 - k];
+	  }
+	  return (float)acc;
+	}
+
+	// ---- complex window, real taps ----
+	template<class Acc = fir_acc_float>
+	static inline gr_complex fir_dot(const gr_complex* w, const fir_fold_taps& ft)
+	{
+	  typedef typename Acc::scalar_t S;
+	  const int T = ft.size();
+	  const float* wf = reinterpret_cast<const float*>(w);
+	  S re = 0, im = 0;
+	  int k = 0;
+	  if (ft.symmetric) {
+	    const float* h = &ft.h[0];
+	    const int half = T / 2;
+#if defined(__SSE__)
+	    const float* h2 = &ft.h2[0];
+	    typename Acc::vacc a;
+	    for (; k + 8 <= half; k += 8) {
+	      a.template mac<0>(_mm_loadu_ps(h2 + 2 * k),       fir_fold2c_(wf, T, k));
+	      a.template mac<1>(_mm_loadu_ps(h2 + 2 * k + 4),   fir_fold2c_(wf, T, k + 2));
+	      a.template mac<2>(_mm_loadu_ps(h2 + 2 * k + 8),   fir_fold2c_(wf, T, k + 4));
+	      a.template mac<3>(_mm_loadu_ps(h2 + 2 * k + 12),  fir_fold2c_(wf, T, k + 6));
+	    }
+	    for (; k + 2 <= half; k += 2)
+	      a.template mac<0>(_mm_loadu_ps(h2 + 2 * k), fir_fold2c_(wf, T, k));
+	    fir_acc_sum2_<typename Acc::vacc, S>(a, re, im);
+#endif
+	    for (; k < half; ++k) {
+	      re += (S)h[k] * (S)(wf[2 * k]     + wf[2 * (T - 1 - k)]);
+	      im += (S)h[k] * (S)(wf[2 * k + 1] + wf[2 * (T - 1 - k) + 1]);
+	    }
+	    if (T & 1) { re += (S)h[half] * (S)wf[2 * half]; im += (S)h[half] * (S)wf[2 * half + 1]; }
+	  } else {
+	    const float* h2 = &ft.h2[0];
+#if defined(__SSE__)
+	    // h2 reversed against w: step backwards through the taps
+	    typename Acc::vacc a;
+	    for (; k + 8 <= T; k += 8) {
+	      a.template mac<0>(fir_hrev2c_(h2, T, k),     _mm_loadu_ps(wf + 2 * k));
+	      a.template mac<1>(fir_hrev2c_(h2, T, k + 2), _mm_loadu_ps(wf + 2 * k + 4));
+	      a.template mac<2>(fir_hrev2c_(h2, T, k + 4), _mm_loadu_ps(wf + 2 * k + 8));
+	      a.template mac<3>(fir_hrev2c_(h2, T, k + 6), _mm_loadu_ps(wf + 2 * k + 12));
+	    }
+	    for (; k + 2 <= T; k += 2)
+	      a.template mac<0>(fir_hrev2c_(h2, T, k), _mm_loadu_ps(wf + 2 * k));
+	    fir_acc_sum2_<typename Acc::vacc, S>(a, re, im);
+#endif
+	    for (; k < T; ++k) {
+	      re += (S)h2[2 * (T - 1 - k)] * (S)wf[2 * k];
+	      im += (S)h2[2 * (T - 1 - k)] * (S)wf[2 * k + 1];
+	    }
+	  }
+	  return gr_complex((float)re, (float)im);
+	}
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_FIR_FOLD_H */
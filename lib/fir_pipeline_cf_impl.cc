@@ -0,0 +1,207 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "fir_pipeline_cf_impl.h"
+#include "flex_fir_impl_base.h"
+#include "fir_decim.h"
+#include "decim_planner.h"
+#include "pointwise_stages.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/block_detail.h>
+#include <gnuradio/buffer.h>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace gr { namespace howto {
+
+namespace {
+
+// flex_fir_cc: real taps on complex samples, own delay line
+class fir_pipe_stage : public pipe_stage
+{
+public:
+  explicit fir_pipe_stage(const std::vector<float>& taps) : d_fir(taps, 1) {}
+  size_t in_size() const { return sizeof(gr_complex); }
+  size_t out_size() const { return sizeof(gr_complex); }
+  void process(const void* in, int nin, void* out)
+  { d_fir.process(static_cast<const gr_complex*>(in), nin, static_cast<gr_complex*>(out)); }
+  void reset() { d_fir.reset(); }
+  std::string describe() const { return d_fir.describe(); }
+private:
+  fir_decim_stage d_fir;
+};
+
+// decimate_fir_cc: the planner's chain, run whole on one thread
+class decim_pipe_stage : public pipe_stage
+{
+public:
+  explicit decim_pipe_stage(const decim_spec& spec) : d_decim(spec.decim)
+  { plan_decimation(spec, true, d_chain); }
+  size_t in_size() const { return sizeof(gr_complex); }
+  size_t out_size() const { return sizeof(gr_complex); }
+  int decimation() const { return d_decim; }
+  void process(const void* in, int nin, void* out)
+  { d_chain.process(static_cast<const gr_complex*>(in), nin, static_cast<gr_complex*>(out)); }
+  void reset() { d_chain.reset(); }
+  std::string describe() const
+  {
+    std::string s;
+    for (int i = 0; i < d_chain.stages(); ++i)
+      s += (i ? " -> " : "") + d_chain.stage(i).describe();
+    return s;
+  }
+private:
+  int d_decim;
+  decim_chain d_chain;
+};
+
+// iq_mag_cf
+class mag_pipe_stage : public pipe_stage
+{
+public:
+  explicit mag_pipe_stage(float scale) : d_scale(scale) {}
+  size_t in_size() const { return sizeof(gr_complex); }
+  size_t out_size() const { return sizeof(float); }
+  void process(const void* in, int nin, void* out)
+  {
+    pw::run(pw::mag() | pw::gain(d_scale), static_cast<const gr_complex*>(in),
+            static_cast<float*>(out), nin);
+  }
+  void reset() {}
+  std::string describe() const
+  {
+    char s[32];
+    snprintf(s, sizeof(s), "|x|*%g", d_scale);
+    return s;
+  }
+private:
+  float d_scale;
+};
+
+} // namespace
+
+fir_pipeline_cf::sptr
+fir_pipeline_cf::make(int mode, float samp_rate, float f1, float f2, float width, float gain,
+                      int decim, double cutoff, double transition, float scale,
+                      const std::vector<int>& cores, int ring_kbytes)
+{
+  return gnuradio::get_initial_sptr(
+      new fir_pipeline_cf_impl(mode, samp_rate, f1, f2, width, gain,
+                               decim, cutoff, transition, scale, cores, ring_kbytes));
+}
+
+fir_pipeline_cf_impl::fir_pipeline_cf_impl(int mode, float fs, float f1, float f2, float width,
+                                           float gain, int decim, double cutoff,
+                                           double transition, float scale,
+                                           const std::vector<int>& cores, int ring_kbytes)
+: gr::block("fir_pipeline_cf",
+            gr::io_signature::make(1, 1, sizeof(gr_complex)),
+            gr::io_signature::make(1, 1, sizeof(float))),
+  d_pushed(0),
+  d_popped(0)
+{
+  if (fs <= 0.0f)      throw std::invalid_argument("samp_rate must be > 0");
+  if (width <= 0.0f)   throw std::invalid_argument("width must be > 0");
+  if (decim < 1)       throw std::invalid_argument("decim must be >= 1");
+  if (ring_kbytes < 0) throw std::invalid_argument("ring_kbytes must be >= 0");
+
+  std::vector<boost::shared_ptr<pipe_stage> > st;
+  st.push_back(boost::shared_ptr<pipe_stage>(
+      new fir_pipe_stage(flex_fir_design(mode, fs, f1, f2, width, gain))));
+  if (decim > 1) {
+    if (cutoff <= 0.0)     throw std::invalid_argument("cutoff must be > 0");
+    if (transition <= 0.0) throw std::invalid_argument("transition must be > 0");
+    const decim_spec spec = { decim, fs, cutoff, transition, gr::filter::firdes::WIN_HAMMING, 6.76 };
+    st.push_back(boost::shared_ptr<pipe_stage>(new decim_pipe_stage(spec)));
+  }
+  st.push_back(boost::shared_ptr<pipe_stage>(new mag_pipe_stage(scale)));
+
+  // Rings live in the L2 of the cores on both sides: a quarter each leaves
+  // room for the stages' own delay lines and taps.
+  const size_t ring_bytes = ring_kbytes > 0 ? (size_t)ring_kbytes * 1024
+                                            : stage_pipeline::l2_bytes() / 4;
+  d_pipe.reset(new stage_pipeline(st, ring_bytes, cores));
+
+  set_relative_rate(1.0 / decim);
+}
+
+fir_pipeline_cf_impl::~fir_pipeline_cf_impl()
+{
+}
+
+std::vector<int> fir_pipeline_cf_impl::ring_items() const
+{
+  std::vector<int> n;
+  for (int k = 0; k <= d_pipe->stages(); ++k)
+    n.push_back((int)d_pipe->ring_items(k));
+  return n;
+}
+
+bool fir_pipeline_cf_impl::start()
+{
+  d_pushed = d_popped = 0;
+  d_pipe->start();
+  return gr::block::start();
+}
+
+bool fir_pipeline_cf_impl::stop()
+{
+  d_pipe->stop();
+  return gr::block::stop();
+}
+
+void fir_pipeline_cf_impl::forecast(int /*noutput_items*/, gr_vector_int &ninput_items_required)
+{
+  // Any input keeps the chain busy; outputs are whatever has come through
+  ninput_items_required[0] = 1;
+}
+
+bool fir_pipeline_cf_impl::more_input_(int seen) const
+{
+  // The executor finishes a block whose input is done and empty without
+  // calling it again, so another call is certain only while unconsumed
+  // input is left beyond what this call was given.
+  buffer_reader_sptr r = detail()->input(0);
+  gr::thread::scoped_lock lk(*r->mutex());
+  return r->items_available() > seen;
+}
+
+int fir_pipeline_cf_impl::general_work(int noutput_items,
+                                       gr_vector_int &ninput_items,
+                                       gr_vector_const_void_star &input_items,
+                                       gr_vector_void_star &output_items)
+{
+  const gr_complex* in = static_cast<const gr_complex*>(input_items[0]);
+  float* out = static_cast<float*>(output_items[0]);
+  const unsigned long long D = d_pipe->decimation();
+
+  // Outputs owed for everything pushed so far must fit in this call's
+  // buffer, so only push what the output room can take.
+  const long long room = (long long)noutput_items - (long long)(d_pushed / D - d_popped);
+  const long long take = std::min<long long>(ninput_items[0], room * (long long)D - (long long)(d_pushed % D));
+  const int pushed = take > 0 ? d_pipe->push(in, (int)take) : 0;
+  d_pushed += pushed;
+
+  // Return as soon as something has come through if another call will
+  // follow: input is left over, or more has arrived meanwhile. Having taken
+  // everything with the input done (or a source that has gone quiet), wait
+  // for every owed output, since this may be the last call.
+  const bool all_in = pushed == ninput_items[0];
+  const int want = (int)std::min<unsigned long long>(d_pushed / D - d_popped, noutput_items);
+  int nout = 0;
+  int polls = 0;
+  for (;;) {
+    nout += d_pipe->pop(out + nout, want - nout);
+    if (nout == want) break;
+    if (nout > 0 && (!all_in || more_input_(ninput_items[0]))) break;
+    stage_pipeline::idle_wait(polls);
+  }
+  d_popped += nout;
+
+  consume_each(pushed);
+  return nout;
+}
+
+}} // namespace
@@ -0,0 +1,45 @@
+#ifndef INCLUDED_HOWTO_FIR_PIPELINE_CF_IMPL_H
+#define INCLUDED_HOWTO_FIR_PIPELINE_CF_IMPL_H
+
+#include <howto/fir_pipeline_cf.h>
+#include "stage_pipeline.h"
+#include <boost/scoped_ptr.hpp>
+
+namespace gr { namespace howto {
+
+class fir_pipeline_cf_impl final : public fir_pipeline_cf
+{
+private:
+  boost::scoped_ptr<stage_pipeline> d_pipe;
+
+  // Block-thread counters (reset by start())
+  unsigned long long d_pushed;   // inputs handed to the first ring
+  unsigned long long d_popped;   // outputs taken from the last ring
+
+  bool more_input_(int seen) const;
+
+public:
+  fir_pipeline_cf_impl(int mode, float fs, float f1, float f2, float width, float gain,
+                       int decim, double cutoff, double transition, float scale,
+                       const std::vector<int>& cores, int ring_kbytes);
+  ~fir_pipeline_cf_impl() override;
+
+  int decimation() const override { return d_pipe->decimation(); }
+  int stages() const override { return d_pipe->stages(); }
+  std::string describe() const override { return d_pipe->describe(); }
+  std::vector<int> ring_items() const override;
+  std::vector<float> stage_utilization() const override { return d_pipe->utilization(); }
+  void reset_utilization() override { d_pipe->reset_stats(); }
+
+  bool start() override;
+  bool stop() override;
+
+  void forecast(int noutput_items, gr_vector_int &ninput_items_required) override;
+  int general_work(int noutput_items,
+                   gr_vector_int &ninput_items,
+                   gr_vector_const_void_star &input_items,
+                   gr_vector_void_star &output_items) override;
+};
+
+}} // namespace
+#endif
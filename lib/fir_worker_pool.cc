@@ -0,0 +1,79 @@
+#include "fir_worker_pool.h"
+#include <boost/bind.hpp>
+#include <stdexcept>
+
+namespace gr { namespace howto {
+
+fir_worker_pool::fir_worker_pool(int nthreads, const std::vector<int>& cores)
+: d_cores(cores), d_gen(0), d_busy(0), d_stop(false), d_fn(0), d_ctx(0), d_n(0), d_next(0)
+{
+  if (nthreads < 1)
+    throw std::invalid_argument("fir_worker_pool: nthreads must be >= 1");
+  for (int k = 0; k < nthreads - 1; ++k)
+    d_threads.push_back(new gr::thread::thread(boost::bind(&fir_worker_pool::worker_, this, k)));
+}
+
+fir_worker_pool::~fir_worker_pool()
+{
+  {
+    boost::lock_guard<boost::mutex> g(d_mutex);
+    d_stop = true;
+  }
+  d_wake.notify_all();
+  for (size_t k = 0; k < d_threads.size(); ++k)
+    d_threads[k].join();
+}
+
+void fir_worker_pool::drain_()
+{
+  const int n = d_n;
+  for (int i = d_next.fetch_add(1); i < n; i = d_next.fetch_add(1))
+    d_fn(d_ctx, i);
+}
+
+void fir_worker_pool::run(int nchunks, chunk_fn fn, void* ctx)
+{
+  if (d_threads.empty() || nchunks < 2) {
+    for (int i = 0; i < nchunks; ++i) fn(ctx, i);
+    return;
+  }
+
+  {
+    boost::lock_guard<boost::mutex> g(d_mutex);
+    d_fn = fn;
+    d_ctx = ctx;
+    d_n = nchunks;
+    d_next.store(0);
+    d_busy = (int)d_threads.size();
+    ++d_gen;
+  }
+  d_wake.notify_all();
+
+  drain_();   // the calling thread takes chunks too
+
+  boost::unique_lock<boost::mutex> lk(d_mutex);
+  while (d_busy > 0) d_done.wait(lk);
+}
+
+void fir_worker_pool::worker_(int id)
+{
+  if (!d_cores.empty())
+    gr::thread::thread_bind_to_processor(std::vector<int>(1, d_cores[id % d_cores.size()]));
+
+  unsigned seen = 0;
+  for (;;) {
+    {
+      boost::unique_lock<boost::mutex> lk(d_mutex);
+      while (d_gen == seen && !d_stop) d_wake.wait(lk);
+      if (d_stop) return;
+      seen = d_gen;
+    }
+    drain_();
+    {
+      boost::lock_guard<boost::mutex> g(d_mutex);
+      if (--d_busy == 0) d_done.notify_one();
+    }
+  }
+}
+
+}} // namespace
@@ -0,0 +1,67 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_FIR_WORKER_POOL_H
+#define INCLUDED_HOWTO_FIR_WORKER_POOL_H
+
+#include <gnuradio/thread/thread.h>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <atomic>
+#include <vector>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Persistent worker pool for data-parallel work() calls (one pool per
+	 * block, opt-in). run(n, fn, ctx) calls fn(ctx, i) for every chunk
+	 * i in [0, n) on the workers *and* the calling thread, and returns
+	 * when all chunks are done.
+	 *
+	 * Chunks are claimed one at a time from a shared counter, so a thread
+	 * that finishes early (or a core that is busier with something else)
+	 * just takes the next one: run() with more chunks than threads
+	 * balances itself. Workers sleep on a condition variable between
+	 * calls; they are bound to cores[k % cores.size()] if cores is given
+	 * (the calling thread keeps the block's own affinity).
+	 */
+	class fir_worker_pool
+	{
+	public:
+	  typedef void (*chunk_fn)(void* ctx, int chunk);
+
+	  //! nthreads counts the calling thread (nthreads - 1 workers)
+	  fir_worker_pool(int nthreads, const std::vector<int>& cores);
+	  ~fir_worker_pool();
+
+	  int size() const { return (int)d_threads.size() + 1; }
+	  const std::vector<int>& cores() const { return d_cores; }
+
+	  void run(int nchunks, chunk_fn fn, void* ctx);
+
+	private:
+	  void worker_(int id);
+	  void drain_();
+
+	  std::vector<int> d_cores;
+	  boost::ptr_vector<gr::thread::thread> d_threads;
+
+	  boost::mutex d_mutex;
+	  boost::condition_variable d_wake;    // new generation (or stop)
+	  boost::condition_variable d_done;    // last worker left the generation
+	  unsigned d_gen;
+	  int d_busy;                          // workers still in this generation
+	  bool d_stop;
+
+	  // current call (written under d_mutex before d_gen is bumped)
+	  chunk_fn d_fn;
+	  void* d_ctx;
+	  int d_n;
+	  std::atomic<int> d_next;             // next unclaimed chunk
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_FIR_WORKER_POOL_H */
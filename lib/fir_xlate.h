@@ -0,0 +1,111 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_FIR_XLATE_H
+#define INCLUDED_HOWTO_FIR_XLATE_H
+
+#include "fir_fold.h"
+#include <gnuradio/gr_complex.h>
+#include <vector>
+#include <cmath>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Frequency-translating FIR taps.
+	 *
+	 * Mixing by e^{-jw m} before a real low-pass h is the same as filtering
+	 * with rotated taps and applying the rest of the rotation at the output:
+	 *
+	 *   y = e^{-jw (m - c)} * sum_k b[k] x[m-k],   b[k] = h[k] e^{jw (k - c)}
+	 *
+	 * (m = newest input, c = (T-1)/2). Rotating around the centre keeps
+	 * linear-phase h conjugate symmetric, b[T-1-k] = conj(b[k]), so the
+	 * window still folds: with u = w[T-1-k], v = w[k],
+	 *
+	 *   b u + conj(b) v = Re(b) (u + v) + j Im(b) (u - v)
+	 *
+	 * i.e. two real folded products, the same multiply count as fir_dot on
+	 * complex data with real taps.
+	 */
+	struct fir_xlate_taps
+	{
+	  std::vector<float> re2, im2;   // Re(b), Im(b), each tap twice (interleaved complex)
+	  std::vector<gr_complex> b;     // full taps, for non-symmetric h
+	  bool symmetric;
+
+	  fir_xlate_taps() : symmetric(false) {}
+
+	  void set(const std::vector<float>& h, double w)
+	  {
+	    const int T = (int)h.size();
+	    const double c = 0.5 * (T - 1);
+	    b.resize(T);
+	    re2.resize(2 * T);
+	    im2.resize(2 * T);
+	    for (int k = 0; k < T; ++k) {
+	      const double a = w * (k - c);
+	      b[k] = gr_complex((float)(h[k] * std::cos(a)), (float)(h[k] * std::sin(a)));
+	      re2[2 * k] = re2[2 * k + 1] = b[k].real();
+	      im2[2 * k] = im2[2 * k + 1] = b[k].imag();
+	    }
+	    symmetric = fir_fold_taps::is_symmetric(h);
+	  }
+
+	  int size() const { return (int)b.size(); }
+	};
+
+	//! sum_k b[k] * w[T-1-k], w oldest .. newest (no output rotation)
+	static inline gr_complex fir_xlate_dot(const gr_complex* w, const fir_xlate_taps& ft)
+	{
+	  const int T = ft.size();
+	  if (!ft.symmetric) {
+	    gr_complex acc(0.0f, 0.0f);
+	    for (int k = 0; k < T; ++k) acc += ft.b[k] * w[T - 1 - k];
+	    return acc;
+	  }
+
+	  const float* wf = reinterpret_cast<const float*>(w);
+	  const float* br = &ft.re2[0];
+	  const float* bi = &ft.im2[0];
+	  float sr = 0.0f, si = 0.0f;    // sum Re(b) (u + v)
+	  float dr = 0.0f, di = 0.0f;    // sum Im(b) (u - v)
+	  int k = 0;
+	  const int half = T / 2;
+#if defined(__SSE__)
+	  __m128 as = _mm_setzero_ps(), ad = _mm_setzero_ps();
+	  for (; k + 2 <= half; k += 2) {
+	    const __m128 v = _mm_loadu_ps(wf + 2 * k);                  // w[k], w[k+1]
+	    __m128 u = _mm_loadu_ps(wf + 2 * (T - 2 - k));              // w[T-2-k], w[T-1-k]
+	    u = _mm_shuffle_ps(u, u, _MM_SHUFFLE(1, 0, 3, 2));          // w[T-1-k], w[T-2-k]
+	    as = _mm_add_ps(as, _mm_mul_ps(_mm_loadu_ps(br + 2 * k), _mm_add_ps(u, v)));
+	    ad = _mm_add_ps(ad, _mm_mul_ps(_mm_loadu_ps(bi + 2 * k), _mm_sub_ps(u, v)));
+	  }
+	  float t[4];
+	  _mm_storeu_ps(t, as);
+	  sr = t[0] + t[2];
+	  si = t[1] + t[3];
+	  _mm_storeu_ps(t, ad);
+	  dr = t[0] + t[2];
+	  di = t[1] + t[3];
+#endif
+	  for (; k < half; ++k) {
+	    const int j = T - 1 - k;
+	    sr += br[2 * k] * (wf[2 * j]     + wf[2 * k]);
+	    si += br[2 * k] * (wf[2 * j + 1] + wf[2 * k + 1]);
+	    dr += bi[2 * k] * (wf[2 * j]     - wf[2 * k]);
+	    di += bi[2 * k] * (wf[2 * j + 1] - wf[2 * k + 1]);
+	  }
+	  if (T & 1) { sr += br[2 * half] * wf[2 * half]; si += br[2 * half] * wf[2 * half + 1]; }
+	  // S + j D
+	  return gr_complex(sr - di, si + dr);
+	}
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_FIR_XLATE_H */
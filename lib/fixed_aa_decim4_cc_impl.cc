@@ -0,0 +1,44 @@
+/* -*- c++ -*- */
+/* Generado por apps/howto_fixed_fir_gen.py desde lib/fixed_taps/aa_decim4.taps; no editar. */
+#include <howto/fixed_aa_decim4_cc.h>
+#include "fixed_fir_impl.h"
+
+namespace gr { namespace howto {
+
+namespace {
+
+struct fixed_aa_decim4_cc_taps
+{
+  static constexpr int   N = 63;
+  static constexpr bool  symmetric = true;
+  static constexpr float h[N] = {
+    4.469468544e-05f, -1.078332558e-19f, -1.444585958e-04f, -3.608519033e-04f,
+    -5.276547711e-04f, -4.583523513e-04f, 6.509352241e-19f, 8.312020876e-04f,
+    1.753220098e-03f, 2.246844608e-03f, 1.753840734e-03f, -1.822968495e-18f,
+    -2.698451699e-03f, -5.335293805e-03f, -6.465935890e-03f, -4.808817128e-03f,
+    3.595413925e-18f, 6.847197596e-03f, 1.313868064e-02f, 1.554210086e-02f,
+    1.134978389e-02f, -5.591018650e-18f, -1.590151197e-02f, -3.064858831e-02f,
+    -3.682443049e-02f, -2.772042756e-02f, 7.186331104e-18f, 4.440539581e-02f,
+    9.801388570e-02f, 1.494335628e-01f, 1.865193950e-01f, 2.000299399e-01f,
+    1.865193950e-01f, 1.494335628e-01f, 9.801388570e-02f, 4.440539581e-02f,
+    7.186331104e-18f, -2.772042756e-02f, -3.682443049e-02f, -3.064858831e-02f,
+    -1.590151197e-02f, -5.591018650e-18f, 1.134978389e-02f, 1.554210086e-02f,
+    1.313868064e-02f, 6.847197596e-03f, 3.595413925e-18f, -4.808817128e-03f,
+    -6.465935890e-03f, -5.335293805e-03f, -2.698451699e-03f, -1.822968495e-18f,
+    1.753840734e-03f, 2.246844608e-03f, 1.753220098e-03f, 8.312020876e-04f,
+    6.509352241e-19f, -4.583523513e-04f, -5.276547711e-04f, -3.608519033e-04f,
+    -1.444585958e-04f, -1.078332558e-19f, 4.469468544e-05f
+  };
+};
+
+constexpr float fixed_aa_decim4_cc_taps::h[];
+
+} // namespace
+
+fixed_aa_decim4_cc::sptr fixed_aa_decim4_cc::make()
+{
+  return gnuradio::get_initial_sptr(
+      new fixed_fir_impl<fixed_aa_decim4_cc, fixed_aa_decim4_cc_taps, gr_complex, 4>("fixed_aa_decim4_cc"));
+}
+
+}} // namespace
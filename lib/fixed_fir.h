@@ -0,0 +1,226 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_FIXED_FIR_H
+#define INCLUDED_HOWTO_FIXED_FIR_H
+
+#include <gnuradio/gr_complex.h>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Fixed-tap FIR kernels: the taps are a compile-time constant, so the
+	 * tap loop is unrolled completely (template recursion, no loop counter,
+	 * no run-time tail) and every tap is an immediate operand instead of a
+	 * load from a tap vector.
+	 *
+	 * Taps is a traits class, normally written by apps/howto_fixed_fir_gen.py:
+	 *
+	 *   struct my_taps {
+	 *     static constexpr int   N = ...;
+	 *     static constexpr bool  symmetric = ...;   // h[k] == h[N-1-k]
+	 *     static constexpr float h[N] = { ... };
+	 *   };
+	 *
+	 * Window convention as fir_dot: output i reads w = in + i*D (oldest ..
+	 * newest, N samples) and y = sum_k h[k] w[N-1-k]; nothing past the
+	 * newest sample is read, so the kernels run directly on the scheduler
+	 * buffer with set_history(N).
+	 *
+	 * D == 1: output-parallel, a vector of consecutive outputs per pass
+	 *   (4 real or 2 complex), each tap a broadcast constant; no horizontal
+	 *   sums. Linear-phase taps are folded (ceil(N/2) multiplies).
+	 * D > 1:  one output per pass over the reversed taps (4 floats per
+	 *   vector, a compile-time scalar tail), two accumulators.
+	 */
+
+	// ---- compile-time index list (C++11 has no std::index_sequence) ----
+	template<int... I> struct fixed_fir_seq {};
+	template<int N, int... I> struct fixed_fir_make_seq : fixed_fir_make_seq<N - 1, N - 1, I...> {};
+	template<int... I> struct fixed_fir_make_seq<0, I...> { typedef fixed_fir_seq<I...> type; };
+
+	// ---- for (K = B; K < E; ++K) f.template step<K>(), unrolled ----
+	template<int B, int E> struct fixed_fir_for
+	{
+	  template<class F> static inline void run(F& f)
+	  {
+	    f.template step<B>();
+	    fixed_fir_for<B + 1, E>::run(f);
+	  }
+	};
+	template<int E> struct fixed_fir_for<E, E>
+	{
+	  template<class F> static inline void run(F&) {}
+	};
+
+	// ---- reversed taps (k-th = h[N-1-k]), and doubled for interleaved complex ----
+	template<class Taps, class Seq> struct fixed_fir_rev_;
+	template<class Taps, int... I> struct fixed_fir_rev_<Taps, fixed_fir_seq<I...> >
+	{
+	  alignas(16) static constexpr float v[sizeof...(I)] = { Taps::h[Taps::N - 1 - I]... };
+	  alignas(16) static constexpr float v2[2 * sizeof...(I)] = {
+	    Taps::h[Taps::N - 1 - (I >> 1)]..., Taps::h[Taps::N - 1 - ((I + sizeof...(I)) >> 1)]... };
+	};
+	template<class Taps, int... I>
+	constexpr float fixed_fir_rev_<Taps, fixed_fir_seq<I...> >::v[sizeof...(I)];
+	template<class Taps, int... I>
+	constexpr float fixed_fir_rev_<Taps, fixed_fir_seq<I...> >::v2[2 * sizeof...(I)];
+
+	template<class Taps>
+	struct fixed_fir_rev : fixed_fir_rev_<Taps, typename fixed_fir_make_seq<Taps::N>::type> {};
+
+	template<class Taps, int D>
+	struct fixed_fir
+	{
+	  static const int N = Taps::N;
+	  static const int H = Taps::symmetric ? N / 2 : N;   // multiplies in the main sum
+	  typedef fixed_fir_rev<Taps> rev;
+
+	  // ---------------- one output, float ----------------
+	  struct dot_f
+	  {
+	    const float* w;
+	    float s0, s1;
+	    template<int K> inline void step()
+	    {
+	      (K & 1 ? s1 : s0) += rev::v[K] * w[K];
+	    }
+	  };
+
+	  // ---------------- one output, interleaved complex ----------------
+	  struct dot_c
+	  {
+	    const float* w;
+	    float r0, i0, r1, i1;
+	    template<int K> inline void step()
+	    {
+	      const float h = rev::v[K];
+	      if (K & 1) { r1 += h * w[2 * K]; i1 += h * w[2 * K + 1]; }
+	      else       { r0 += h * w[2 * K]; i0 += h * w[2 * K + 1]; }
+	    }
+	  };
+
+#if defined(__SSE__)
+	  struct dot_f4   // 4 reversed taps per vector
+	  {
+	    const float* w;
+	    __m128 a0, a1;
+	    template<int J> inline void step()
+	    {
+	      const __m128 p = _mm_mul_ps(_mm_load_ps(rev::v + 4 * J), _mm_loadu_ps(w + 4 * J));
+	      if (J & 1) a1 = _mm_add_ps(a1, p); else a0 = _mm_add_ps(a0, p);
+	    }
+	  };
+
+	  struct dot_c2   // 2 complex taps (doubled) per vector
+	  {
+	    const float* w;
+	    __m128 a0, a1;
+	    template<int J> inline void step()
+	    {
+	      const __m128 p = _mm_mul_ps(_mm_load_ps(rev::v2 + 4 * J), _mm_loadu_ps(w + 4 * J));
+	      if (J & 1) a1 = _mm_add_ps(a1, p); else a0 = _mm_add_ps(a0, p);
+	    }
+	  };
+
+	  // ---------------- D == 1: S consecutive outputs per vector ----------------
+	  // p = oldest sample of the first output, S floats per output (1 real, 2 complex);
+	  // lane block of the window sample at distance K from the newest
+	  template<int S>
+	  struct par
+	  {
+	    const float* p;
+	    __m128 a0, a1;     // outputs [0, 4/S) and [4/S, 8/S)
+	    template<int K> inline void step()
+	    {
+	      const __m128 h = _mm_set1_ps(Taps::h[K]);
+	      const float* n = p + S * (N - 1 - K);
+	      __m128 x0 = _mm_loadu_ps(n), x1 = _mm_loadu_ps(n + 4);
+	      if (Taps::symmetric) {
+		const float* o = p + S * K;
+		x0 = _mm_add_ps(x0, _mm_loadu_ps(o));
+		x1 = _mm_add_ps(x1, _mm_loadu_ps(o + 4));
+	      }
+	      a0 = _mm_add_ps(a0, _mm_mul_ps(h, x0));
+	      a1 = _mm_add_ps(a1, _mm_mul_ps(h, x1));
+	    }
+	    inline void mid()
+	    {
+	      if (Taps::symmetric && (N & 1)) {
+		const __m128 h = _mm_set1_ps(Taps::h[N / 2]);
+		const float* m = p + S * (N / 2);
+		a0 = _mm_add_ps(a0, _mm_mul_ps(h, _mm_loadu_ps(m)));
+		a1 = _mm_add_ps(a1, _mm_mul_ps(h, _mm_loadu_ps(m + 4)));
+	      }
+	    }
+	  };
+#endif
+
+	  static inline float dot(const float* w)
+	  {
+#if defined(__SSE__)
+	    dot_f4 v = { w, _mm_setzero_ps(), _mm_setzero_ps() };
+	    fixed_fir_for<0, N / 4>::run(v);
+	    dot_f t = { w, 0.0f, 0.0f };
+	    fixed_fir_for<N & ~3, N>::run(t);
+	    float s[4];
+	    _mm_storeu_ps(s, _mm_add_ps(v.a0, v.a1));
+	    return ((s[0] + s[1]) + (s[2] + s[3])) + (t.s0 + t.s1);
+#else
+	    dot_f t = { w, 0.0f, 0.0f };
+	    fixed_fir_for<0, N>::run(t);
+	    return t.s0 + t.s1;
+#endif
+	  }
+
+	  static inline gr_complex dot(const gr_complex* wc)
+	  {
+	    const float* w = reinterpret_cast<const float*>(wc);
+#if defined(__SSE__)
+	    dot_c2 v = { w, _mm_setzero_ps(), _mm_setzero_ps() };
+	    fixed_fir_for<0, N / 2>::run(v);
+	    dot_c t = { w, 0.0f, 0.0f, 0.0f, 0.0f };
+	    fixed_fir_for<N & ~1, N>::run(t);
+	    float s[4];
+	    _mm_storeu_ps(s, _mm_add_ps(v.a0, v.a1));
+	    return gr_complex(s[0] + s[2] + t.r0 + t.r1, s[1] + s[3] + t.i0 + t.i1);
+#else
+	    dot_c t = { w, 0.0f, 0.0f, 0.0f, 0.0f };
+	    fixed_fir_for<0, N>::run(t);
+	    return gr_complex(t.r0 + t.r1, t.i0 + t.i1);
+#endif
+	  }
+
+	  //! nout outputs; in holds (nout-1)*D + N samples, oldest first
+	  template<typename T>
+	  static void filter(const T* in, T* out, int nout)
+	  {
+	    int i = 0;
+#if defined(__SSE__)
+	    if (D == 1) {
+	      const int S = sizeof(T) / sizeof(float);   // floats per sample
+	      const int V = 8 / S;                       // outputs per pass
+	      for (; i + V <= nout; i += V) {
+		par<sizeof(T) / sizeof(float)> a = {
+		  reinterpret_cast<const float*>(in + i), _mm_setzero_ps(), _mm_setzero_ps() };
+		fixed_fir_for<0, H>::run(a);
+		a.mid();
+		float* o = reinterpret_cast<float*>(out + i);
+		_mm_storeu_ps(o, a.a0);
+		_mm_storeu_ps(o + 4, a.a1);
+	      }
+	    }
+#endif
+	    for (; i < nout; ++i)
+	      out[i] = dot(in + i * D);
+	  }
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_FIXED_FIR_H */
@@ -0,0 +1,51 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_FIXED_FIR_IMPL_H
+#define INCLUDED_HOWTO_FIXED_FIR_IMPL_H
+
+#include <gnuradio/io_signature.h>
+#include <gnuradio/sync_decimator.h>
+#include "fixed_fir.h"
+#include <vector>
+
+namespace gr { namespace howto {
+
+/*!
+ * Common implementation of the generated fixed-tap blocks
+ * (apps/howto_fixed_fir_gen.py). Iface is the generated public interface,
+ * Taps its compile-time tap set, T the sample type (float or gr_complex).
+ * Nothing is configurable at run time: history(N) and decimation D are
+ * set once, and work() runs fixed_fir straight on the input buffer.
+ */
+template<class Iface, class Taps, typename T, int D>
+class fixed_fir_impl final : public Iface
+{
+public:
+  explicit fixed_fir_impl(const char* name)
+  : gr::sync_decimator(name,
+        gr::io_signature::make(1, 1, sizeof(T)),
+        gr::io_signature::make(1, 1, sizeof(T)),
+        D)
+  {
+    this->set_history(Taps::N);
+  }
+
+  ~fixed_fir_impl() override {}
+
+  std::vector<float> taps() const override
+  {
+    return std::vector<float>(Taps::h, Taps::h + Taps::N);
+  }
+
+  int work(int noutput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items) override
+  {
+    const T* in  = static_cast<const T*>(input_items[0]);
+    T*       out = static_cast<T*>(output_items[0]);
+    fixed_fir<Taps, D>::filter(in, out, noutput_items);
+    return noutput_items;
+  }
+};
+
+}} // namespace
+#endif
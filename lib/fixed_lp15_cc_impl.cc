@@ -0,0 +1,32 @@
+/* -*- c++ -*- */
+/* Generado por apps/howto_fixed_fir_gen.py desde lib/fixed_taps/lp15.taps; no editar. */
+#include <howto/fixed_lp15_cc.h>
+#include "fixed_fir_impl.h"
+
+namespace gr { namespace howto {
+
+namespace {
+
+struct fixed_lp15_cc_taps
+{
+  static constexpr int   N = 15;
+  static constexpr bool  symmetric = true;
+  static constexpr float h[N] = {
+    -2.429962048e-04f, -2.913504925e-03f, -7.293703932e-03f, 3.282709962e-18f,
+    4.206162808e-02f, 1.253100634e-01f, 2.154967337e-01f, 2.551635598e-01f,
+    2.154967337e-01f, 1.253100634e-01f, 4.206162808e-02f, 3.282709962e-18f,
+    -7.293703932e-03f, -2.913504925e-03f, -2.429962048e-04f
+  };
+};
+
+constexpr float fixed_lp15_cc_taps::h[];
+
+} // namespace
+
+fixed_lp15_cc::sptr fixed_lp15_cc::make()
+{
+  return gnuradio::get_initial_sptr(
+      new fixed_fir_impl<fixed_lp15_cc, fixed_lp15_cc_taps, gr_complex, 1>("fixed_lp15_cc"));
+}
+
+}} // namespace
@@ -0,0 +1,36 @@
+/* -*- c++ -*- */
+/* Generado por apps/howto_fixed_fir_gen.py desde lib/fixed_taps/lp31.taps; no editar. */
+#include <howto/fixed_lp31_cc.h>
+#include "fixed_fir_impl.h"
+
+namespace gr { namespace howto {
+
+namespace {
+
+struct fixed_lp31_cc_taps
+{
+  static constexpr int   N = 31;
+  static constexpr bool  symmetric = true;
+  static constexpr float h[N] = {
+    -1.110672479e-04f, -5.237041722e-04f, -8.497537074e-04f, 8.557021649e-19f,
+    2.881269620e-03f, 6.643298734e-03f, 7.273291787e-03f, -3.753191078e-18f,
+    -1.569494872e-02f, -3.157029783e-02f, -3.152812833e-02f, 7.775397920e-18f,
+    6.612840284e-02f, 1.504872740e-01f, 2.219051171e-01f, 2.499184918e-01f,
+    2.219051171e-01f, 1.504872740e-01f, 6.612840284e-02f, 7.775397920e-18f,
+    -3.152812833e-02f, -3.157029783e-02f, -1.569494872e-02f, -3.753191078e-18f,
+    7.273291787e-03f, 6.643298734e-03f, 2.881269620e-03f, 8.557021649e-19f,
+    -8.497537074e-04f, -5.237041722e-04f, -1.110672479e-04f
+  };
+};
+
+constexpr float fixed_lp31_cc_taps::h[];
+
+} // namespace
+
+fixed_lp31_cc::sptr fixed_lp31_cc::make()
+{
+  return gnuradio::get_initial_sptr(
+      new fixed_fir_impl<fixed_lp31_cc, fixed_lp31_cc_taps, gr_complex, 1>("fixed_lp31_cc"));
+}
+
+}} // namespace
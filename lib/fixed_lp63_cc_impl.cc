@@ -0,0 +1,44 @@
+/* -*- c++ -*- */
+/* Generado por apps/howto_fixed_fir_gen.py desde lib/fixed_taps/lp63.taps; no editar. */
+#include <howto/fixed_lp63_cc.h>
+#include "fixed_fir_impl.h"
+
+namespace gr { namespace howto {
+
+namespace {
+
+struct fixed_lp63_cc_taps
+{
+  static constexpr int   N = 63;
+  static constexpr bool  symmetric = true;
+  static constexpr float h[N] = {
+    -5.375970004e-05f, -1.467321398e-04f, -1.737578127e-04f, 3.252117298e-19f,
+    3.922502066e-04f, 7.796782392e-04f, 7.515823182e-04f, -1.038926148e-18f,
+    -1.303316076e-03f, -2.362116684e-03f, -2.109556222e-03f, 2.278367679e-18f,
+    3.245753997e-03f, 5.609015622e-03f, 4.806674416e-03f, -4.007052703e-18f,
+    -6.918890012e-03f, -1.164739518e-02f, -9.767087262e-03f, 6.003024818e-18f,
+    1.365175683e-02f, 2.282363054e-02f, 1.912667032e-02f, -7.891864723e-18f,
+    -2.737469887e-02f, -4.715371065e-02f, -4.148737993e-02f, 9.250443330e-18f,
+    7.286197154e-02f, 1.571000996e-01f, 2.243494194e-01f, 2.499997949e-01f,
+    2.243494194e-01f, 1.571000996e-01f, 7.286197154e-02f, 9.250443330e-18f,
+    -4.148737993e-02f, -4.715371065e-02f, -2.737469887e-02f, -7.891864723e-18f,
+    1.912667032e-02f, 2.282363054e-02f, 1.365175683e-02f, 6.003024818e-18f,
+    -9.767087262e-03f, -1.164739518e-02f, -6.918890012e-03f, -4.007052703e-18f,
+    4.806674416e-03f, 5.609015622e-03f, 3.245753997e-03f, 2.278367679e-18f,
+    -2.109556222e-03f, -2.362116684e-03f, -1.303316076e-03f, -1.038926148e-18f,
+    7.515823182e-04f, 7.796782392e-04f, 3.922502066e-04f, 3.252117298e-19f,
+    -1.737578127e-04f, -1.467321398e-04f, -5.375970004e-05f
+  };
+};
+
+constexpr float fixed_lp63_cc_taps::h[];
+
+} // namespace
+
+fixed_lp63_cc::sptr fixed_lp63_cc::make()
+{
+  return gnuradio::get_initial_sptr(
+      new fixed_fir_impl<fixed_lp63_cc, fixed_lp63_cc_taps, gr_complex, 1>("fixed_lp63_cc"));
+}
+
+}} // namespace
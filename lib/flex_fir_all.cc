@@ -5,22 +5,51 @@
 #include "flex_fir_ff_impl.h"
 #include "flex_fir_cc_impl.h"
 #include "flex_fir_cf_impl.h"
+#include "flex_fir_sc_impl.h"
+#include <howto/flex_fir_sc16c.h>
+#include <howto/flex_fir_sc8c.h>
+#include <stdexcept>
 
 namespace gr { namespace howto {
 
-flex_fir_ff::sptr flex_fir_ff::make(int mode, float fs, float f1, float f2, float w, float g)
+flex_fir_ff::sptr flex_fir_ff::make(int mode, float fs, float f1, float f2, float w, float g,
+                                    float atten, float ripple)
 {
-  return gnuradio::get_initial_sptr(new flex_fir_ff_impl(mode, fs, f1, f2, w, g));
+  return gnuradio::get_initial_sptr(new flex_fir_ff_impl(mode, fs, f1, f2, w, g, atten, ripple));
 }
 
-flex_fir_cc::sptr flex_fir_cc::make(int mode, float fs, float f1, float f2, float w, float g)
+flex_fir_cc::sptr flex_fir_cc::make(int mode, float fs, float f1, float f2, float w, float g,
+                                    float atten, float ripple)
 {
-  return gnuradio::get_initial_sptr(new flex_fir_cc_impl(mode, fs, f1, f2, w, g));
+  return gnuradio::get_initial_sptr(new flex_fir_cc_impl(mode, fs, f1, f2, w, g, atten, ripple));
 }
 
-flex_fir_cf::sptr flex_fir_cf::make(int mode, float fs, float f1, float f2, float w, float g)
+flex_fir_cf::sptr flex_fir_cf::make(int mode, float fs, float f1, float f2, float w, float g,
+                                    int output, float atten, float ripple)
 {
-  return gnuradio::get_initial_sptr(new flex_fir_cf_impl(mode, fs, f1, f2, w, g));
+  switch (output) {
+  case OUT_REAL: return gnuradio::get_initial_sptr(new flex_fir_cf_impl<FLEX_FIR_CF_REAL>(mode, fs, f1, f2, w, g, atten, ripple));
+  case OUT_IMAG: return gnuradio::get_initial_sptr(new flex_fir_cf_impl<FLEX_FIR_CF_IMAG>(mode, fs, f1, f2, w, g, atten, ripple));
+  case OUT_MAG:  return gnuradio::get_initial_sptr(new flex_fir_cf_impl<FLEX_FIR_CF_MAG>(mode, fs, f1, f2, w, g, atten, ripple));
+  default:
+    throw std::invalid_argument("flex_fir_cf: output must be 0 (real), 1 (imag) or 2 (mag)");
+  }
+}
+
+flex_fir_sc16c::sptr flex_fir_sc16c::make(int mode, float fs, float f1, float f2, float w, float g,
+                                          bool fixed_point, float atten, float ripple)
+{
+  return gnuradio::get_initial_sptr(
+      new flex_fir_sc_impl<int16_t, flex_fir_sc16c>("flex_fir_sc16c", mode, fs, f1, f2, w, g, fixed_point,
+                                                   atten, ripple));
+}
+
+flex_fir_sc8c::sptr flex_fir_sc8c::make(int mode, float fs, float f1, float f2, float w, float g,
+                                        bool fixed_point, float atten, float ripple)
+{
+  return gnuradio::get_initial_sptr(
+      new flex_fir_sc_impl<int8_t, flex_fir_sc8c>("flex_fir_sc8c", mode, fs, f1, f2, w, g, fixed_point,
+                                                 atten, ripple));
 }
 
 }} // namespace
@@ -0,0 +1,180 @@
+#include "flex_fir_bank_ff_impl.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+#include <algorithm>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace gr { namespace howto {
+
+flex_fir_bank_ff::sptr flex_fir_bank_ff::make(float fs,
+                                              const std::vector<int>& modes,
+                                              const std::vector<float>& f1,
+                                              const std::vector<float>& f2,
+                                              const std::vector<float>& width,
+                                              const std::vector<float>& gain)
+{
+  const size_t K = modes.size();
+  if (K < 1 || K > 64)
+    throw std::invalid_argument("flex_fir_bank_ff: 1..64 bands");
+  if (f1.size() != K || f2.size() != K || width.size() != K || gain.size() != K)
+    throw std::invalid_argument("flex_fir_bank_ff: one mode/f1/f2/width/gain per band");
+
+  return gnuradio::get_initial_sptr(new flex_fir_bank_ff_impl(fs, modes, f1, f2, width, gain));
+}
+
+flex_fir_bank_ff_impl::flex_fir_bank_ff_impl(float fs,
+                                             const std::vector<int>& modes,
+                                             const std::vector<float>& f1,
+                                             const std::vector<float>& f2,
+                                             const std::vector<float>& width,
+                                             const std::vector<float>& gain)
+: gr::sync_block("flex_fir_bank_ff",
+      gr::io_signature::make(1, 1, sizeof(float)),
+      gr::io_signature::make(1, (int)modes.size(), sizeof(float))),
+  d_fs(fs), d_bands(modes.size()), d_dirty(true), d_T(0), d_Bp(0)
+{
+  for (size_t b = 0; b < modes.size(); ++b) {
+    band_& x = d_bands[b];
+    x.mode = modes[b]; x.f1 = f1[b]; x.f2 = f2[b]; x.width = width[b]; x.gain = gain[b];
+  }
+  boost::lock_guard<boost::mutex> g(d_mutex);
+  design_locked_();
+}
+
+void flex_fir_bank_ff_impl::design_locked_()
+{
+  const int K = (int)d_bands.size();
+  int T = 1;
+  for (int b = 0; b < K; ++b) {
+    band_& x = d_bands[b];
+    x.taps = flex_fir_design(x.mode, d_fs, x.f1, x.f2, x.width, x.gain);
+    T = std::max(T, (int)x.taps.size());
+  }
+
+  // Zero-pad every band at the old end (keeps its delay, so the output is
+  // identical to flex_fir_ff) and interleave, oldest sample first
+  const int Bp = (K + 3) & ~3;
+  d_H.assign((size_t)T * Bp, 0.0f);
+  for (int b = 0; b < K; ++b) {
+    const std::vector<float>& h = d_bands[b].taps;
+    for (size_t k = 0; k < h.size(); ++k)
+      d_H[(size_t)(T - 1 - k) * Bp + b] = h[k];
+  }
+
+  // The delay line survives a re-design (keep the newest samples)
+  std::vector<float> hist(T - 1, 0.0f);
+  const int keep = std::min((int)d_hist.size(), T - 1);
+  std::copy(d_hist.end() - keep, d_hist.end(), hist.end() - keep);
+  d_hist.swap(hist);
+
+  d_T = T;
+  d_Bp = Bp;
+  d_acc.assign(Bp, 0.0f);
+  d_dirty = false;
+}
+
+void flex_fir_bank_ff_impl::set_samp_rate(float fs) noexcept
+{
+  boost::lock_guard<boost::mutex> g(d_mutex);
+  d_fs = fs; d_dirty = true;
+}
+
+float flex_fir_bank_ff_impl::samp_rate() const noexcept
+{
+  boost::lock_guard<boost::mutex> g(d_mutex);
+  return d_fs;
+}
+
+void flex_fir_bank_ff_impl::set_band(int band, int mode, float f1, float f2, float width, float gain)
+{
+  if (band < 0 || band >= (int)d_bands.size())
+    throw std::out_of_range("flex_fir_bank_ff: band index");
+  boost::lock_guard<boost::mutex> g(d_mutex);
+  band_& x = d_bands[band];
+  x.mode = mode; x.f1 = f1; x.f2 = f2; x.width = width; x.gain = gain;
+  d_dirty = true;
+}
+
+std::vector<float> flex_fir_bank_ff_impl::taps(int band) const
+{
+  if (band < 0 || band >= (int)d_bands.size())
+    throw std::out_of_range("flex_fir_bank_ff: band index");
+  boost::lock_guard<boost::mutex> g(d_mutex);
+  return d_bands[band].taps;
+}
+
+int flex_fir_bank_ff_impl::ntaps() const noexcept
+{
+  boost::lock_guard<boost::mutex> g(d_mutex);
+  return d_T;
+}
+
+// acc[b] = sum_k H[k*Bp + b] * w[k]: one broadcast input, Bp/4 band vectors
+static inline void bank_dot_(const float* w, const float* H, int T, int Bp, float* acc)
+{
+#if defined(__SSE__)
+  if (Bp <= 16) {
+    __m128 a0 = _mm_setzero_ps(), a1 = a0, a2 = a0, a3 = a0;
+    for (int k = 0; k < T; ++k, H += Bp) {
+      const __m128 x = _mm_set1_ps(w[k]);
+      a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(H), x));
+      if (Bp > 4)  a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(H + 4), x));
+      if (Bp > 8)  a2 = _mm_add_ps(a2, _mm_mul_ps(_mm_loadu_ps(H + 8), x));
+      if (Bp > 12) a3 = _mm_add_ps(a3, _mm_mul_ps(_mm_loadu_ps(H + 12), x));
+    }
+    _mm_storeu_ps(acc, a0);
+    if (Bp > 4)  _mm_storeu_ps(acc + 4, a1);
+    if (Bp > 8)  _mm_storeu_ps(acc + 8, a2);
+    if (Bp > 12) _mm_storeu_ps(acc + 12, a3);
+    return;
+  }
+  // more than 16 bands: band groups of 4 in memory order
+  for (int g = 0; g < Bp; g += 4) {
+    __m128 a = _mm_setzero_ps();
+    const float* h = H + g;
+    for (int k = 0; k < T; ++k, h += Bp)
+      a = _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(h), _mm_set1_ps(w[k])));
+    _mm_storeu_ps(acc + g, a);
+  }
+#else
+  std::fill(acc, acc + Bp, 0.0f);
+  for (int k = 0; k < T; ++k, H += Bp)
+    for (int b = 0; b < Bp; ++b) acc[b] += H[b] * w[k];
+#endif
+}
+
+int flex_fir_bank_ff_impl::work(int noutput_items,
+                                gr_vector_const_void_star &input_items,
+                                gr_vector_void_star &output_items)
+{
+  const float* in = static_cast<const float*>(input_items[0]);
+
+  {
+    boost::lock_guard<boost::mutex> g(d_mutex);
+    if (d_dirty) design_locked_();
+  }
+
+  const int T = d_T, Bp = d_Bp;
+  const int nouts = (int)output_items.size();   // connected outputs
+
+  // Concatena historial + entrada (una sola copia para todas las bandas)
+  d_buf.resize(T - 1 + noutput_items);
+  std::copy(d_hist.begin(), d_hist.end(), d_buf.begin());
+  std::copy(in, in + noutput_items, d_buf.begin() + (T - 1));
+
+  float* acc = &d_acc[0];
+  for (int n = 0; n < noutput_items; ++n) {
+    bank_dot_(&d_buf[n], &d_H[0], T, Bp, acc);
+    for (int b = 0; b < nouts; ++b)
+      static_cast<float*>(output_items[b])[n] = acc[b];
+  }
+
+  if (T > 1)
+    std::copy(d_buf.end() - (T - 1), d_buf.end(), d_hist.begin());
+  return noutput_items;
+}
+
+}} // namespace
@@ -0,0 +1,60 @@
+#ifndef INCLUDED_HOWTO_FLEX_FIR_BANK_FF_IMPL_H
+#define INCLUDED_HOWTO_FLEX_FIR_BANK_FF_IMPL_H
+
+#include <howto/flex_fir_bank_ff.h>
+#include "flex_fir_impl_base.h"
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+namespace gr { namespace howto {
+
+class flex_fir_bank_ff_impl final : public flex_fir_bank_ff
+{
+private:
+  struct band_
+  {
+    int   mode;
+    float f1, f2, width, gain;
+    std::vector<float> taps;
+  };
+
+  mutable boost::mutex d_mutex;
+  float d_fs;
+  std::vector<band_> d_bands;
+  bool  d_dirty;
+
+  // Work-thread state (rebuilt from work() when dirty)
+  int   d_T;                     // common length
+  int   d_Bp;                    // bands rounded up to 4
+  std::vector<float> d_H;        // d_H[k*Bp + b] = h_b[T-1-k] (oldest first)
+  std::vector<float> d_hist;     // last T-1 inputs, shared by every band
+  std::vector<float> d_buf;
+  std::vector<float> d_acc;
+
+  void design_locked_();         // assumes d_mutex locked
+
+public:
+  flex_fir_bank_ff_impl(float fs,
+                        const std::vector<int>& modes,
+                        const std::vector<float>& f1,
+                        const std::vector<float>& f2,
+                        const std::vector<float>& width,
+                        const std::vector<float>& gain);
+  ~flex_fir_bank_ff_impl() override {}
+
+  int   nbands() const noexcept override { return (int)d_bands.size(); }
+
+  void  set_samp_rate(float fs) noexcept override;
+  float samp_rate() const noexcept override;
+
+  void  set_band(int band, int mode, float f1, float f2, float width, float gain) override;
+  std::vector<float> taps(int band) const override;
+  int   ntaps() const noexcept override;
+
+  int work(int noutput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items) override;
+};
+
+}} // namespace
+#endif
@@ -10,11 +10,12 @@ class flex_fir_cc_impl final : public flex_fir_cc,
                                public flex_fir_impl_base<std::complex<float>, std::complex<float>>
 {
 public:
-  flex_fir_cc_impl(int mode, float fs, float f1, float f2, float w, float g)
+  flex_fir_cc_impl(int mode, float fs, float f1, float f2, float w, float g,
+                   float atten, float ripple)
   : gr::sync_block("flex_fir_cc",
         gr::io_signature::make(1,1,sizeof(gr_complex)),
         gr::io_signature::make(1,1,sizeof(gr_complex))),
-    flex_fir_impl_base<std::complex<float>, std::complex<float>>(mode,fs,f1,f2,w,g)
+    flex_fir_impl_base<std::complex<float>, std::complex<float>>(mode,fs,f1,f2,w,g,atten,ripple)
   {}
 
   ~flex_fir_cc_impl() override {}
@@ -39,6 +40,21 @@ public:
 
   std::vector<float> taps() const override  { return flex_fir_impl_base::taps(); }
 
+  void  set_attenuation(float db) noexcept override { flex_fir_impl_base::set_attenuation(db); }
+  float attenuation() const noexcept override       { return flex_fir_impl_base::attenuation(); }
+
+  void  set_ripple(float db) noexcept override { flex_fir_impl_base::set_ripple(db); }
+  float ripple() const noexcept override       { return flex_fir_impl_base::ripple(); }
+
+  int   ntaps() const noexcept override           { return flex_fir_impl_base::ntaps(); }
+  int   macs_per_sample() const noexcept override { return flex_fir_impl_base::macs_per_sample_(2); }
+
+  void  set_threads(int n, const std::vector<int>& cores) override { flex_fir_impl_base::set_threads(n, cores); }
+  int   threads() const noexcept override { return flex_fir_impl_base::threads(); }
+
+  void  set_accumulation(int acc) override        { flex_fir_impl_base::set_accumulation(acc); }
+  int   accumulation() const noexcept override    { return flex_fir_impl_base::accumulation(); }
+
   int work(int noutput_items,
            gr_vector_const_void_star &input_items,
            gr_vector_void_star &output_items) override;
@@ -1,22 +1,33 @@
 #include "flex_fir_cf_impl.h"
-#include "flex_fir_kernel.cc"
 #include <gnuradio/gr_complex.h>
 
 namespace gr { namespace howto {
 
-int flex_fir_cf_impl::work(int noutput_items,
-                           gr_vector_const_void_star &input_items,
-                           gr_vector_void_star &output_items)
+template<int Part>
+int flex_fir_cf_impl<Part>::work(int noutput_items,
+                                 gr_vector_const_void_star &input_items,
+                                 gr_vector_void_star &output_items)
 {
   const gr_complex* in  = static_cast<const gr_complex*>(input_items[0]);
   float*            out = static_cast<float*>(output_items[0]);
 
   std::vector<float> taps;
   int m; float fs,f1,f2,w,g;
-  snapshot_params_(m,fs,f1,f2,w,g,taps);
+  this->snapshot_params_(m,fs,f1,f2,w,g,taps);
 
-  return flex_fir_work_body<std::complex<float>, float>(noutput_items, in, out, d_hist, taps);
+  boost::shared_ptr<fir_worker_pool> pool = this->pool_snapshot_();
+  switch (this->accumulation()) {
+  case FIR_ACC_SPLIT:
+    return flex_fir_cf_work_body<Part, fir_acc_split>(noutput_items, in, out, this->d_hist, this->d_fold, pool.get());
+  case FIR_ACC_DOUBLE:
+    return flex_fir_cf_work_body<Part, fir_acc_double>(noutput_items, in, out, this->d_hist, this->d_fold, pool.get());
+  default:
+    return flex_fir_cf_work_body<Part>(noutput_items, in, out, this->d_hist, this->d_fold, pool.get());
+  }
 }
 
-}} // namespace
+template class flex_fir_cf_impl<FLEX_FIR_CF_REAL>;
+template class flex_fir_cf_impl<FLEX_FIR_CF_IMAG>;
+template class flex_fir_cf_impl<FLEX_FIR_CF_MAG>;
 
+}} // namespace
@@ -3,41 +3,64 @@
 
 #include <howto/flex_fir_cf.h>
 #include "flex_fir_impl_base.h"
+#include "flex_fir_kernel.cc"
 
 namespace gr { namespace howto {
 
+// Part = FLEX_FIR_CF_REAL / _IMAG / _MAG: the history holds only what the kernel reads
+template<int Part>
 class flex_fir_cf_impl final : public flex_fir_cf,
-                               public flex_fir_impl_base<std::complex<float>, float>
+                               public flex_fir_impl_base<typename flex_fir_cf_hist<Part>::type, float>
 {
+  typedef flex_fir_impl_base<typename flex_fir_cf_hist<Part>::type, float> base;
+
 public:
-  flex_fir_cf_impl(int mode, float fs, float f1, float f2, float w, float g)
+  flex_fir_cf_impl(int mode, float fs, float f1, float f2, float w, float g,
+                   float atten, float ripple)
   : gr::sync_block("flex_fir_cf",
         gr::io_signature::make(1,1,sizeof(gr_complex)),
         gr::io_signature::make(1,1,sizeof(float))),
-    flex_fir_impl_base<std::complex<float>, float>(mode,fs,f1,f2,w,g)
+    base(mode,fs,f1,f2,w,g,atten,ripple)
   {}
 
   ~flex_fir_cf_impl() override {}
 
-  void  set_mode(int m) noexcept override { flex_fir_impl_base::set_mode(m); }
-  int   mode() const noexcept override    { return flex_fir_impl_base::mode(); }
+  void  set_mode(int m) noexcept override { base::set_mode(m); }
+  int   mode() const noexcept override    { return base::mode(); }
+
+  void  set_samp_rate(float fs) noexcept override { base::set_samp_rate(fs); }
+  float samp_rate() const noexcept override       { return base::samp_rate(); }
+
+  void  set_f1(float f) noexcept override { base::set_f1(f); }
+  float f1() const noexcept override      { return base::f1(); }
+
+  void  set_f2(float f) noexcept override { base::set_f2(f); }
+  float f2() const noexcept override      { return base::f2(); }
 
-  void  set_samp_rate(float fs) noexcept override { flex_fir_impl_base::set_samp_rate(fs); }
-  float samp_rate() const noexcept override       { return flex_fir_impl_base::samp_rate(); }
+  void  set_width(float w) noexcept override { base::set_width(w); }
+  float width() const noexcept override      { return base::width(); }
 
-  void  set_f1(float f) noexcept override { flex_fir_impl_base::set_f1(f); }
-  float f1() const noexcept override      { return flex_fir_impl_base::f1(); }
+  void  set_gain(float g) noexcept override { base::set_gain(g); }
+  float gain() const noexcept override      { return base::gain(); }
 
-  void  set_f2(float f) noexcept override { flex_fir_impl_base::set_f2(f); }
-  float f2() const noexcept override      { return flex_fir_impl_base::f2(); }
+  std::vector<float> taps() const override  { return base::taps(); }
 
-  void  set_width(float w) noexcept override { flex_fir_impl_base::set_width(w); }
-  float width() const noexcept override      { return flex_fir_impl_base::width(); }
+  void  set_attenuation(float db) noexcept override { base::set_attenuation(db); }
+  float attenuation() const noexcept override       { return base::attenuation(); }
 
-  void  set_gain(float g) noexcept override { flex_fir_impl_base::set_gain(g); }
-  float gain() const noexcept override      { return flex_fir_impl_base::gain(); }
+  void  set_ripple(float db) noexcept override { base::set_ripple(db); }
+  float ripple() const noexcept override       { return base::ripple(); }
 
-  std::vector<float> taps() const override  { return flex_fir_impl_base::taps(); }
+  int   ntaps() const noexcept override           { return base::ntaps(); }
+  int   macs_per_sample() const noexcept override { return base::macs_per_sample_(Part == FLEX_FIR_CF_MAG ? 2 : 1); }
+
+  void  set_threads(int n, const std::vector<int>& cores) override { base::set_threads(n, cores); }
+  int   threads() const noexcept override { return base::threads(); }
+
+  void  set_accumulation(int acc) override        { base::set_accumulation(acc); }
+  int   accumulation() const noexcept override    { return base::accumulation(); }
+
+  int   output() const noexcept override    { return Part; }
 
   int work(int noutput_items,
            gr_vector_const_void_star &input_items,
@@ -46,4 +69,3 @@ public:
 
 }} // namespace
 #endif
-
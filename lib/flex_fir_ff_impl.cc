@@ -14,7 +14,15 @@ int flex_fir_ff_impl::work(int noutput_items,
   int m; float fs,f1,f2,w,g;
   snapshot_params_(m,fs,f1,f2,w,g,taps);
 
-  return flex_fir_work_body<float,float>(noutput_items, in, out, d_hist, taps);
+  boost::shared_ptr<fir_worker_pool> pool = pool_snapshot_();
+  switch (accumulation()) {
+  case FIR_ACC_SPLIT:
+    return flex_fir_work_body<float,float,fir_acc_split>(noutput_items, in, out, d_hist, d_fold, pool.get());
+  case FIR_ACC_DOUBLE:
+    return flex_fir_work_body<float,float,fir_acc_double>(noutput_items, in, out, d_hist, d_fold, pool.get());
+  default:
+    return flex_fir_work_body<float,float>(noutput_items, in, out, d_hist, d_fold, pool.get());
+  }
 }
 
 }} // namespace
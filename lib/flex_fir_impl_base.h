@@ -7,11 +7,108 @@
 #include <cmath>
 #include <complex>
 #include <algorithm>
+#include <stdexcept>
+#include "fir_fold.h"
+#include "fir_worker_pool.h"
+#include <boost/shared_ptr.hpp>
 
 namespace gr { namespace howto {
 
 enum { FLEX_FIR_LP = 0, FLEX_FIR_HP = 1, FLEX_FIR_BP = 2 };
 
+static inline float flex_fir_sinc_(float x) { return x == 0.0f ? 1.0f : std::sin(M_PI*x)/(M_PI*x); }
+
+static inline double flex_fir_i0_(double x)
+{
+  double s = 1.0, t = 1.0;
+  for (int k = 1; k < 64 && t > 1e-12 * s; ++k) {
+    const double q = x / (2.0 * k);
+    t *= q * q;
+    s += t;
+  }
+  return s;
+}
+
+/*!
+ * Equivalent attenuation (dB) of a spec: a windowed design has the same
+ * ripple delta in both bands, so the passband ripple (peak, dB) can be the
+ * tighter limit. 0 = no spec.
+ */
+static inline float flex_fir_spec_db(float atten_db, float ripple_db)
+{
+  float a = std::max(0.0f, atten_db);
+  if (ripple_db > 0.0f) {
+    const double r = std::pow(10.0, ripple_db / 20.0);
+    a = std::max(a, (float)(-20.0 * std::log10((r - 1.0) / (r + 1.0))));
+  }
+  return a;
+}
+
+/*!
+ * Number of taps flex_fir_design produces (always odd).
+ * Without a spec: N ~ 4*fs/width (Hamming). With one: Kaiser's estimate
+ * N = (A - 7.95) / (14.36 * width/fs) + 1, i.e. only as long as the
+ * attenuation needs (about 2.2*fs/width at 40 dB, 3.6*fs/width at 60 dB).
+ */
+static inline size_t flex_fir_ntaps(float fs, float width, float atten_db, float ripple_db)
+{
+  const float tw = std::max(1.0f, width);
+  const float A = flex_fir_spec_db(atten_db, ripple_db);
+  size_t N;
+  if (A > 0.0f)
+    N = static_cast<size_t>(std::ceil(std::max(0.0f, A - 7.95f) * fs / (14.36f * tw))) + 1;
+  else
+    N = static_cast<size_t>(std::ceil(4.0f * fs / tw)); // regla simple
+  return N | 1; // impar
+}
+
+/*!
+ * Taps of one flex_fir band (shared by flex_fir_* and flex_fir_bank_ff).
+ * Diseño rápido estilo firdes “casero”: ventana + sinc.
+ * width = ancho de transición (Hz). Sin especificación (atten_db y
+ * ripple_db <= 0): Hamming con N ~ 4*fs/width. Con especificación: Kaiser
+ * con el largo y el beta mínimos para A dB (ver flex_fir_ntaps).
+ */
+static inline std::vector<float>
+flex_fir_design(int mode, float fs, float f1, float f2, float width, float gain,
+                float atten_db = 0.0f, float ripple_db = 0.0f)
+{
+  const size_t N = flex_fir_ntaps(fs, width, atten_db, ripple_db);
+  const float A = flex_fir_spec_db(atten_db, ripple_db);
+
+  // Kaiser beta (Kaiser & Schafer)
+  double beta = 0.0;
+  if (A > 50.0f)      beta = 0.1102 * (A - 8.7);
+  else if (A > 21.0f) beta = 0.5842 * std::pow(A - 21.0, 0.4) + 0.07886 * (A - 21.0);
+  const double i0b = flex_fir_i0_(beta);
+
+  std::vector<float> h(N, 0.0f);
+  const int M = (int)N/2;
+  const float fc1 = f1 / fs; // normalizadas
+  const float fc2 = f2 / fs;
+
+  for(int n=-M; n<=M; ++n) {
+    float w;
+    if (A > 0.0f) {
+      const double r = M > 0 ? double(n) / M : 0.0;
+      w = (float)(flex_fir_i0_(beta * std::sqrt(std::max(0.0, 1.0 - r*r))) / i0b);  // Kaiser
+    } else {
+      w = 0.54f - 0.46f*std::cos(2.0f*M_PI*float(n+M)/(N-1));  // Hamming
+    }
+    float val = 0.0f;
+    if(mode == FLEX_FIR_LP) {
+      val = 2.0f*fc1*flex_fir_sinc_(2.0f*fc1*n);
+    } else if(mode == FLEX_FIR_HP) {
+      if(n==0) val = 1.0f - 2.0f*fc1;
+      else     val = -2.0f*fc1*flex_fir_sinc_(2.0f*fc1*n);
+    } else { // BP
+      val = 2.0f*fc2*flex_fir_sinc_(2.0f*fc2*n) - 2.0f*fc1*flex_fir_sinc_(2.0f*fc1*n);
+    }
+    h[n+M] = w * val * gain;   // Ganancia
+  }
+  return h;
+}
+
 template<typename Tin, typename Tout>
 class flex_fir_impl_base
 {
@@ -19,50 +116,21 @@ protected:
   mutable boost::mutex d_mutex;
   int   d_mode;
   float d_fs, d_f1, d_f2, d_width, d_gain;
+  float d_atten, d_ripple;     // spec (dB); both <= 0 -> legacy 4*fs/width rule
   std::vector<float> d_taps;
   std::vector<Tin>   d_hist;
+  fir_fold_taps      d_fold;   // d_taps + symmetry, used by the work thread
+  boost::shared_ptr<fir_worker_pool> d_pool;   // set_threads(); null = single thread
+  int   d_acc;                 // FIR_ACC_* (fir_fold.h)
   bool  d_dirty;
 
-  static inline float sinc_(float x) { return x == 0.0f ? 1.0f : std::sin(M_PI*x)/(M_PI*x); }
-
-  static std::vector<float> hamming_(size_t N)
-  {
-    std::vector<float> w(N);
-    for(size_t n=0;n<N;++n) w[n] = 0.54f - 0.46f*std::cos(2.0f*M_PI*float(n)/(N-1));
-    return w;
-  }
-
   void design_taps_()
   {
-    // Diseño rápido estilo firdes “casero”: ventana Hamming + sinc
-    // width = ancho de transición (Hz). Convertimos a N aproximado:
-    const float tw = std::max(1.0f, d_width);
-    size_t N = static_cast<size_t>(std::ceil(4.0f * d_fs / tw)); // regla simple
-    N |= 1; // impar
-
-    std::vector<float> h(N, 0.0f);
-    const int M = (int)N/2;
-    const float fc1 = d_f1 / d_fs; // normalizadas
-    const float fc2 = d_f2 / d_fs;
-
-    for(int n=-M; n<=M; ++n) {
-      float w = hamming_(N)[n+M];
-      float val = 0.0f;
-      if(d_mode == FLEX_FIR_LP) {
-        val = 2.0f*fc1*sinc_(2.0f*fc1*n);
-      } else if(d_mode == FLEX_FIR_HP) {
-        if(n==0) val = 1.0f - 2.0f*fc1;
-        else     val = -2.0f*fc1*sinc_(2.0f*fc1*n);
-      } else { // BP
-        val = 2.0f*fc2*sinc_(2.0f*fc2*n) - 2.0f*fc1*sinc_(2.0f*fc1*n);
-      }
-      h[n+M] = w * val;
-    }
-
-    // Ganancia
-    for(size_t i=0;i<N;++i) h[i] *= d_gain;
-
+    std::vector<float> h = flex_fir_design(d_mode, d_fs, d_f1, d_f2, d_width, d_gain,
+                                           d_atten, d_ripple);
+    const size_t N = h.size();
     d_taps.swap(h);
+    d_fold.set(d_taps);
     d_hist.clear();
     d_hist.resize(N-1, Tin());
   }
@@ -76,9 +144,18 @@ protected:
     taps  = d_taps;
   }
 
+  //! The work thread keeps its own reference: set_threads() may swap the pool meanwhile
+  boost::shared_ptr<fir_worker_pool> pool_snapshot_() const
+  {
+    boost::lock_guard<boost::mutex> g(d_mutex);
+    return d_pool;
+  }
+
 public:
-  flex_fir_impl_base(int mode, float fs, float f1, float f2, float width, float gain)
-  : d_mode(mode), d_fs(fs), d_f1(f1), d_f2(f2), d_width(width), d_gain(gain), d_dirty(true)
+  flex_fir_impl_base(int mode, float fs, float f1, float f2, float width, float gain,
+                     float atten_db = 0.0f, float ripple_db = 0.0f)
+  : d_mode(mode), d_fs(fs), d_f1(f1), d_f2(f2), d_width(width), d_gain(gain),
+    d_atten(atten_db), d_ripple(ripple_db), d_acc(FIR_ACC_FLOAT), d_dirty(true)
   {}
 
   void set_mode(int m) noexcept { boost::lock_guard<boost::mutex> lck(d_mutex); d_mode = m; d_dirty = true; }
@@ -99,7 +176,41 @@ public:
   void set_gain(float g) noexcept { boost::lock_guard<boost::mutex> lck(d_mutex); d_gain = g; d_dirty = true; }
   float gain() const noexcept     { boost::lock_guard<boost::mutex> lck(d_mutex); return d_gain; }
 
+  void set_attenuation(float db) noexcept { boost::lock_guard<boost::mutex> lck(d_mutex); d_atten = db; d_dirty = true; }
+  float attenuation() const noexcept     { boost::lock_guard<boost::mutex> lck(d_mutex); return d_atten; }
+
+  void set_ripple(float db) noexcept { boost::lock_guard<boost::mutex> lck(d_mutex); d_ripple = db; d_dirty = true; }
+  float ripple() const noexcept     { boost::lock_guard<boost::mutex> lck(d_mutex); return d_ripple; }
+
   std::vector<float> taps() const { boost::lock_guard<boost::mutex> lck(d_mutex); return d_taps; }
+
+  //! Length the current parameters give (valid before the first work())
+  int ntaps() const noexcept
+  {
+    boost::lock_guard<boost::mutex> lck(d_mutex);
+    return (int)flex_fir_ntaps(d_fs, d_width, d_atten, d_ripple);
+  }
+
+  void set_threads(int nthreads, const std::vector<int>& cores)
+  {
+    boost::shared_ptr<fir_worker_pool> p;
+    if (nthreads > 1) p.reset(new fir_worker_pool(nthreads, cores));   // may throw
+    boost::lock_guard<boost::mutex> lck(d_mutex);
+    d_pool.swap(p);   // the old pool is joined after the lock is released
+  }
+  int threads() const noexcept { boost::lock_guard<boost::mutex> lck(d_mutex); return d_pool ? d_pool->size() : 1; }
+
+  void set_accumulation(int acc)
+  {
+    if (acc < FIR_ACC_FLOAT || acc > FIR_ACC_DOUBLE)
+      throw std::invalid_argument("accumulation must be 0 (float), 1 (split) or 2 (double)");
+    boost::lock_guard<boost::mutex> lck(d_mutex);
+    d_acc = acc;
+  }
+  int accumulation() const noexcept { boost::lock_guard<boost::mutex> lck(d_mutex); return d_acc; }
+
+  //! Real MACs per output: the designs are linear phase, so fir_dot folds them
+  int macs_per_sample_(int lanes) const noexcept { return lanes * ((ntaps() + 1) / 2); }
 };
 
 }} // namespace
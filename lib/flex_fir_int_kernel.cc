@@ -0,0 +1,172 @@
+#ifndef INCLUDED_HOWTO_FLEX_FIR_INT_KERNEL_TCC
+#define INCLUDED_HOWTO_FLEX_FIR_INT_KERNEL_TCC
+
+#include "sc_iq.h"
+#include "fir_fold.h"
+#include <gnuradio/gr_complex.h>
+#include <volk/volk.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace gr { namespace howto {
+
+/*
+ * Kernel de flex_fir para entradas sc16/sc8.
+ *
+ * La linea de retardo se guarda como I y Q separados en int16 (el sc8 se
+ * ensancha a int16 al copiarlo), asi cada salida son dos productos punto
+ * contiguos contra los taps invertidos:
+ *   - float: I/Q pasan a float; taps simetricos -> fir_dot plegado,
+ *     si no volk_32f_x2_dot_prod_32f
+ *   - fixed: taps en int16 (Q 'shift') y pmaddwd con acumulador int32
+ */
+struct flex_fir_int_state
+{
+  // fixed point
+  std::vector<float>   taps_src;   // taps float a partir de los que se cuantizo
+  std::vector<int16_t> taps_q;     // invertidos, rellenos con ceros a multiplo de 8
+  int                  shift;      // taps_q = round(h * 2^shift); -1 si no entra en int16
+
+  // float (solo taps no simetricos)
+  std::vector<float>   taps_rev;   // invertidos
+
+  // buffers de trabajo (historial + entrada), reutilizados entre llamadas
+  std::vector<int16_t> bi, bq;
+  std::vector<float>   fi, fq;
+
+  flex_fir_int_state() : shift(-1) {}
+};
+
+/*
+ * Elige el mayor shift tal que |h_q| <= 32767 y sum|h_q| * 32768 < 2^31,
+ * es decir que ni pmaddwd ni la suma en int32 pueden desbordar con entrada
+ * full scale. Si ni con shift 0 entra (ganancias enormes) deja shift = -1
+ * y el bloque usa el camino float.
+ */
+static inline void flex_fir_quantize_taps_(const std::vector<float>& taps, flex_fir_int_state& st)
+{
+  st.taps_src = taps;
+  const int T  = (int)taps.size();
+  const int Tp = (T + 7) & ~7;
+
+  double amax = 0.0, asum = 0.0;
+  for (int k = 0; k < T; ++k) {
+    amax = std::max(amax, (double)std::fabs(taps[k]));
+    asum += std::fabs(taps[k]);
+  }
+
+  st.shift = -1;
+  for (int s = 30; s >= 0; --s) {
+    const double m = std::ldexp(1.0, s);
+    if (amax * m + 0.5 <= 32767.0 && asum * m + 0.5 * T <= 65535.0) { st.shift = s; break; }
+  }
+
+  st.taps_q.assign(Tp, 0);
+  if (st.shift >= 0) {
+    const double m = std::ldexp(1.0, st.shift);
+    for (int k = 0; k < T; ++k)
+      st.taps_q[k] = (int16_t)std::lrint(taps[T - 1 - k] * m);
+  }
+}
+
+static inline int32_t dot_i16_(const int16_t* x, const int16_t* h, int n) // n multiplo de 8
+{
+#if defined(__SSE2__)
+  __m128i acc = _mm_setzero_si128();
+  for (int k = 0; k < n; k += 8) {
+    const __m128i xv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + k));
+    const __m128i hv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + k));
+    acc = _mm_add_epi32(acc, _mm_madd_epi16(xv, hv));
+  }
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+  acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(acc);
+#else
+  int32_t acc = 0;
+  for (int k = 0; k < n; ++k) acc += (int32_t)x[k] * h[k];
+  return acc;
+#endif
+}
+
+template<typename T>
+int flex_fir_int_work_body(int noutput_items,
+                           const sc_iq<T>* in, gr_complex* out,
+                           std::vector<sc_iq<T> >& hist,
+                           const fir_fold_taps& taps,
+                           bool fixed,
+                           flex_fir_int_state& st)
+{
+  const int Nt = taps.size();
+  if (Nt <= 0) {
+    std::fill(out, out + noutput_items, gr_complex(0.0f, 0.0f));
+    return noutput_items;
+  }
+
+  const int H = (int)hist.size();            // Nt - 1
+  const int L = H + noutput_items;
+  const float fs = sc_full_scale<T>::inv();
+
+  if (fixed) {
+    const int Tp = (int)st.taps_q.size();
+    st.bi.resize(L + 8);
+    st.bq.resize(L + 8);
+    int16_t* bi = &st.bi[0];
+    int16_t* bq = &st.bq[0];
+    for (int k = 0; k < H; ++k)             { bi[k] = hist[k].i; bq[k] = hist[k].q; }
+    for (int k = 0; k < noutput_items; ++k) { bi[H + k] = in[k].i; bq[H + k] = in[k].q; }
+    std::memset(bi + L, 0, 8 * sizeof(int16_t));   // relleno de los taps cero
+    std::memset(bq + L, 0, 8 * sizeof(int16_t));
+
+    const float k_out = fs * std::ldexp(1.0f, -st.shift);
+    const int16_t* h = &st.taps_q[0];
+    for (int n = 0; n < noutput_items; ++n) {
+      out[n] = gr_complex((float)dot_i16_(bi + n, h, Tp) * k_out,
+                          (float)dot_i16_(bq + n, h, Tp) * k_out);
+    }
+  } else {
+    if (!taps.symmetric &&
+        ((int)st.taps_rev.size() != Nt || !std::equal(taps.h.begin(), taps.h.end(), st.taps_rev.rbegin())))
+      st.taps_rev.assign(taps.h.rbegin(), taps.h.rend());
+    st.fi.resize(L);
+    st.fq.resize(L);
+    float* fi = &st.fi[0];
+    float* fq = &st.fq[0];
+    for (int k = 0; k < H; ++k)             { fi[k] = hist[k].real(); fq[k] = hist[k].imag(); }
+    for (int k = 0; k < noutput_items; ++k) { fi[H + k] = in[k].real(); fq[H + k] = in[k].imag(); }
+
+    if (taps.symmetric) {
+      for (int n = 0; n < noutput_items; ++n)
+        out[n] = gr_complex(fir_dot(fi + n, taps) * fs, fir_dot(fq + n, taps) * fs);
+    } else {
+      const float* h = &st.taps_rev[0];
+      for (int n = 0; n < noutput_items; ++n) {
+        float yi, yq;
+        volk_32f_x2_dot_prod_32f(&yi, fi + n, h, Nt);
+        volk_32f_x2_dot_prod_32f(&yq, fq + n, h, Nt);
+        out[n] = gr_complex(yi * fs, yq * fs);
+      }
+    }
+  }
+
+  // actualiza historial con las ultimas Nt-1 muestras de (hist + in)
+  if (H > 0) {
+    if (noutput_items >= H) {
+      hist.assign(in + noutput_items - H, in + noutput_items);
+    } else {
+      hist.erase(hist.begin(), hist.begin() + noutput_items);
+      hist.insert(hist.end(), in, in + noutput_items);
+    }
+  }
+
+  return noutput_items;
+}
+
+}} // namespace
+#endif
@@ -4,26 +4,65 @@
 #include <vector>
 #include <complex>
 #include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include "fir_fold.h"
+#include "fir_worker_pool.h"
 
 namespace gr { namespace howto {
 
 template<typename Tin, typename Tout>
 static inline void write_sample_(Tout& dst, const Tin& x) { dst = static_cast<Tout>(x); }
 
-// especialización: Tin=complex<float>, Tout=float -> por defecto paso parte real
-template<>
-inline void write_sample_<std::complex<float>, float>(float& dst, const std::complex<float>& x)
+/*
+ * Modo paralelo (opt-in, set_threads): cada salida depende solo de buf, así
+ * que el rango [0, n) se parte en trozos que toman el pool y el hilo del
+ * bloque. Solo vale la pena con bastante trabajo por llamada: por debajo de
+ * FLEX_FIR_PAR_MIN_MACS se queda en el hilo del bloque, y ningún trozo
+ * baja de FLEX_FIR_CHUNK_MACS (el costo de despertar un worker).
+ */
+enum { FLEX_FIR_PAR_MIN_MACS = 1 << 18, FLEX_FIR_CHUNK_MACS = 1 << 16 };
+
+template<class F>
+struct flex_fir_chunks_
+{
+  F* f;
+  int n, nchunks;
+
+  static void call(void* p, int i)
+  {
+    const flex_fir_chunks_* c = static_cast<const flex_fir_chunks_*>(p);
+    (*c->f)((int)((long)c->n * i / c->nchunks), (int)((long)c->n * (i + 1) / c->nchunks));
+  }
+};
+
+//! f(a, b) computes outputs [a, b); split over pool when it pays
+template<class F>
+static inline void flex_fir_for_outputs_(int n, int T, fir_worker_pool* pool, F f)
 {
-  dst = x.real();
+  const long macs = (long)n * T;
+  if (!pool || pool->size() < 2 || macs < FLEX_FIR_PAR_MIN_MACS) {
+    f(0, n);
+    return;
+  }
+  // ~4 trozos por hilo para repartir bien, sin bajar del mínimo por trozo
+  const int nchunks = (int)std::max(2L, std::min((long)(4 * pool->size()), macs / FLEX_FIR_CHUNK_MACS));
+  flex_fir_chunks_<F> c = { &f, n, nchunks };
+  pool->run(nchunks, &flex_fir_chunks_<F>::call, &c);
 }
 
-template<typename Tin, typename Tout>
+/*
+ * Acc: política de acumulación de fir_dot (fir_acc_float / _split / _double,
+ * ver fir_fold.h); los bloques la eligen en runtime con set_accumulation().
+ */
+template<typename Tin, typename Tout, class Acc = fir_acc_float>
 int flex_fir_work_body(int noutput_items,
                        const Tin* in, Tout* out,
                        std::vector<Tin>& hist,
-                       const std::vector<float>& taps)
+                       const fir_fold_taps& taps,
+                       fir_worker_pool* pool = 0)
 {
-  const int T = static_cast<int>(taps.size());
+  const int T = taps.size();
   if (T <= 0) {
     std::memset(out, 0, sizeof(Tout)*noutput_items);
     return noutput_items;
@@ -35,16 +74,15 @@ int flex_fir_work_body(int noutput_items,
   buf.insert(buf.end(), hist.begin(), hist.end());
   buf.insert(buf.end(), in, in + noutput_items);
 
-  // Convolución directa (sí, O(NT); esto es referencia simple)
-  for (int n = 0; n < noutput_items; ++n) {
-    // acumula en tipo intermedio
-    typename std::conditional<std::is_same<Tin, std::complex<float>>::value,
-                              std::complex<float>, float>::type acc(0);
-    for (int k = 0; k < T; ++k) {
-      acc += buf[n + T - 1 - k] * taps[k];
+  // Convolución directa sobre la ventana buf[n .. n+T-1]; con taps
+  // simétricos fir_dot pliega la ventana (la mitad de multiplicaciones)
+  const Tin* b = &buf[0];
+  flex_fir_for_outputs_(noutput_items, T, pool, [=, &taps](int n0, int n1) {
+    for (int n = n0; n < n1; ++n) {
+      const Tin acc = fir_dot<Acc>(b + n, taps);
+      write_sample_<Tin, Tout>(out[n], acc);
     }
-    write_sample_<decltype(acc), Tout>(out[n], acc);
-  }
+  });
 
   // actualiza historial
   if (T > 1) {
@@ -54,6 +92,81 @@ int flex_fir_work_body(int noutput_items,
   return noutput_items;
 }
 
+/*
+ * flex_fir_cf: los taps son reales, así que I y Q no se mezclan y
+ * Re{y} = h * Re{x}, Im{y} = h * Im{x}. Para REAL/IMAG basta filtrar un
+ * solo carril (la mitad de MACs y un historial float); |y| necesita los
+ * dos. La parte se fija al instanciar, el bucle no decide nada.
+ */
+enum { FLEX_FIR_CF_REAL = 0, FLEX_FIR_CF_IMAG = 1, FLEX_FIR_CF_MAG = 2 };
+
+template<int Part> struct flex_fir_cf_hist { typedef float type; };
+template<> struct flex_fir_cf_hist<FLEX_FIR_CF_MAG> { typedef std::complex<float> type; };
+
+template<int Part, class Acc = fir_acc_float>
+typename std::enable_if<Part != FLEX_FIR_CF_MAG, int>::type
+flex_fir_cf_work_body(int noutput_items,
+                          const std::complex<float>* in, float* out,
+                          std::vector<typename flex_fir_cf_hist<Part>::type>& hist,
+                          const fir_fold_taps& taps,
+                          fir_worker_pool* pool = 0)
+{
+  const int T = taps.size();
+  if (T <= 0) {
+    std::memset(out, 0, sizeof(float)*noutput_items);
+    return noutput_items;
+  }
+
+  // Historial + el carril pedido de la entrada (lectura con paso 2)
+  const float* lane = reinterpret_cast<const float*>(in) + (Part == FLEX_FIR_CF_IMAG ? 1 : 0);
+  std::vector<float> buf(hist.size() + noutput_items);
+  std::copy(hist.begin(), hist.end(), buf.begin());
+  float* x = &buf[0] + hist.size();
+  for (int n = 0; n < noutput_items; ++n) x[n] = lane[2 * n];
+
+  const float* b = &buf[0];
+  flex_fir_for_outputs_(noutput_items, T, pool, [=, &taps](int n0, int n1) {
+    for (int n = n0; n < n1; ++n) out[n] = fir_dot<Acc>(b + n, taps);
+  });
+
+  if (T > 1) {
+    hist.assign(buf.end() - (T - 1), buf.end());
+  }
+
+  return noutput_items;
+}
+
+template<int Part, class Acc = fir_acc_float>
+typename std::enable_if<Part == FLEX_FIR_CF_MAG, int>::type
+flex_fir_cf_work_body(int noutput_items,
+                      const std::complex<float>* in, float* out,
+                      std::vector<std::complex<float> >& hist,
+                      const fir_fold_taps& taps,
+                      fir_worker_pool* pool = 0)
+{
+  const int T = taps.size();
+  if (T <= 0) {
+    std::memset(out, 0, sizeof(float)*noutput_items);
+    return noutput_items;
+  }
+
+  std::vector<std::complex<float> > buf;
+  buf.reserve(hist.size() + noutput_items);
+  buf.insert(buf.end(), hist.begin(), hist.end());
+  buf.insert(buf.end(), in, in + noutput_items);
+
+  const std::complex<float>* b = &buf[0];
+  flex_fir_for_outputs_(noutput_items, T, pool, [=, &taps](int n0, int n1) {
+    for (int n = n0; n < n1; ++n) out[n] = std::abs(fir_dot<Acc>(b + n, taps));
+  });
+
+  if (T > 1) {
+    hist.assign(buf.end() - (T - 1), buf.end());
+  }
+
+  return noutput_items;
+}
+
 }} // namespace
 #endif
 
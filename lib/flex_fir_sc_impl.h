@@ -0,0 +1,117 @@
+#ifndef INCLUDED_HOWTO_FLEX_FIR_SC_IMPL_H
+#define INCLUDED_HOWTO_FLEX_FIR_SC_IMPL_H
+
+#include <gnuradio/io_signature.h>
+#include "flex_fir_impl_base.h"
+#include "flex_fir_int_kernel.cc"
+
+namespace gr { namespace howto {
+
+// Implementacion comun de flex_fir_sc16c / flex_fir_sc8c (Iface = interfaz publica)
+template<typename T, class Iface>
+class flex_fir_sc_impl final : public Iface,
+                               public flex_fir_impl_base<sc_iq<T>, gr_complex>
+{
+  typedef flex_fir_impl_base<sc_iq<T>, gr_complex> base;
+
+  bool d_fixed;
+  bool d_int_path;            // the int16 kernel runs (d_fixed and the taps fit)
+  flex_fir_int_state d_st;
+
+  // Quantizes the designed taps when the fixed path is asked for, so the
+  // queries report the path work() takes; d_mutex held
+  void requantize_locked_()
+  {
+    if (d_fixed && this->d_taps != d_st.taps_src)
+      flex_fir_quantize_taps_(this->d_taps, d_st);
+    d_int_path = d_fixed && d_st.shift >= 0;
+  }
+
+public:
+  flex_fir_sc_impl(const char* name, int mode, float fs, float f1, float f2, float w, float g,
+                   bool fixed_point, float atten, float ripple)
+  : gr::sync_block(name,
+        gr::io_signature::make(1,1,sizeof(sc_iq<T>)),
+        gr::io_signature::make(1,1,sizeof(gr_complex))),
+    base(mode,fs,f1,f2,w,g,atten,ripple),
+    d_fixed(fixed_point),
+    d_int_path(false)
+  {
+    // Design up front so taps_shift() / macs_per_sample() are valid before
+    // the first work(); later setters apply there as usual
+    boost::lock_guard<boost::mutex> lck(this->d_mutex);
+    this->design_taps_();
+    this->d_dirty = false;
+    requantize_locked_();
+  }
+
+  ~flex_fir_sc_impl() override {}
+
+  void  set_mode(int m) noexcept override { base::set_mode(m); }
+  int   mode() const noexcept override    { return base::mode(); }
+
+  void  set_samp_rate(float fs) noexcept override { base::set_samp_rate(fs); }
+  float samp_rate() const noexcept override       { return base::samp_rate(); }
+
+  void  set_f1(float f) noexcept override { base::set_f1(f); }
+  float f1() const noexcept override      { return base::f1(); }
+
+  void  set_f2(float f) noexcept override { base::set_f2(f); }
+  float f2() const noexcept override      { return base::f2(); }
+
+  void  set_width(float w) noexcept override { base::set_width(w); }
+  float width() const noexcept override      { return base::width(); }
+
+  void  set_gain(float g) noexcept override { base::set_gain(g); }
+  float gain() const noexcept override      { return base::gain(); }
+
+  void  set_fixed_point(bool on) noexcept override
+  { boost::lock_guard<boost::mutex> lck(this->d_mutex); d_fixed = on; requantize_locked_(); }
+  bool  fixed_point() const noexcept override
+  { boost::lock_guard<boost::mutex> lck(this->d_mutex); return d_fixed; }
+
+  int   taps_shift() const noexcept override
+  { boost::lock_guard<boost::mutex> lck(this->d_mutex); return d_int_path ? d_st.shift : -1; }
+
+  std::vector<float> taps() const override  { return base::taps(); }
+
+  void  set_attenuation(float db) noexcept override { base::set_attenuation(db); }
+  float attenuation() const noexcept override       { return base::attenuation(); }
+
+  void  set_ripple(float db) noexcept override { base::set_ripple(db); }
+  float ripple() const noexcept override       { return base::ripple(); }
+
+  int   ntaps() const noexcept override           { return base::ntaps(); }
+  // Of the designed taps and the path that runs them: the int16 kernel
+  // does not fold, the float one does
+  int   macs_per_sample() const noexcept override
+  {
+    boost::lock_guard<boost::mutex> lck(this->d_mutex);
+    const int nt = (int)this->d_taps.size();
+    return d_int_path ? 2 * nt : 2 * ((nt + 1) / 2);
+  }
+
+  int work(int noutput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items) override
+  {
+    const sc_iq<T>* in  = static_cast<const sc_iq<T>*>(input_items[0]);
+    gr_complex*     out = static_cast<gr_complex*>(output_items[0]);
+
+    std::vector<float> taps;
+    int m; float fs,f1,f2,w,g;
+    this->snapshot_params_(m,fs,f1,f2,w,g,taps);
+
+    bool fixed;
+    {
+      boost::lock_guard<boost::mutex> lck(this->d_mutex);
+      requantize_locked_();                // taps fuera de rango int16: camino float
+      fixed = d_int_path;
+    }
+
+    return flex_fir_int_work_body<T>(noutput_items, in, out, this->d_hist, this->d_fold, fixed, d_st);
+  }
+};
+
+}} // namespace
+#endif
@@ -0,0 +1,190 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "freq_xlating_decimate_fir_cc_impl.h"
+#include "decim_planner.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+using gr::filter::firdes;
+
+namespace gr {
+    namespace howto {
+
+	freq_xlating_decimate_fir_cc::sptr
+	freq_xlating_decimate_fir_cc::make(int decim, double fs, double center,
+					   double cutoff, double trans,
+					   int window, double beta)
+	{
+	  return gnuradio::get_initial_sptr(
+	    new freq_xlating_decimate_fir_cc_impl(decim, fs, center, cutoff, trans,
+						  static_cast<firdes::win_type>(window), beta));
+	}
+
+	// -------- impl --------
+
+	freq_xlating_decimate_fir_cc_impl::freq_xlating_decimate_fir_cc_impl(
+	    int decim, double fs, double center, double cutoff, double trans,
+	    firdes::win_type window, double beta)
+	: gr::block("freq_xlating_decimate_fir_cc",
+		    gr::io_signature::make(1, 1, sizeof(gr_complex)),
+		    gr::io_signature::make(1, 1, sizeof(gr_complex))),
+	  d_decim(decim),
+	  d_fs(fs),
+	  d_center(center),
+	  d_cutoff(cutoff),
+	  d_trans(trans),
+	  d_window(window),
+	  d_beta(beta),
+	  d_dirty(true),
+	  d_retune(false),
+	  d_rot(1.0f, 0.0f),
+	  d_rot_inc(1.0f, 0.0f),
+	  d_L(0)
+	{
+	  if (d_decim < 1)     throw std::invalid_argument("decim must be >= 1");
+	  if (d_fs <= 0.0)     throw std::invalid_argument("samp_rate must be > 0");
+	  if (d_cutoff <= 0.0) throw std::invalid_argument("cutoff must be > 0");
+	  if (d_trans <= 0.0)  throw std::invalid_argument("transition must be > 0");
+
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  design_taps_locked();
+	}
+
+	void freq_xlating_decimate_fir_cc_impl::design_taps_locked()
+	{
+	  // Same single-stage low-pass as decimate_fir_cc (gain 1, input rate)
+	  const decim_spec spec = { d_decim, d_fs, d_cutoff, d_trans, d_window, d_beta };
+	  d_taps = design_lowpass(spec, 1.0, d_fs);
+	  d_L = d_taps.size();
+	  rotate_taps_locked();
+
+	  this->set_history(static_cast<int>(d_L));
+	  this->set_relative_rate(1.0 / static_cast<double>(d_decim));
+	  d_dirty = false;
+	}
+
+	void freq_xlating_decimate_fir_cc_impl::rotate_taps_locked()
+	{
+	  const double w = 2.0 * M_PI * d_center / d_fs;
+	  d_xt.set(d_taps, w);
+	  d_rot_inc = std::polar(1.0f, (float)std::remainder(-w * d_decim, 2.0 * M_PI));
+	  d_retune = false;
+	}
+
+	std::vector<gr_complex> freq_xlating_decimate_fir_cc_impl::taps() const
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_xt.b;
+	}
+
+	// ---- setters ----
+	void freq_xlating_decimate_fir_cc_impl::set_center_freq(double fc)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (fc != d_center) { d_center = fc; d_retune = true; }
+	}
+
+	void freq_xlating_decimate_fir_cc_impl::set_decimation(int decim)
+	{
+	  if (decim < 1) throw std::invalid_argument("decim must be >= 1");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (decim != d_decim) { d_decim = decim; d_dirty = true; }
+	}
+
+	void freq_xlating_decimate_fir_cc_impl::set_samp_rate(double fs)
+	{
+	  if (fs <= 0.0) throw std::invalid_argument("samp_rate must be > 0");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (fs != d_fs) { d_fs = fs; d_dirty = true; }
+	}
+
+	void freq_xlating_decimate_fir_cc_impl::set_cutoff(double fc)
+	{
+	  if (fc <= 0.0) throw std::invalid_argument("cutoff must be > 0");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (fc != d_cutoff) { d_cutoff = fc; d_dirty = true; }
+	}
+
+	void freq_xlating_decimate_fir_cc_impl::set_transition(double tw)
+	{
+	  if (tw <= 0.0) throw std::invalid_argument("transition must be > 0");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (tw != d_trans) { d_trans = tw; d_dirty = true; }
+	}
+
+	void freq_xlating_decimate_fir_cc_impl::set_window(int w)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  firdes::win_type neww = static_cast<firdes::win_type>(w);
+	  if (neww != d_window) { d_window = neww; d_dirty = true; }
+	}
+
+	void freq_xlating_decimate_fir_cc_impl::set_kaiser_beta(double beta)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (beta != d_beta) { d_beta = beta; d_dirty = true; }
+	}
+
+	// ---- scheduler functions ----
+
+	void freq_xlating_decimate_fir_cc_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required)
+	{
+	  int D = 0;
+	  {
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    D = d_decim;
+	  }
+	  ninput_items_required[0] = std::max(D * noutput_items, D);
+	}
+
+	int freq_xlating_decimate_fir_cc_impl::general_work(int noutput_items,
+							    gr_vector_int &ninput_items,
+							    gr_vector_const_void_star &input_items,
+							    gr_vector_void_star &output_items)
+	{
+	  const gr_complex* in  = static_cast<const gr_complex*>(input_items[0]);
+	  gr_complex*       out = static_cast<gr_complex*>(output_items[0]);
+
+	  int    D;
+	  size_t L;
+	  {
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (d_dirty) {
+	      // New taps length / decimation: sync history and rate first
+	      design_taps_locked();
+	      return 0;
+	    }
+	    if (d_retune) {
+	      // Same length: swap the rotated taps here, at an output boundary.
+	      // d_rot is not touched, so the output phase stays continuous
+	      rotate_taps_locked();
+	    }
+	    D = d_decim;
+	    L = d_L;
+	  }
+
+	  const int max_out = static_cast<int>((ninput_items[0] - static_cast<int>(L) + 1) / D);
+	  const int nout = std::max(0, std::min(noutput_items, max_out));
+	  if (nout <= 0) return 0;
+
+	  // Window in[j*D .. j*D + L-1] (oldest .. newest), then the residual
+	  // rotation e^{-jw(m - c)}, advanced by e^{-jwD} per output
+	  const fir_xlate_taps& taps = d_xt;
+	  gr_complex rot = d_rot;
+	  const gr_complex inc = d_rot_inc;
+	  for (int j = 0; j < nout; ++j) {
+	    out[j] = fir_xlate_dot(in + j * D, taps) * rot;
+	    rot *= inc;
+	    if ((j & 511) == 511) rot /= std::abs(rot);   // keep |rot| = 1
+	  }
+	  d_rot = rot / std::abs(rot);
+
+	  consume_each(nout * D);
+	  return nout;
+	}
+
+}} // namespace gr::howto
@@ -0,0 +1,76 @@
+#ifndef INCLUDED_HOWTO_FREQ_XLATING_DECIMATE_FIR_CC_IMPL_H
+#define INCLUDED_HOWTO_FREQ_XLATING_DECIMATE_FIR_CC_IMPL_H
+
+#include <howto/freq_xlating_decimate_fir_cc.h>
+#include "fir_xlate.h"
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+#include <gnuradio/filter/firdes.h>
+using gr::filter::firdes;
+
+namespace gr {
+
+   namespace howto {
+
+	class freq_xlating_decimate_fir_cc_impl final : public freq_xlating_decimate_fir_cc
+	{
+	private:
+	  // Parameters guarded by d_mutex
+	  mutable boost::mutex d_mutex;
+	  int    d_decim;
+	  double d_fs;
+	  double d_center;
+	  double d_cutoff;
+	  double d_trans;
+	  firdes::win_type d_window;
+	  double d_beta;
+	  bool   d_dirty;    // taps length or decim changed: realign
+	  bool   d_retune;   // only center_freq changed: swap taps in place
+
+	  std::vector<float> d_taps;   // real low-pass (firdes)
+	  fir_xlate_taps d_xt;         // rotated; only rebuilt from work()/ctor
+	  gr_complex d_rot;            // output phase, carried across retunes
+	  gr_complex d_rot_inc;        // e^{-jwD}
+	  size_t d_L;
+
+	  void design_taps_locked();   // assumes d_mutex locked
+	  void rotate_taps_locked();   // d_xt + d_rot_inc from d_taps / d_center
+
+	public:
+	  freq_xlating_decimate_fir_cc_impl(int decim, double fs, double center,
+					    double cutoff, double trans,
+					    firdes::win_type window, double beta); /* may throw */
+
+	  ~freq_xlating_decimate_fir_cc_impl() override = default;
+
+	  // Queries
+	  int    decimation()  const noexcept override { return d_decim; }
+	  double samp_rate()   const noexcept override { return d_fs; }
+	  double center_freq() const noexcept override { return d_center; }
+	  double cutoff()      const noexcept override { return d_cutoff; }
+	  double transition()  const noexcept override { return d_trans; }
+	  int    window()      const noexcept override { return static_cast<int>(d_window); }
+	  double kaiser_beta() const noexcept override { return d_beta; }
+	  std::vector<gr_complex> taps() const override;
+
+	  // Setters (cheap)
+	  void set_center_freq(double fc) override;
+	  void set_decimation(int decim) override;
+	  void set_samp_rate(double fs) override;
+	  void set_cutoff(double fc) override;
+	  void set_transition(double tw) override;
+	  void set_window(int w) override;
+	  void set_kaiser_beta(double beta) override;
+
+	  // GNURadio API
+	  void forecast(int noutput_items, gr_vector_int &ninput_items_required) override;
+
+	  int general_work(int noutput_items,
+			   gr_vector_int &ninput_items,
+			   gr_vector_const_void_star &input_items,
+			   gr_vector_void_star &output_items) override;
+	};
+
+}} // namespace gr::howto
+#endif
@@ -23,7 +23,9 @@
 #endif
 
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include "gain_ff_impl.h"
+#include <algorithm>
 
 namespace gr {
   namespace howto {
@@ -43,7 +45,11 @@ namespace gr {
               gr::io_signature::make(1, 1, sizeof(float)),
               gr::io_signature::make(1, 1, sizeof(float))),
 	d_gain(gain)
-    {}
+    {
+      // Ask the scheduler for VOLK-aligned buffers so the aligned kernel is used
+      const int alignment_multiple = volk_get_alignment() / sizeof(float);
+      set_alignment(std::max(1, alignment_multiple));
+    }
 
     /*
      * Our virtual destructor.
@@ -60,10 +66,8 @@ namespace gr {
       const float *in = (const float *) input_items[0];
       float *out = (float *) output_items[0];
 
-      // Do <+signal processing+>
-	for (int i = 0; i < noutput_items; i++) {
-		out[i] = d_gain * in[i];
-	      }
+      // out = gain * in (SIMD via VOLK). Safe with out == in.
+      volk_32f_s32f_multiply_32f(out, in, d_gain, noutput_items);
 
       // Tell runtime system how many output items we produced.
       return noutput_items;
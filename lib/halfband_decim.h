@@ -0,0 +1,122 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_HALFBAND_DECIM_H
+#define INCLUDED_HOWTO_HALFBAND_DECIM_H
+
+#include "decim_stage.h"
+#include "fir_fold.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/filter/firdes.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Half-band decimate-by-2 stage.
+	 *
+	 * A half-band low-pass (cutoff fs/4) of length T = 4K-1 has h[c] = 1/2 at
+	 * the centre and zeros at every other even offset from it, so only the
+	 * 2K odd-offset taps remain. Split the input into its even/odd phases
+	 * (polyphase): output m is
+	 *
+	 *   y[m] = fir_dot(e[m .. m+2K-1], g) + 1/2 * o[m + K-1]
+	 *
+	 * where g (the 2K odd-offset taps) is symmetric, so fir_dot folds it:
+	 * K+1 multiplies per output instead of T.
+	 *
+	 * The stage keeps its own delay line (2K-1 samples per phase), so stages
+	 * chain inside one block (see decim_planner.h).
+	 */
+	class halfband_stage : public decim_stage
+	{
+	public:
+	  halfband_stage() : d_K(0) {}
+
+	  //! firdes length for a half-band with this transition -> K (T = 4K-1)
+	  static int estimate_K(double trans_norm, double atten_db)
+	  {
+	    int n = (int)(atten_db / (22.0 * trans_norm));
+	    if ((n & 1) == 0) n++;
+	    return std::max(1, ((n - 1) / 2 + 1) / 2);
+	  }
+
+	  /*!
+	   * Designs the stage from a firdes low-pass at fs/4 with transition
+	   * 'trans_norm' (fraction of the stage input rate), then forces the exact
+	   * half-band structure (centre 1/2, odd-offset taps summing to 1/2).
+	   */
+	  void design(double trans_norm, gr::filter::firdes::win_type window, double beta)
+	  {
+	    const std::vector<float> h =
+	      gr::filter::firdes::low_pass(1.0, 1.0, 0.25, trans_norm, window, beta);
+	    const int cf = (int)(h.size() - 1) / 2;
+	    d_K = std::max(1, (cf + 1) / 2);
+
+	    std::vector<float> g(2 * d_K, 0.0f);
+	    double s = 0.0;
+	    for (int j = 0; j < 2 * d_K; ++j) {
+	      const int idx = cf + 2 * j - (2 * d_K - 1);
+	      g[j] = (idx >= 0 && idx < (int)h.size()) ? h[idx] : 0.0f;
+	      s += g[j];
+	    }
+	    if (s <= 0.0) throw std::runtime_error("half-band design failed");
+	    for (int j = 0; j < 2 * d_K; ++j) g[j] = (float)(g[j] * 0.5 / s);
+	    d_g.set(g);
+	    reset();
+	  }
+
+	  void reset()
+	  {
+	    d_e.assign(2 * d_K - 1, gr_complex(0.0f, 0.0f));
+	    d_o.assign(2 * d_K - 1, gr_complex(0.0f, 0.0f));
+	  }
+
+	  int decimation() const { return 2; }
+	  int ntaps() const { return 4 * d_K - 1; }
+	  int memory() const { return 2 * (2 * d_K - 1); }   // both delay lines
+	  double macs_per_output() const { return d_K + 1; }
+
+	  std::string describe() const
+	  {
+	    char s[64];
+	    snprintf(s, sizeof(s), "HB(%d taps)", ntaps());
+	    return s;
+	  }
+
+	  //! Filters nin (even) samples into nin/2 outputs; returns nin/2.
+	  int process(const gr_complex* in, int nin, gr_complex* out)
+	  {
+	    const int nout = nin / 2;
+	    const int H = 2 * d_K - 1;
+	    d_e.resize(H + nout);
+	    d_o.resize(H + nout);
+	    for (int m = 0; m < nout; ++m) {
+	      d_e[H + m] = in[2 * m];
+	      d_o[H + m] = in[2 * m + 1];
+	    }
+
+	    const gr_complex* e = &d_e[0];
+	    const gr_complex* o = &d_o[0] + (d_K - 1);
+	    for (int m = 0; m < nout; ++m)
+	      out[m] = fir_dot(e + m, d_g) + 0.5f * o[m];
+
+	    d_e.erase(d_e.begin(), d_e.begin() + nout);   // keep the last H per phase
+	    d_o.erase(d_o.begin(), d_o.begin() + nout);
+	    return nout;
+	  }
+
+	private:
+	  int d_K;
+	  fir_fold_taps d_g;                 // 2K odd-offset taps (symmetric)
+	  std::vector<gr_complex> d_e, d_o;  // even / odd phase delay lines
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_HALFBAND_DECIM_H */
@@ -23,8 +23,8 @@
 #endif
 
 #include "iq_mag_cf_impl.h"
+#include "pointwise_stages.h"
 #include <gnuradio/io_signature.h>
-#include <cmath>  // std::sqrtf
 
 namespace gr {
   namespace howto {
@@ -58,11 +58,7 @@ namespace gr {
         sc = d_scale;
       }
 
-      for (int i = 0; i < noutput_items; ++i) {
-        const float re = in[i].real();
-        const float im = in[i].imag();
-        out[i] = sc * std::sqrt(re * re + im * im);
-      }
+      pw::run(pw::mag() | pw::gain(sc), in, out, noutput_items);
 
       return noutput_items;
     }
@@ -1,6 +1,7 @@
 /* -*- c++ -*- */
 /* SPDX-License-Identifier: GPL-3.0-or-later */
 #include "iq_select_cf_impl.h"
+#include "pointwise_stages.h"
 #include <gnuradio/io_signature.h>
 #include <cmath>
 
@@ -68,46 +69,12 @@ int iq_select_cf_impl::work(int noutput_items,
 
     // Procesamiento sin ramas especiales para sc==1.0
     switch (m) {
-        case 0: // |x|
-            for (int i = 0; i < noutput_items; ++i) {
-                const float re = in[i].real();
-                const float im = in[i].imag();
-                out[i] = sc * std::sqrt(re*re + im*im);
-            }
-            break;
-
-        case 1: // |x|^2
-            for (int i = 0; i < noutput_items; ++i) {
-                const float re = in[i].real();
-                const float im = in[i].imag();
-                out[i] = sc * (re*re + im*im);
-            }
-            break;
-
-        case 2: // arg(x)
-            for (int i = 0; i < noutput_items; ++i) {
-                out[i] = sc * std::atan2(in[i].imag(), in[i].real());
-            }
-            break;
-
-        case 3: // Re{x}
-            for (int i = 0; i < noutput_items; ++i) {
-                out[i] = sc * in[i].real();
-            }
-            break;
-
-        case 4: // Im{x}
-            for (int i = 0; i < noutput_items; ++i) {
-                out[i] = sc * in[i].imag();
-            }
-            break;
-
-        case 5: // |arg(x)|
-            for (int i = 0; i < noutput_items; ++i) {
-                const float ph = std::atan2(in[i].imag(), in[i].real());
-                out[i] = sc * std::fabs(ph);
-            }
-            break;
+        case 0: pw::run(pw::mag()       | pw::gain(sc), in, out, noutput_items); break; // |x|
+        case 1: pw::run(pw::power()     | pw::gain(sc), in, out, noutput_items); break; // |x|^2
+        case 2: pw::run(pw::phase()     | pw::gain(sc), in, out, noutput_items); break; // arg(x)
+        case 3: pw::run(pw::real()      | pw::gain(sc), in, out, noutput_items); break; // Re{x}
+        case 4: pw::run(pw::imag()      | pw::gain(sc), in, out, noutput_items); break; // Im{x}
+        case 5: pw::run(pw::abs_phase() | pw::gain(sc), in, out, noutput_items); break; // |arg(x)|
 
         default: // modo inválido -> cero
             for (int i = 0; i < noutput_items; ++i) {
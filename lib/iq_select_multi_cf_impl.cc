@@ -0,0 +1,158 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#include "iq_select_multi_cf_impl.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cmath>
+
+namespace gr { namespace howto {
+
+iq_select_multi_cf::sptr iq_select_multi_cf::make(float scale, const std::vector<int>& modes)
+{
+    return gnuradio::get_initial_sptr(new iq_select_multi_cf_impl(scale, modes));
+}
+
+// Outputs: as many as get connected (-1 = no upper limit)
+iq_select_multi_cf_impl::iq_select_multi_cf_impl(float scale, const std::vector<int>& modes)
+: gr::sync_block("iq_select_multi_cf",
+                 gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                 gr::io_signature::make(1, -1, sizeof(float))),
+  d_scale(scale), d_modes(modes)
+{
+}
+
+void iq_select_multi_cf_impl::set_scale(float s) noexcept
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    d_scale = s;
+}
+
+float iq_select_multi_cf_impl::scale() const noexcept
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    return d_scale;
+}
+
+void iq_select_multi_cf_impl::set_modes(const std::vector<int>& modes)
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    d_modes = modes;
+}
+
+std::vector<int> iq_select_multi_cf_impl::modes() const
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    return d_modes;
+}
+
+// Samples per chunk: the input chunk stays in L1 while the atan2 pass
+// reads it a second time
+static const int IQ_MULTI_CHUNK = 1024;
+
+// The cheap features, as bits of the kernel mask
+enum { IQM_MAG = 1, IQM_POW = 2, IQM_RE = 4, IQM_IM = 8, IQM_MASKS = 16 };
+
+// One loop for every cheap feature in M: re^2 + im^2 is formed once for
+// |x| and |x|^2 and everything stays in registers. Same arithmetic as the
+// pw:: stages iq_select_cf runs.
+template<unsigned M>
+static void iq_multi_kernel_(const gr_complex* in, int n, float sc, float* const* f)
+{
+    float* __restrict mag = f[0];
+    float* __restrict pw2 = f[1];
+    float* __restrict re_ = f[2];
+    float* __restrict im_ = f[3];
+    for (int i = 0; i < n; ++i) {
+        const float re = in[i].real(), im = in[i].imag();
+        const float p = (M & (IQM_MAG | IQM_POW)) ? re * re + im * im : 0.0f;
+        if (M & IQM_MAG) mag[i] = sc * std::sqrt(p);
+        if (M & IQM_POW) pw2[i] = sc * p;
+        if (M & IQM_RE)  re_[i] = sc * re;
+        if (M & IQM_IM)  im_[i] = sc * im;
+    }
+}
+
+// Runtime mask -> instantiation
+template<unsigned M>
+struct iq_multi_dispatch_
+{
+    static void run(unsigned mask, const gr_complex* in, int n, float sc, float* const* f)
+    {
+        if (mask == M) iq_multi_kernel_<M>(in, n, sc, f);
+        else iq_multi_dispatch_<M + 1>::run(mask, in, n, sc, f);
+    }
+};
+template<>
+struct iq_multi_dispatch_<IQM_MASKS>
+{
+    static void run(unsigned, const gr_complex*, int, float, float* const*) {}
+};
+
+int iq_select_multi_cf_impl::work(int noutput_items,
+                                  gr_vector_const_void_star& input_items,
+                                  gr_vector_void_star& output_items)
+{
+    const gr_complex* in = static_cast<const gr_complex*>(input_items[0]);
+    const int nout = static_cast<int>(output_items.size());   // connected outputs only
+
+    // Snapshot de parámetros fuera del bucle
+    float sc;
+    {
+        boost::lock_guard<boost::mutex> lk(d_mutex);
+        sc = d_scale;
+        d_active.assign(nout, -1);
+        for (int k = 0; k < nout && k < (int)d_modes.size(); ++k)
+            d_active[k] = d_modes[k];
+    }
+
+    // The first output asking for a mode computes it, later ones copy it;
+    // invalid modes -> cero
+    float* owner[6] = { 0, 0, 0, 0, 0, 0 };
+    for (int k = 0; k < nout; ++k) {
+        float* o = static_cast<float*>(output_items[k]);
+        const int m = d_active[k];
+        if (m < 0 || m > 5) {
+            std::fill(o, o + noutput_items, 0.0f);
+            d_active[k] = -1;
+        }
+        else if (!owner[m]) {
+            owner[m] = o;
+        }
+    }
+
+    static const unsigned bit[4] = { IQM_MAG, IQM_POW, IQM_RE, IQM_IM };
+    static const int mode_of[4] = { 0, 1, 3, 4 };
+    unsigned mask = 0;
+    for (int b = 0; b < 4; ++b)
+        if (owner[mode_of[b]]) mask |= bit[b];
+    const bool need_arg = owner[2] || owner[5];
+
+    float arg[IQ_MULTI_CHUNK];
+    for (int i0 = 0; i0 < noutput_items; i0 += IQ_MULTI_CHUNK) {
+        const int n = std::min(IQ_MULTI_CHUNK, noutput_items - i0);
+        const gr_complex* x = in + i0;
+
+        float* f[4];
+        for (int b = 0; b < 4; ++b)
+            f[b] = owner[mode_of[b]] ? owner[mode_of[b]] + i0 : 0;
+        iq_multi_dispatch_<0>::run(mask, x, n, sc, f);
+
+        // atan2 is the expensive one (it also keeps the loop above from
+        // vectorizing): its own pass over the chunk, shared by both phases
+        if (need_arg) {
+            for (int i = 0; i < n; ++i) arg[i] = std::atan2((float)x[i].imag(), (float)x[i].real());
+            if (owner[2]) { float* o = owner[2] + i0; for (int i = 0; i < n; ++i) o[i] = sc * arg[i]; }
+            if (owner[5]) { float* o = owner[5] + i0; for (int i = 0; i < n; ++i) o[i] = sc * std::fabs(arg[i]); }
+        }
+    }
+
+    for (int k = 0; k < nout; ++k) {
+        float* o = static_cast<float*>(output_items[k]);
+        if (d_active[k] >= 0 && owner[d_active[k]] != o)
+            std::copy(owner[d_active[k]], owner[d_active[k]] + noutput_items, o);
+    }
+
+    return noutput_items;
+}
+
+}} // namespace gr::howto
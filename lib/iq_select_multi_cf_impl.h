@@ -0,0 +1,40 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifndef INCLUDED_HOWTO_IQ_SELECT_MULTI_CF_IMPL_H
+#define INCLUDED_HOWTO_IQ_SELECT_MULTI_CF_IMPL_H
+
+#include <howto/iq_select_multi_cf.h>
+#include <boost/thread/mutex.hpp>
+
+namespace gr {
+  namespace howto {
+
+    class iq_select_multi_cf_impl final : public iq_select_multi_cf
+    {
+    public:
+        iq_select_multi_cf_impl(float scale, const std::vector<int>& modes);
+        ~iq_select_multi_cf_impl() noexcept override {}
+
+        // runtime control
+        void  set_scale(float scale) noexcept override;
+        float scale() const noexcept override;
+
+        void  set_modes(const std::vector<int>& modes) override;
+        std::vector<int> modes() const override;
+
+        // work
+        int work(int noutput_items,
+                 gr_vector_const_void_star& input_items,
+                 gr_vector_void_star& output_items) override;
+
+    private:
+        mutable boost::mutex d_mutex;
+        float d_scale;
+        std::vector<int> d_modes;
+
+        std::vector<int> d_active;   // work() snapshot of d_modes, per output
+    };
+
+}} // namespace gr::howto
+
+#endif /* INCLUDED_HOWTO_IQ_SELECT_MULTI_CF_IMPL_H */
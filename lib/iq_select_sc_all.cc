@@ -0,0 +1,21 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#include <howto/iq_select_sc16f.h>
+#include <howto/iq_select_sc8f.h>
+#include "iq_select_sc_impl.h"
+
+namespace gr { namespace howto {
+
+iq_select_sc16f::sptr iq_select_sc16f::make(float scale, int mode)
+{
+    return gnuradio::get_initial_sptr(
+        new iq_select_sc_impl<int16_t, iq_select_sc16f>("iq_select_sc16f", scale, mode));
+}
+
+iq_select_sc8f::sptr iq_select_sc8f::make(float scale, int mode)
+{
+    return gnuradio::get_initial_sptr(
+        new iq_select_sc_impl<int8_t, iq_select_sc8f>("iq_select_sc8f", scale, mode));
+}
+
+}} // namespace gr::howto
@@ -0,0 +1,84 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifndef INCLUDED_HOWTO_IQ_SELECT_SC_IMPL_H
+#define INCLUDED_HOWTO_IQ_SELECT_SC_IMPL_H
+
+#include "sc_iq.h"
+#include "pointwise_stages.h"
+#include <gnuradio/io_signature.h>
+#include <boost/thread/mutex.hpp>
+
+namespace gr { 
+  namespace howto {
+
+    /*
+     * Shared implementation of iq_select_sc16f / iq_select_sc8f. The pw
+     * stages read sc_iq<T> directly, so each sample is widened to float in
+     * the same loop that computes the selected feature.
+     */
+    template<class T, class Iface>
+    class iq_select_sc_impl final : public Iface
+    {
+    public:
+        iq_select_sc_impl(const char* name, float scale, int mode)
+        : gr::sync_block(name,
+              gr::io_signature::make(1, 1, sizeof(sc_iq<T>)),
+              gr::io_signature::make(1, 1, sizeof(float))),
+          d_scale(scale), d_mode(mode)
+        {
+        }
+        ~iq_select_sc_impl() noexcept override {}
+
+        void  set_scale(float s) noexcept override
+        { boost::lock_guard<boost::mutex> lk(d_mutex); d_scale = s; }
+        float scale() const noexcept override
+        { boost::lock_guard<boost::mutex> lk(d_mutex); return d_scale; }
+
+        void  set_mode(int m) noexcept override
+        { boost::lock_guard<boost::mutex> lk(d_mutex); d_mode = m; }
+        int   mode() const noexcept override
+        { boost::lock_guard<boost::mutex> lk(d_mutex); return d_mode; }
+
+        int work(int noutput_items,
+                 gr_vector_const_void_star& input_items,
+                 gr_vector_void_star& output_items) override
+        {
+            const sc_iq<T>* in  = static_cast<const sc_iq<T>*>(input_items[0]);
+            float*          out = static_cast<float*>(output_items[0]);
+
+            float sc; int m;
+            {
+                boost::lock_guard<boost::mutex> lk(d_mutex);
+                sc = d_scale;
+                m  = d_mode;
+            }
+
+            // La normalizacion a full scale se pliega en la ganancia final
+            const float fs = sc_full_scale<T>::inv();
+            switch (m) {
+                case 0: pw::run(pw::mag()       | pw::gain(sc * fs),      in, out, noutput_items); break;
+                case 1: pw::run(pw::power()     | pw::gain(sc * fs * fs), in, out, noutput_items); break;
+                case 2: pw::run(pw::phase()     | pw::gain(sc),           in, out, noutput_items); break;
+                case 3: pw::run(pw::real()      | pw::gain(sc * fs),      in, out, noutput_items); break;
+                case 4: pw::run(pw::imag()      | pw::gain(sc * fs),      in, out, noutput_items); break;
+                case 5: pw::run(pw::abs_phase() | pw::gain(sc),           in, out, noutput_items); break;
+
+                default: // modo inválido -> cero
+                    for (int i = 0; i < noutput_items; ++i) {
+                        out[i] = 0.0f;
+                    }
+                    break;
+            }
+
+            return noutput_items;
+        }
+
+    private:
+        mutable boost::mutex d_mutex;
+        float d_scale;
+        int   d_mode;
+    };
+
+}} // namespace gr::howto
+
+#endif /* INCLUDED_HOWTO_IQ_SELECT_SC_IMPL_H */
@@ -0,0 +1,115 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_MEAN_DECIM_KERNELS_H
+#define INCLUDED_HOWTO_MEAN_DECIM_KERNELS_H
+
+#include <cstddef>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Block-mean decimation kernels: out[i] = mean(in[i*D .. i*D + D-1]).
+	 * Common D (2, 4, 8, 16, 32) get a compile-time unrolled kernel; any
+	 * other D goes through the generic SIMD reduction.
+	 */
+	typedef void (*mean_decim_fn)(const float* in, float* out, int nout, int D);
+
+#if defined(__SSE__)
+	static inline float hsum_ps_(__m128 v) noexcept
+	{
+	  const __m128 hi = _mm_movehl_ps(v, v);          // [2 3 2 3]
+	  const __m128 s  = _mm_add_ps(v, hi);            // [0+2 1+3 ..]
+	  const __m128 s1 = _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1));
+	  return _mm_cvtss_f32(_mm_add_ss(s, s1));
+	}
+#endif
+
+	template<int D>
+	static void mean_decim_fixed(const float* in, float* out, int nout, int /*D*/) noexcept
+	{
+	  const float inv = 1.0f / (float)D;
+	  int i = 0;
+#if defined(__SSE__)
+	  const __m128 vinv = _mm_set1_ps(inv);
+	  if (D == 2) {
+	    // 8 inputs -> 4 outputs: split even/odd lanes and add
+	    for (; i + 4 <= nout; i += 4) {
+	      const __m128 a  = _mm_loadu_ps(in + 2 * i);
+	      const __m128 b  = _mm_loadu_ps(in + 2 * i + 4);
+	      const __m128 ev = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+	      const __m128 od = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+	      _mm_storeu_ps(out + i, _mm_mul_ps(_mm_add_ps(ev, od), vinv));
+	    }
+	  } else if (D % 4 == 0) {
+	    // 4 outputs at a time: vertical partial sums per window, then one
+	    // 4x4 transpose turns the four horizontal reductions into vertical adds
+	    for (; i + 4 <= nout; i += 4) {
+	      const float* p = in + (size_t)i * D;
+	      __m128 r0 = _mm_loadu_ps(p);
+	      __m128 r1 = _mm_loadu_ps(p + D);
+	      __m128 r2 = _mm_loadu_ps(p + 2 * D);
+	      __m128 r3 = _mm_loadu_ps(p + 3 * D);
+	      for (int k = 4; k < D; k += 4) {
+	        r0 = _mm_add_ps(r0, _mm_loadu_ps(p + k));
+	        r1 = _mm_add_ps(r1, _mm_loadu_ps(p + D + k));
+	        r2 = _mm_add_ps(r2, _mm_loadu_ps(p + 2 * D + k));
+	        r3 = _mm_add_ps(r3, _mm_loadu_ps(p + 3 * D + k));
+	      }
+	      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	      const __m128 s = _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3));
+	      _mm_storeu_ps(out + i, _mm_mul_ps(s, vinv));
+	    }
+	  }
+#endif
+	  for (; i < nout; ++i) {
+	    const float* p = in + (size_t)i * D;
+	    float acc = 0.0f;
+	    for (int k = 0; k < D; ++k) acc += p[k];
+	    out[i] = acc * inv;
+	  }
+	}
+
+	static void mean_decim_generic(const float* in, float* out, int nout, int D) noexcept
+	{
+	  const float inv = 1.0f / (float)D;
+	  for (int i = 0; i < nout; ++i) {
+	    const float* p = in + (size_t)i * D;
+	    int k = 0;
+	    float acc = 0.0f;
+#if defined(__SSE__)
+	    if (D >= 8) {
+	      __m128 a0 = _mm_setzero_ps();
+	      __m128 a1 = _mm_setzero_ps();
+	      for (; k + 8 <= D; k += 8) {
+	        a0 = _mm_add_ps(a0, _mm_loadu_ps(p + k));
+	        a1 = _mm_add_ps(a1, _mm_loadu_ps(p + k + 4));
+	      }
+	      acc = hsum_ps_(_mm_add_ps(a0, a1));
+	    }
+#endif
+	    for (; k < D; ++k) acc += p[k];
+	    out[i] = acc * inv;
+	  }
+	}
+
+	static inline mean_decim_fn select_mean_decim(int D) noexcept
+	{
+	  switch (D) {
+	    case 2:  return &mean_decim_fixed<2>;
+	    case 4:  return &mean_decim_fixed<4>;
+	    case 8:  return &mean_decim_fixed<8>;
+	    case 16: return &mean_decim_fixed<16>;
+	    case 32: return &mean_decim_fixed<32>;
+	    default: return &mean_decim_generic;
+	  }
+	}
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_MEAN_DECIM_KERNELS_H */
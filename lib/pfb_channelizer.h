@@ -0,0 +1,142 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_PFB_CHANNELIZER_H
+#define INCLUDED_HOWTO_PFB_CHANNELIZER_H
+
+#include "fir_fold.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/fft/fft.h>
+#include <boost/scoped_ptr.hpp>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Polyphase analysis filter bank: M channels centred on k*fs/M, each the
+	 * output of "mix by e^{-j 2pi k m/M}, low-pass h, keep one sample every
+	 * S = M/os inputs" (os = 1 critically sampled, 2 oversampled).
+	 *
+	 * With t the newest input of an output and h split into M branches
+	 * p_r[q] = h[qM + r] (K = ceil(T/M) taps each):
+	 *
+	 *   y_k = e^{-j 2pi k t/M} * sum_r e^{j 2pi k r/M} v_r,
+	 *   v_r = sum_q p_r[q] x[t - r - qM]
+	 *
+	 * so one output frame is M branch products (K MACs each) plus one
+	 * backward FFT, the e^{-j 2pi k t/M} factor being a circular shift of
+	 * the FFT input by -t mod M. Per input sample: K*os MACs and
+	 * os*log2(M) FFT work, instead of M*T for M separate xlating filters.
+	 *
+	 * Branch r reads inputs of one residue class mod M, so the inputs are
+	 * kept deinterleaved per class (the last K of each) and every branch
+	 * window is contiguous for fir_dot.
+	 */
+	class pfb_analysis
+	{
+	public:
+	  pfb_analysis() : d_M(0), d_os(1), d_K(0), d_base(0) {}
+
+	  void set(const std::vector<float>& proto, int M, int os)
+	  {
+	    if (M < 2) throw std::invalid_argument("nchans must be >= 2");
+	    if (os != 1 && os != 2) throw std::invalid_argument("oversample must be 1 or 2");
+	    if (os == 2 && (M & 1)) throw std::invalid_argument("oversample 2 needs an even nchans");
+	    if (proto.empty()) throw std::invalid_argument("empty prototype");
+
+	    const bool restart = M != d_M;
+	    if (restart) d_fft.reset(new gr::fft::fft_complex(M, false, 1));
+	    d_M = M;
+	    d_os = os;
+	    d_K = (int)((proto.size() + M - 1) / M);
+	    d_branch.assign(M, fir_fold_taps());
+	    for (int r = 0; r < M; ++r) {
+	      std::vector<float> g(d_K, 0.0f);
+	      for (int q = 0; q < d_K; ++q)
+		if ((size_t)q * M + r < proto.size()) g[q] = proto[q * M + r];
+	      d_branch[r].set(g);
+	    }
+	    if (restart) {
+	      d_cls.resize(M);
+	      reset();
+	      return;
+	    }
+	    // Same M (a prototype redesign mid-stream): d_base and the history
+	    // stay, so the delay lines and the e^{-j 2pi k t/M} phase carry on;
+	    // a new K keeps the newest min(old K, new K) of each class.
+	    for (int c = 0; c < M; ++c) {
+	      std::vector<gr_complex>& b = d_cls[c];
+	      if ((int)b.size() > d_K) b.erase(b.begin(), b.end() - d_K);
+	      else b.insert(b.begin(), d_K - b.size(), gr_complex(0.0f, 0.0f));
+	    }
+	  }
+
+	  int nchans() const { return d_M; }
+	  int step() const { return d_M / d_os; }
+	  int taps_per_branch() const { return d_K; }
+
+	  void reset()
+	  {
+	    for (int c = 0; c < d_M; ++c) d_cls[c].assign(d_K, gr_complex(0.0f, 0.0f));
+	    d_base = 0;
+	  }
+
+	  /*!
+	   * Consumes nout * step() inputs and writes nout samples to each of
+	   * the first nouts channel outputs (the FFT always computes all M).
+	   */
+	  void process(const gr_complex* in, int nout, gr_complex* const* outs, int nouts)
+	  {
+	    const int M = d_M, K = d_K, S = step();
+	    const int nin = nout * S;
+
+	    // Deinterleave: class c gets the chunk samples with (base + i) % M == c
+	    for (int c = 0; c < M; ++c) {
+	      const int f = (c - d_base + M) % M;    // first i of class c
+	      std::vector<gr_complex>& b = d_cls[c];
+	      b.resize(K);
+	      for (int i = f; i < nin; i += M) b.push_back(in[i]);
+	    }
+
+	    gr_complex* fin  = d_fft->get_inbuf();
+	    const gr_complex* fout = d_fft->get_outbuf();
+	    for (int j = 0; j < nout; ++j) {
+	      const int i_t = (j + 1) * S - 1;             // newest input, chunk relative
+	      const int t_mod = (d_base + i_t) % M;
+	      const int shift = (M - t_mod) % M;
+	      for (int r = 0; r < M; ++r) {
+		// x[t - r] is in class c at position K + (i - f)/M (i - f is a
+		// multiple of M, >= -M: at worst the newest history sample)
+		const int i = i_t - r;
+		const int c = (t_mod - r + M) % M;
+		const int f = (c - d_base + M) % M;
+		const int pos = K + (i - f) / M;
+		const gr_complex* w = &d_cls[c][0] + pos - K + 1;  // oldest .. newest
+		fin[(r + shift) % M] = fir_dot(w, d_branch[r]);
+	      }
+	      d_fft->execute();
+	      for (int k = 0; k < nouts; ++k) outs[k][j] = fout[k];
+	    }
+
+	    // Keep the last K of every class
+	    for (int c = 0; c < M; ++c) {
+	      std::vector<gr_complex>& b = d_cls[c];
+	      b.erase(b.begin(), b.end() - K);
+	    }
+	    d_base = (d_base + nin) % M;
+	  }
+
+	private:
+	  int d_M, d_os, d_K;
+	  std::vector<fir_fold_taps> d_branch;            // M branches of K taps
+	  std::vector<std::vector<gr_complex> > d_cls;    // per residue class: last K + chunk
+	  int d_base;                                     // absolute index of in[0], mod M
+	  boost::scoped_ptr<gr::fft::fft_complex> d_fft;  // M-point, backward
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_PFB_CHANNELIZER_H */
@@ -0,0 +1,124 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "pfb_channelizer_cc_impl.h"
+#include "decim_planner.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+
+using gr::filter::firdes;
+
+namespace gr {
+    namespace howto {
+
+	pfb_channelizer_cc::sptr
+	pfb_channelizer_cc::make(int nchans, double fs, double cutoff, double trans,
+				 int oversample, int window, double beta)
+	{
+	  if (nchans < 2) throw std::invalid_argument("nchans must be >= 2");
+	  if (oversample != 1 && oversample != 2) throw std::invalid_argument("oversample must be 1 or 2");
+	  if (oversample == 2 && (nchans & 1)) throw std::invalid_argument("oversample 2 needs an even nchans");
+
+	  return gnuradio::get_initial_sptr(
+	    new pfb_channelizer_cc_impl(nchans, fs, cutoff, trans, oversample,
+					static_cast<firdes::win_type>(window), beta));
+	}
+
+	// -------- impl --------
+
+	pfb_channelizer_cc_impl::pfb_channelizer_cc_impl(int nchans, double fs, double cutoff,
+							 double trans, int oversample,
+							 firdes::win_type window, double beta)
+	: gr::sync_decimator("pfb_channelizer_cc",
+			     gr::io_signature::make(1, 1, sizeof(gr_complex)),
+			     gr::io_signature::make(1, nchans, sizeof(gr_complex)),
+			     nchans / oversample),
+	  d_M(nchans),
+	  d_os(oversample),
+	  d_fs(fs),
+	  d_cutoff(cutoff),
+	  d_trans(trans),
+	  d_window(window),
+	  d_beta(beta),
+	  d_dirty(true)
+	{
+	  if (d_fs <= 0.0)     throw std::invalid_argument("samp_rate must be > 0");
+	  if (d_cutoff <= 0.0) throw std::invalid_argument("cutoff must be > 0");
+	  if (d_trans <= 0.0)  throw std::invalid_argument("transition must be > 0");
+
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  design_taps_locked();
+	}
+
+	void pfb_channelizer_cc_impl::design_taps_locked()
+	{
+	  // Same low-pass as decimate_fir_cc, split into nchans branches.
+	  // The filter bank keeps its own state: history stays 1
+	  const decim_spec spec = { d_M, d_fs, d_cutoff, d_trans, d_window, d_beta };
+	  d_taps = design_lowpass(spec, 1.0, d_fs);
+	  d_pfb.set(d_taps, d_M, d_os);
+	  d_dirty = false;
+	}
+
+	std::vector<float> pfb_channelizer_cc_impl::taps() const
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_taps;
+	}
+
+	int pfb_channelizer_cc_impl::taps_per_branch() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return (int)((d_taps.size() + d_M - 1) / d_M);
+	}
+
+	// ---- setters: cheap, just mark dirty ----
+	void pfb_channelizer_cc_impl::set_cutoff(double fc)
+	{
+	  if (fc <= 0.0) throw std::invalid_argument("cutoff must be > 0");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (fc != d_cutoff) { d_cutoff = fc; d_dirty = true; }
+	}
+
+	void pfb_channelizer_cc_impl::set_transition(double tw)
+	{
+	  if (tw <= 0.0) throw std::invalid_argument("transition must be > 0");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (tw != d_trans) { d_trans = tw; d_dirty = true; }
+	}
+
+	void pfb_channelizer_cc_impl::set_window(int w)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  firdes::win_type neww = static_cast<firdes::win_type>(w);
+	  if (neww != d_window) { d_window = neww; d_dirty = true; }
+	}
+
+	void pfb_channelizer_cc_impl::set_kaiser_beta(double beta)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (beta != d_beta) { d_beta = beta; d_dirty = true; }
+	}
+
+	int pfb_channelizer_cc_impl::work(int noutput_items,
+					  gr_vector_const_void_star &input_items,
+					  gr_vector_void_star &output_items)
+	{
+	  const gr_complex* in = static_cast<const gr_complex*>(input_items[0]);
+
+	  {
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    // Rate and history do not depend on the prototype: re-design in place
+	    if (d_dirty) design_taps_locked();
+	  }
+
+	  // Only the connected outputs are written
+	  d_outs.resize(output_items.size());
+	  for (size_t k = 0; k < output_items.size(); ++k)
+	    d_outs[k] = static_cast<gr_complex*>(output_items[k]);
+	  d_pfb.process(in, noutput_items, &d_outs[0], (int)d_outs.size());
+	  return noutput_items;
+	}
+
+}} // namespace gr::howto
@@ -0,0 +1,66 @@
+#ifndef INCLUDED_HOWTO_PFB_CHANNELIZER_CC_IMPL_H
+#define INCLUDED_HOWTO_PFB_CHANNELIZER_CC_IMPL_H
+
+#include <howto/pfb_channelizer_cc.h>
+#include "pfb_channelizer.h"
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+#include <gnuradio/filter/firdes.h>
+using gr::filter::firdes;
+
+namespace gr {
+
+   namespace howto {
+
+	class pfb_channelizer_cc_impl final : public pfb_channelizer_cc
+	{
+	private:
+	  const int d_M;
+	  const int d_os;
+
+	  // Parameters guarded by d_mutex
+	  mutable boost::mutex d_mutex;
+	  double d_fs;
+	  double d_cutoff;
+	  double d_trans;
+	  firdes::win_type d_window;
+	  double d_beta;
+	  bool   d_dirty;
+
+	  std::vector<float> d_taps;   // prototype
+	  pfb_analysis d_pfb;          // only rebuilt from work()/ctor
+	  std::vector<gr_complex*> d_outs;
+
+	  void design_taps_locked();   // assumes d_mutex locked
+
+	public:
+	  pfb_channelizer_cc_impl(int nchans, double fs, double cutoff, double trans,
+				  int oversample, firdes::win_type window, double beta); /* may throw */
+
+	  ~pfb_channelizer_cc_impl() override = default;
+
+	  // Queries
+	  int    nchans()      const noexcept override { return d_M; }
+	  int    oversample()  const noexcept override { return d_os; }
+	  double samp_rate()   const noexcept override { return d_fs; }
+	  double cutoff()      const noexcept override { return d_cutoff; }
+	  double transition()  const noexcept override { return d_trans; }
+	  int    window()      const noexcept override { return static_cast<int>(d_window); }
+	  double kaiser_beta() const noexcept override { return d_beta; }
+	  std::vector<float> taps() const override;
+	  int    taps_per_branch() const noexcept override;
+
+	  // Setters (mark dirty, cheap)
+	  void set_cutoff(double fc) override;
+	  void set_transition(double tw) override;
+	  void set_window(int w) override;
+	  void set_kaiser_beta(double beta) override;
+
+	  int work(int noutput_items,
+		   gr_vector_const_void_star &input_items,
+		   gr_vector_void_star &output_items) override;
+	};
+
+}} // namespace gr::howto
+#endif
@@ -0,0 +1,99 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#include "pointwise_chain_cf_impl.h"
+#include "pointwise_stages.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+
+namespace gr { namespace howto {
+
+pointwise_chain_cf::sptr pointwise_chain_cf::make(int mode, bool square, float gain)
+{
+    return gnuradio::get_initial_sptr(new pointwise_chain_cf_impl(mode, square, gain));
+}
+
+pointwise_chain_cf_impl::pointwise_chain_cf_impl(int mode, bool square, float gain)
+: gr::sync_block("pointwise_chain_cf",
+                 gr::io_signature::make(1, 1, sizeof(gr_complex)),
+                 gr::io_signature::make(1, 1, sizeof(float))),
+  d_mode(mode), d_square(square), d_gain(gain)
+{
+}
+
+void pointwise_chain_cf_impl::set_mode(int m) noexcept
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    d_mode = m;
+}
+
+int pointwise_chain_cf_impl::mode() const noexcept
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    return d_mode;
+}
+
+void pointwise_chain_cf_impl::set_square(bool sq) noexcept
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    d_square = sq;
+}
+
+bool pointwise_chain_cf_impl::square() const noexcept
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    return d_square;
+}
+
+void pointwise_chain_cf_impl::set_gain(float g) noexcept
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    d_gain = g;
+}
+
+float pointwise_chain_cf_impl::gain() const noexcept
+{
+    boost::lock_guard<boost::mutex> lk(d_mutex);
+    return d_gain;
+}
+
+// One fused loop per (selector, square) pair; the choice is made once per call
+template<class Sel>
+static void run_chain_(const pw::stage<Sel>& sel, bool sq, float g,
+                       const gr_complex* in, float* out, int n)
+{
+    if (sq) pw::run(sel | pw::square() | pw::gain(g), in, out, n);
+    else    pw::run(sel | pw::gain(g), in, out, n);
+}
+
+int pointwise_chain_cf_impl::work(int noutput_items,
+                                  gr_vector_const_void_star& input_items,
+                                  gr_vector_void_star& output_items)
+{
+    const gr_complex* in  = static_cast<const gr_complex*>(input_items[0]);
+    float*            out = static_cast<float*>(output_items[0]);
+
+    // Snapshot de parámetros fuera del bucle
+    int m; bool sq; float g;
+    {
+        boost::lock_guard<boost::mutex> lk(d_mutex);
+        m  = d_mode;
+        sq = d_square;
+        g  = d_gain;
+    }
+
+    switch (m) {
+        case 0: run_chain_(pw::mag(),       sq, g, in, out, noutput_items); break;
+        case 1: run_chain_(pw::power(),     sq, g, in, out, noutput_items); break;
+        case 2: run_chain_(pw::phase(),     sq, g, in, out, noutput_items); break;
+        case 3: run_chain_(pw::real(),      sq, g, in, out, noutput_items); break;
+        case 4: run_chain_(pw::imag(),      sq, g, in, out, noutput_items); break;
+        case 5: run_chain_(pw::abs_phase(), sq, g, in, out, noutput_items); break;
+        default: // modo inválido -> cero
+            std::fill(out, out + noutput_items, 0.0f);
+            break;
+    }
+
+    return noutput_items;
+}
+
+}} // namespace gr::howto
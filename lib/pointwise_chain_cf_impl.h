@@ -0,0 +1,42 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifndef INCLUDED_HOWTO_POINTWISE_CHAIN_CF_IMPL_H
+#define INCLUDED_HOWTO_POINTWISE_CHAIN_CF_IMPL_H
+
+#include <howto/pointwise_chain_cf.h>
+#include <boost/thread/mutex.hpp>
+
+namespace gr {
+  namespace howto {
+
+    class pointwise_chain_cf_impl final : public pointwise_chain_cf
+    {
+    public:
+        pointwise_chain_cf_impl(int mode, bool square, float gain);
+        ~pointwise_chain_cf_impl() noexcept override {}
+
+        // runtime control
+        void  set_mode(int mode) noexcept override;
+        int   mode() const noexcept override;
+
+        void  set_square(bool square) noexcept override;
+        bool  square() const noexcept override;
+
+        void  set_gain(float gain) noexcept override;
+        float gain() const noexcept override;
+
+        // work
+        int work(int noutput_items,
+                 gr_vector_const_void_star& input_items,
+                 gr_vector_void_star& output_items) override;
+
+    private:
+        mutable boost::mutex d_mutex;
+        int   d_mode;
+        bool  d_square;
+        float d_gain;
+    };
+
+}} // namespace gr::howto
+
+#endif /* INCLUDED_HOWTO_POINTWISE_CHAIN_CF_IMPL_H */
@@ -0,0 +1,108 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifndef INCLUDED_HOWTO_POINTWISE_STAGES_H
+#define INCLUDED_HOWTO_POINTWISE_STAGES_H
+
+#include <gnuradio/gr_complex.h>
+#include <cmath>
+
+namespace gr {
+  namespace howto {
+    namespace pw {
+
+    /*
+     * Point-wise stages shared by iq_mag_cf, iq_select_cf, iq_select_sc,
+     * pointwise_chain_cf and fir_pipeline_cf. Stages compose at compile time with '|':
+     *
+     *   pw::run(pw::mag() | pw::square() | pw::gain(g), in, out, n);
+     *
+     * builds one functor, so the whole chain is a single loop with no
+     * intermediate buffers (each input sample is loaded once).
+     * The complex stages accept any type with real()/imag() (gr_complex,
+     * sc16_t, sc8_t), so integer IQ is widened inside the same loop.
+     */
+    template<class D> struct stage {};
+
+    // ---- complex -> float ----
+    struct mag : stage<mag> {          // |x|
+      template<class C> float operator()(const C& x) const
+      { const float re = x.real(), im = x.imag(); return std::sqrt(re * re + im * im); }
+    };
+    struct power : stage<power> {      // |x|^2
+      template<class C> float operator()(const C& x) const
+      { const float re = x.real(), im = x.imag(); return re * re + im * im; }
+    };
+    struct phase : stage<phase> {      // arg(x)
+      template<class C> float operator()(const C& x) const
+      { return std::atan2((float)x.imag(), (float)x.real()); }
+    };
+    struct abs_phase : stage<abs_phase> { // |arg(x)|
+      template<class C> float operator()(const C& x) const
+      { return std::fabs(std::atan2((float)x.imag(), (float)x.real())); }
+    };
+    struct real : stage<real> {        // Re{x}
+      template<class C> float operator()(const C& x) const { return x.real(); }
+    };
+    struct imag : stage<imag> {        // Im{x}
+      template<class C> float operator()(const C& x) const { return x.imag(); }
+    };
+
+    // ---- float -> float ----
+    struct square : stage<square> {
+      float operator()(float x) const { return x * x; }
+    };
+    struct gain : stage<gain> {
+      float g;
+      explicit gain(float g_) : g(g_) {}
+      float operator()(float x) const { return g * x; }
+    };
+
+    // ---- composition ----
+    template<class A, class B>
+    struct chain : stage<chain<A, B> > {
+      A a; B b;
+      chain(const A& a_, const B& b_) : a(a_), b(b_) {}
+      template<class T>
+      float operator()(const T& x) const { return b(a(x)); }
+    };
+
+    // |x| followed by ^2 is |x|^2: drop the sqrt
+    template<>
+    struct chain<mag, square> : stage<chain<mag, square> > {
+      chain(const mag&, const square&) {}
+      template<class C> float operator()(const C& x) const { return power()(x); }
+    };
+
+    template<class A, class B>
+    inline chain<A, B> operator|(const stage<A>& a, const stage<B>& b)
+    {
+      return chain<A, B>(static_cast<const A&>(a), static_cast<const B&>(b));
+    }
+
+    // Consecutive gains fold into one multiply: appending a gain to a chain
+    // that already ends in one gives the same chain type back, so any run
+    // of gains stays a single stage
+    template<class A>
+    inline chain<A, gain> operator|(const chain<A, gain>& ab, const gain& c)
+    {
+      return chain<A, gain>(ab.a, gain(ab.b.g * c.g));
+    }
+
+    inline gain operator|(const gain& a, const gain& b)
+    {
+      return gain(a.g * b.g);
+    }
+
+    //! Apply a (possibly composed) stage over n items.
+    template<class F, class Tin>
+    inline void run(const F& f, const Tin* in, float* out, int n)
+    {
+      for (int i = 0; i < n; ++i)
+        out[i] = f(in[i]);
+    }
+
+    } // namespace pw
+  } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_POINTWISE_STAGES_H */
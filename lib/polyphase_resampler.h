@@ -0,0 +1,116 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_POLYPHASE_RESAMPLER_H
+#define INCLUDED_HOWTO_POLYPHASE_RESAMPLER_H
+
+#include "fir_fold.h"
+#include <gnuradio/gr_complex.h>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Rational L/M resampler, polyphase form.
+	 *
+	 * Conceptually: zero-stuff by L, low-pass h (designed at L*fs, gain L),
+	 * keep every M-th sample. Output n sits at upsampled time n*M, i.e.
+	 * newest input i = floor(n*M / L) and phase p = n*M mod L, and only the
+	 * taps that meet a non-zero sample are used:
+	 *
+	 *   y[n] = sum_k h[p + k*L] * x[i - k]
+	 *
+	 * so each output costs K = ceil(T/L) MACs over branch p (a fir_dot with
+	 * the same window convention as fir_decim_stage). Only the phases that
+	 * are actually needed are computed. The stage keeps its own delay line
+	 * (the last K inputs: with L > M consecutive outputs can share their
+	 * newest input), so the block runs with history(1).
+	 */
+	class polyphase_resampler
+	{
+	public:
+	  polyphase_resampler() : d_L(1), d_M(1), d_K(1) { reset(); }
+
+	  void set(const std::vector<float>& proto, int L, int M)
+	  {
+	    if (L < 1 || M < 1) throw std::invalid_argument("interp/decim must be >= 1");
+	    if (proto.empty()) throw std::invalid_argument("empty prototype");
+	    d_L = L;
+	    d_M = M;
+	    d_K = (int)((proto.size() + L - 1) / L);
+	    d_branch.assign(L, fir_fold_taps());
+	    for (int p = 0; p < L; ++p) {
+	      std::vector<float> g(d_K, 0.0f);
+	      for (int k = 0; k < d_K; ++k)
+		if (p + (size_t)k * L < proto.size()) g[k] = proto[p + k * L];
+	      d_branch[p].set(g);
+	    }
+	    reset();
+	  }
+
+	  int interpolation() const { return d_L; }
+	  int decimation() const { return d_M; }
+	  int taps_per_phase() const { return d_K; }
+
+	  void reset()
+	  {
+	    d_buf.assign(d_K, gr_complex(0.0f, 0.0f));
+	    d_phase = 0;
+	    d_adv = 1;          // the first output waits for input 0
+	  }
+
+	  //! Inputs needed for nout more outputs
+	  long inputs_for(int nout) const
+	  {
+	    // newest input of output nout-1, relative to the next unconsumed one
+	    if (nout <= 0) return 0;
+	    return d_adv + ((long)d_phase + (long)(nout - 1) * d_M) / d_L;
+	  }
+
+	  /*!
+	   * Produces up to max_out outputs from at most nin inputs and consumes
+	   * exactly the inputs up to the newest one used. Returns the number of
+	   * outputs; *consumed gets the inputs used. newest (if non-null) gets,
+	   * per output, the index of its newest input relative to in[0].
+	   */
+	  int process(const gr_complex* in, int nin, gr_complex* out, int max_out,
+		      int* consumed, std::vector<int>* newest = 0)
+	  {
+	    const int H = d_K;
+	    d_buf.resize(H + nin);
+	    std::copy(in, in + nin, d_buf.begin() + H);
+
+	    const gr_complex* w = &d_buf[1];  // w[p] .. w[p+K-1] = in[p-K+1 .. p]
+	    int p = -1;                      // newest input used, relative to in[0]
+	    int n = 0;
+	    if (newest) newest->clear();
+	    while (n < max_out && p + d_adv < nin) {
+	      p += d_adv;
+	      out[n++] = fir_dot(w + p, d_branch[d_phase]);
+	      if (newest) newest->push_back(p);
+	      d_phase += d_M;
+	      d_adv = d_phase / d_L;
+	      d_phase -= d_adv * d_L;
+	    }
+
+	    const int used = p + 1;
+	    d_buf.erase(d_buf.begin(), d_buf.begin() + used);   // keep the last K
+	    d_buf.resize(H);
+	    *consumed = used;
+	    return n;
+	  }
+
+	private:
+	  int d_L, d_M, d_K;
+	  std::vector<fir_fold_taps> d_branch;   // L branches of K taps
+	  std::vector<gr_complex> d_buf;         // last K inputs + current chunk
+	  int d_phase;                           // phase of the next output
+	  int d_adv;                             // inputs to take before it
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_POLYPHASE_RESAMPLER_H */
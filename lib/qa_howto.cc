@@ -26,11 +26,13 @@
  */
 
 #include "qa_howto.h"
+#include "qa_pointwise_stages.h"
 
 CppUnit::TestSuite *
 qa_howto::suite()
 {
   CppUnit::TestSuite *s = new CppUnit::TestSuite("howto");
+  s->addTest(gr::howto::qa_pointwise_stages::suite());
 
   return s;
 }
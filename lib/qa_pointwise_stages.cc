@@ -0,0 +1,43 @@
+/* -*- c++ -*- */
+#include "qa_pointwise_stages.h"
+#include "pointwise_stages.h"
+#include <gnuradio/gr_complex.h>
+#include <cppunit/TestAssert.h>
+#include <boost/type_traits/is_same.hpp>
+
+namespace gr {
+  namespace howto {
+
+    // Any number of trailing gains is one chain<..., gain> (one multiply)
+    template<class T>
+    static bool one_gain_(const T&) { return false; }
+    template<class A>
+    static bool one_gain_(const pw::chain<A, pw::gain>&)
+    { return !boost::is_same<A, pw::gain>::value; }
+
+    void
+    qa_pointwise_stages::t1_gain_runs_fold()
+    {
+      const gr_complex x(3.0f, 4.0f);
+      const pw::chain<pw::mag, pw::gain> c = pw::mag() | pw::gain(2) | pw::gain(3) | pw::gain(4);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(120.0, c(x), 1e-5);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(24.0, c.b.g, 0.0);
+      CPPUNIT_ASSERT(one_gain_(pw::real() | pw::gain(2) | pw::gain(3) | pw::gain(4) | pw::gain(5)));
+
+      const pw::gain g = pw::gain(2) | pw::gain(5);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, g.g, 0.0);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0, (g | pw::square())(1.0f), 1e-5);
+    }
+
+    void
+    qa_pointwise_stages::t2_mag_square_then_gains()
+    {
+      const gr_complex x(3.0f, 4.0f);
+      const pw::chain<pw::chain<pw::mag, pw::square>, pw::gain> c =
+        pw::mag() | pw::square() | pw::gain(2) | pw::gain(3);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(150.0, c(x), 1e-4);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, c.b.g, 0.0);
+    }
+
+  } /* namespace howto */
+} /* namespace gr */
@@ -0,0 +1,27 @@
+/* -*- c++ -*- */
+#ifndef _QA_POINTWISE_STAGES_H_
+#define _QA_POINTWISE_STAGES_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestCase.h>
+
+namespace gr {
+  namespace howto {
+
+    class qa_pointwise_stages : public CppUnit::TestCase
+    {
+    public:
+      CPPUNIT_TEST_SUITE(qa_pointwise_stages);
+      CPPUNIT_TEST(t1_gain_runs_fold);
+      CPPUNIT_TEST(t2_mag_square_then_gains);
+      CPPUNIT_TEST_SUITE_END();
+
+    private:
+      void t1_gain_runs_fold();
+      void t2_mag_square_then_gains();
+    };
+
+  } /* namespace howto */
+} /* namespace gr */
+
+#endif /* _QA_POINTWISE_STAGES_H_ */
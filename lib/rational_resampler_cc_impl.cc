@@ -0,0 +1,195 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "rational_resampler_cc_impl.h"
+#include "decim_planner.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+#include <algorithm>
+
+using gr::filter::firdes;
+
+namespace gr {
+    namespace howto {
+
+	rational_resampler_cc::sptr
+	rational_resampler_cc::make(int interp, int decim, double fs,
+				    double cutoff, double trans,
+				    int window, double beta)
+	{
+	  return gnuradio::get_initial_sptr(
+	    new rational_resampler_cc_impl(interp, decim, fs, cutoff, trans,
+					   static_cast<firdes::win_type>(window), beta));
+	}
+
+	static int gcd_(int a, int b)
+	{
+	  while (b) { const int t = a % b; a = b; b = t; }
+	  return a;
+	}
+
+	// -------- impl --------
+
+	rational_resampler_cc_impl::rational_resampler_cc_impl(int interp, int decim, double fs,
+							       double cutoff, double trans,
+							       firdes::win_type window, double beta)
+	: gr::block("rational_resampler_cc",
+		    gr::io_signature::make(1, 1, sizeof(gr_complex)),
+		    gr::io_signature::make(1, 1, sizeof(gr_complex))),
+	  d_interp(1),
+	  d_decim(1),
+	  d_fs(fs),
+	  d_cutoff(cutoff),
+	  d_trans(trans),
+	  d_window(window),
+	  d_beta(beta),
+	  d_dirty(true)
+	{
+	  if (interp < 1 || decim < 1) throw std::invalid_argument("interp and decim must be >= 1");
+	  if (d_fs <= 0.0)     throw std::invalid_argument("samp_rate must be > 0");
+	  if (d_cutoff <= 0.0) throw std::invalid_argument("cutoff must be > 0");
+	  if (d_trans <= 0.0)  throw std::invalid_argument("transition must be > 0");
+
+	  const int g = gcd_(interp, decim);
+	  d_interp = interp / g;
+	  d_decim  = decim / g;
+
+	  // Tags are remapped in general_work: relative_rate scaling is inexact
+	  // for L/M and ignores where each output actually sits
+	  set_tag_propagation_policy(TPP_DONT);
+
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  design_taps_locked();
+	}
+
+	void rational_resampler_cc_impl::design_taps_locked()
+	{
+	  // Same low-pass as decimate_fir_cc, at the zero-stuffed rate L*fs with
+	  // gain L (zero-stuffing divides the passband level by L)
+	  const decim_spec spec = { d_decim, d_fs, d_cutoff, d_trans, d_window, d_beta };
+	  d_taps = design_lowpass(spec, double(d_interp), d_interp * d_fs);
+	  d_rs.set(d_taps, d_interp, d_decim);
+
+	  this->set_relative_rate(double(d_interp) / double(d_decim));
+	  d_dirty = false;
+	}
+
+	int rational_resampler_cc_impl::interpolation() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_interp;
+	}
+
+	int rational_resampler_cc_impl::decimation() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_decim;
+	}
+
+	// Reflects the last applied design (setters apply on the next work())
+	int rational_resampler_cc_impl::taps_per_phase() const noexcept
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return (int)((d_taps.size() + d_interp - 1) / d_interp);
+	}
+
+	std::vector<float> rational_resampler_cc_impl::taps() const
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  return d_taps;
+	}
+
+	// ---- setters: cheap, just mark dirty ----
+	void rational_resampler_cc_impl::set_rate(int interp, int decim)
+	{
+	  if (interp < 1 || decim < 1) throw std::invalid_argument("interp and decim must be >= 1");
+	  const int g = gcd_(interp, decim);
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (interp / g != d_interp || decim / g != d_decim) {
+	    d_interp = interp / g;
+	    d_decim  = decim / g;
+	    d_dirty  = true;
+	  }
+	}
+
+	void rational_resampler_cc_impl::set_samp_rate(double fs)
+	{
+	  if (fs <= 0.0) throw std::invalid_argument("samp_rate must be > 0");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (fs != d_fs) { d_fs = fs; d_dirty = true; }
+	}
+
+	void rational_resampler_cc_impl::set_cutoff(double fc)
+	{
+	  if (fc <= 0.0) throw std::invalid_argument("cutoff must be > 0");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (fc != d_cutoff) { d_cutoff = fc; d_dirty = true; }
+	}
+
+	void rational_resampler_cc_impl::set_transition(double tw)
+	{
+	  if (tw <= 0.0) throw std::invalid_argument("transition must be > 0");
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (tw != d_trans) { d_trans = tw; d_dirty = true; }
+	}
+
+	void rational_resampler_cc_impl::set_window(int w)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  firdes::win_type neww = static_cast<firdes::win_type>(w);
+	  if (neww != d_window) { d_window = neww; d_dirty = true; }
+	}
+
+	void rational_resampler_cc_impl::set_kaiser_beta(double beta)
+	{
+	  boost::lock_guard<boost::mutex> lk(d_mutex);
+	  if (beta != d_beta) { d_beta = beta; d_dirty = true; }
+	}
+
+	// ---- scheduler functions ----
+
+	void rational_resampler_cc_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required)
+	{
+	  // Exact count from the current phase (forecast runs on the work thread).
+	  // Interpolating outputs may need no new input at all; ask for 1 anyway
+	  ninput_items_required[0] = (int)std::max(1L, d_rs.inputs_for(noutput_items));
+	}
+
+	int rational_resampler_cc_impl::general_work(int noutput_items,
+						     gr_vector_int &ninput_items,
+						     gr_vector_const_void_star &input_items,
+						     gr_vector_void_star &output_items)
+	{
+	  const gr_complex* in  = static_cast<const gr_complex*>(input_items[0]);
+	  gr_complex*       out = static_cast<gr_complex*>(output_items[0]);
+
+	  {
+	    boost::lock_guard<boost::mutex> lk(d_mutex);
+	    if (d_dirty) {
+	      // New taps / ratio: restart the phase and let the scheduler pick up
+	      // the new relative_rate
+	      design_taps_locked();
+	      return 0;
+	    }
+	  }
+
+	  // Never copy more input than noutput_items can use
+	  const int nin = (int)std::min<long>(ninput_items[0], d_rs.inputs_for(noutput_items));
+	  int used = 0;
+	  const int nout = d_rs.process(in, nin, out, noutput_items, &used, &d_newest);
+
+	  // Tag on input r0 + r goes to the first output whose newest input is >= r
+	  const uint64_t r0 = nitems_read(0);
+	  get_tags_in_range(d_tags, 0, r0, r0 + used);
+	  for (size_t t = 0; t < d_tags.size(); ++t) {
+	    const int r = (int)(d_tags[t].offset - r0);
+	    const int j = (int)(std::lower_bound(d_newest.begin(), d_newest.end(), r) - d_newest.begin());
+	    add_item_tag(0, nitems_written(0) + j, d_tags[t].key, d_tags[t].value, d_tags[t].srcid);
+	  }
+
+	  consume_each(used);
+	  return nout;
+	}
+
+}} // namespace gr::howto
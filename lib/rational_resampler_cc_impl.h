@@ -0,0 +1,72 @@
+#ifndef INCLUDED_HOWTO_RATIONAL_RESAMPLER_CC_IMPL_H
+#define INCLUDED_HOWTO_RATIONAL_RESAMPLER_CC_IMPL_H
+
+#include <howto/rational_resampler_cc.h>
+#include "polyphase_resampler.h"
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+#include <gnuradio/filter/firdes.h>
+using gr::filter::firdes;
+
+namespace gr {
+
+   namespace howto {
+
+	class rational_resampler_cc_impl final : public rational_resampler_cc
+	{
+	private:
+	  // Parameters guarded by d_mutex
+	  mutable boost::mutex d_mutex;
+	  int    d_interp, d_decim;     // reduced
+	  double d_fs;
+	  double d_cutoff;
+	  double d_trans;
+	  firdes::win_type d_window;
+	  double d_beta;
+	  bool   d_dirty;
+
+	  std::vector<float> d_taps;    // prototype, for taps()
+	  polyphase_resampler d_rs;     // only rebuilt from work()/ctor
+	  std::vector<int> d_newest;    // per-output newest input (tag mapping)
+	  std::vector<gr::tag_t> d_tags;
+
+	  void design_taps_locked();    // assumes d_mutex locked; also sets relative_rate
+
+	public:
+	  rational_resampler_cc_impl(int interp, int decim, double fs,
+				     double cutoff, double trans,
+				     firdes::win_type window, double beta); /* may throw */
+
+	  ~rational_resampler_cc_impl() override = default;
+
+	  // Queries
+	  int    interpolation() const noexcept override;
+	  int    decimation()  const noexcept override;
+	  double samp_rate()   const noexcept override { return d_fs; }
+	  double cutoff()      const noexcept override { return d_cutoff; }
+	  double transition()  const noexcept override { return d_trans; }
+	  int    window()      const noexcept override { return static_cast<int>(d_window); }
+	  double kaiser_beta() const noexcept override { return d_beta; }
+	  int    taps_per_phase() const noexcept override;
+	  std::vector<float> taps() const override;
+
+	  // Setters (mark dirty, cheap)
+	  void set_rate(int interp, int decim) override;
+	  void set_samp_rate(double fs) override;
+	  void set_cutoff(double fc) override;
+	  void set_transition(double tw) override;
+	  void set_window(int w) override;
+	  void set_kaiser_beta(double beta) override;
+
+	  // GNURadio API
+	  void forecast(int noutput_items, gr_vector_int &ninput_items_required) override;
+
+	  int general_work(int noutput_items,
+			   gr_vector_int &ninput_items,
+			   gr_vector_const_void_star &input_items,
+			   gr_vector_void_star &output_items) override;
+	};
+
+}} // namespace gr::howto
+#endif
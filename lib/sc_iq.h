@@ -0,0 +1,35 @@
+/* -*- c++ -*- */
+/* SPDX-License-Identifier: GPL-3.0-or-later */
+#ifndef INCLUDED_HOWTO_SC_IQ_H
+#define INCLUDED_HOWTO_SC_IQ_H
+
+#include <stdint.h>
+
+namespace gr {
+  namespace howto {
+
+    /*
+     * Interleaved integer IQ as delivered by SDR front ends (sc16 / sc8).
+     * real()/imag() widen to float, so the pw:: stages and the FIR kernels
+     * take these directly and the conversion happens in registers instead
+     * of through a separate short-to-complex block.
+     */
+    template<class T>
+    struct sc_iq {
+      T i, q;
+      float real() const { return (float)i; }
+      float imag() const { return (float)q; }
+    };
+
+    typedef sc_iq<int16_t> sc16_t;
+    typedef sc_iq<int8_t>  sc8_t;
+
+    //! 1 / full scale: maps the integer range onto [-1, 1)
+    template<class T> struct sc_full_scale;
+    template<> struct sc_full_scale<int16_t> { static float inv() { return 1.0f / 32768.0f; } };
+    template<> struct sc_full_scale<int8_t>  { static float inv() { return 1.0f / 128.0f; } };
+
+  } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_SC_IQ_H */
@@ -0,0 +1,103 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_SPSC_RING_H
+#define INCLUDED_HOWTO_SPSC_RING_H
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * Lock-free single-producer / single-consumer ring of fixed-size items.
+	 *
+	 * head and tail are free-running item counters (head - tail = items
+	 * in the ring), each written by one side only: the producer publishes
+	 * with a release store of head, the consumer with a release store of
+	 * tail, and each side acquires the other's counter. Both sides work in
+	 * place on contiguous spans (no per-item copies through the ring API);
+	 * a span ends at the wrap point, so a full transfer can take two.
+	 *
+	 * The two counters sit on separate cache lines so the producer's and
+	 * the consumer's stores do not bounce one line between the cores.
+	 */
+	class spsc_ring
+	{
+	public:
+	  //! capacity is rounded up to a power of two (items)
+	  spsc_ring(size_t item_size, size_t capacity)
+	  : d_item(item_size), d_head(0), d_tail(0)
+	  {
+	    d_cap = 1;
+	    while (d_cap < capacity) d_cap <<= 1;
+	    d_mask = d_cap - 1;
+	    d_buf.assign(d_cap * d_item, 0);
+	  }
+
+	  size_t capacity() const { return d_cap; }
+	  size_t item_size() const { return d_item; }
+
+	  //! Only valid while neither side is running
+	  void clear() { d_head.store(0); d_tail.store(0); }
+
+	  size_t readable() const
+	  { return d_head.load(std::memory_order_acquire) - d_tail.load(std::memory_order_relaxed); }
+
+	  size_t writable() const
+	  { return d_cap - (d_head.load(std::memory_order_relaxed) - d_tail.load(std::memory_order_acquire)); }
+
+	  // ---- producer side ----
+
+	  //! Contiguous free span at the write position (items)
+	  size_t write_span(void** p)
+	  {
+	    const size_t h = d_head.load(std::memory_order_relaxed);
+	    const size_t free = d_cap - (h - d_tail.load(std::memory_order_acquire));
+	    const size_t i = h & d_mask;
+	    *p = &d_buf[i * d_item];
+	    return std::min(free, d_cap - i);
+	  }
+
+	  void write_commit(size_t n)
+	  { d_head.store(d_head.load(std::memory_order_relaxed) + n, std::memory_order_release); }
+
+	  // ---- consumer side ----
+
+	  //! Contiguous filled span at the read position (items)
+	  size_t read_span(const void** p)
+	  {
+	    const size_t t = d_tail.load(std::memory_order_relaxed);
+	    const size_t avail = d_head.load(std::memory_order_acquire) - t;
+	    const size_t i = t & d_mask;
+	    *p = &d_buf[i * d_item];
+	    return std::min(avail, d_cap - i);
+	  }
+
+	  //! Copies the next n items (n <= readable()) without consuming them
+	  void peek(void* dst, size_t n)
+	  {
+	    const size_t i = d_tail.load(std::memory_order_relaxed) & d_mask;
+	    const size_t n1 = std::min(n, d_cap - i);
+	    char* d = static_cast<char*>(dst);
+	    std::copy(&d_buf[i * d_item], &d_buf[i * d_item] + n1 * d_item, d);
+	    std::copy(&d_buf[0], &d_buf[0] + (n - n1) * d_item, d + n1 * d_item);
+	  }
+
+	  void read_commit(size_t n)
+	  { d_tail.store(d_tail.load(std::memory_order_relaxed) + n, std::memory_order_release); }
+
+	private:
+	  std::vector<char> d_buf;
+	  size_t d_item, d_cap, d_mask;
+	  std::atomic<size_t> d_head;               // written by the producer
+	  char d_pad[64];                           // d_tail on another cache line
+	  std::atomic<size_t> d_tail;               // written by the consumer
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_SPSC_RING_H */
@@ -0,0 +1,186 @@
+#include "stage_pipeline.h"
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace gr { namespace howto {
+
+stage_pipeline::stage_pipeline(const std::vector<boost::shared_ptr<pipe_stage> >& stages,
+                               size_t ring_bytes, const std::vector<int>& cores)
+: d_stages(stages), d_cores(cores), d_decim(1), d_stop(true), d_stats(stages.size()), d_t0(0.0)
+{
+  if (d_stages.empty())
+    throw std::invalid_argument("stage_pipeline: no stages");
+
+  for (size_t k = 0; k <= d_stages.size(); ++k) {
+    const size_t item = k == 0 ? d_stages[0]->in_size() : d_stages[k - 1]->out_size();
+    if (k > 0 && k < d_stages.size() && d_stages[k]->in_size() != item)
+      throw std::invalid_argument("stage_pipeline: stage " + d_stages[k]->describe() +
+                                  " does not take the previous stage's output");
+    // the consumer must always be able to see a whole decimation group
+    const size_t D = k < d_stages.size() ? d_stages[k]->decimation() : 1;
+    d_rings.push_back(new spsc_ring(item, std::max(std::max(ring_bytes / item, 2 * D),
+                                                   (size_t)(4 * PIPE_CHUNK))));
+  }
+  for (size_t k = 0; k < d_stages.size(); ++k)
+    d_decim *= d_stages[k]->decimation();
+  reset_stats();
+}
+
+stage_pipeline::~stage_pipeline()
+{
+  stop();
+}
+
+void stage_pipeline::start()
+{
+  if (!d_threads.empty()) return;
+  for (size_t k = 0; k < d_stages.size(); ++k) d_stages[k]->reset();
+  for (size_t k = 0; k < d_rings.size(); ++k) d_rings[k].clear();
+  reset_stats();
+  d_stop.store(false);
+  for (size_t k = 0; k < d_stages.size(); ++k)
+    d_threads.push_back(new gr::thread::thread(boost::bind(&stage_pipeline::worker_, this, (int)k)));
+}
+
+void stage_pipeline::stop()
+{
+  d_stop.store(true);
+  for (size_t k = 0; k < d_threads.size(); ++k)
+    d_threads[k].join();
+  d_threads.clear();
+}
+
+int stage_pipeline::push(const void* in, int n)
+{
+  spsc_ring& r = d_rings.front();
+  const char* src = static_cast<const char*>(in);
+  int done = 0;
+  while (done < n) {
+    void* p;
+    const size_t m = std::min(r.write_span(&p), (size_t)(n - done));
+    if (m == 0) break;
+    std::memcpy(p, src + done * r.item_size(), m * r.item_size());
+    r.write_commit(m);
+    done += (int)m;
+  }
+  return done;
+}
+
+int stage_pipeline::pop(void* out, int n)
+{
+  spsc_ring& r = d_rings.back();
+  char* dst = static_cast<char*>(out);
+  int done = 0;
+  while (done < n) {
+    const void* p;
+    const size_t m = std::min(r.read_span(&p), (size_t)(n - done));
+    if (m == 0) break;
+    std::memcpy(dst + done * r.item_size(), p, m * r.item_size());
+    r.read_commit(m);
+    done += (int)m;
+  }
+  return done;
+}
+
+void stage_pipeline::worker_(int k)
+{
+  if (!d_cores.empty())
+    gr::thread::thread_bind_to_processor(std::vector<int>(1, d_cores[k % d_cores.size()]));
+
+  pipe_stage& st = *d_stages[k];
+  spsc_ring& rin = d_rings[k];
+  spsc_ring& rout = d_rings[k + 1];
+  const size_t D = st.decimation();
+  const size_t step = std::max((size_t)PIPE_CHUNK / D, (size_t)1);   // outputs per step
+  std::vector<char> group(D * st.in_size());   // a decimation group split by the wrap
+  std::atomic<long long>& busy = d_stats[k].busy_ns;
+
+  int polls = 0;
+  while (!d_stop.load(std::memory_order_acquire)) {
+    const void* ip;
+    void* op;
+    size_t nin = rin.read_span(&ip);
+    const size_t nout = rout.write_span(&op);
+    if (nout == 0 || rin.readable() < D) {
+      idle_wait(polls);
+      continue;
+    }
+    if (nin < D) {
+      rin.peek(&group[0], D);
+      ip = &group[0];
+      nin = D;
+    }
+    const size_t n = std::min(std::min(nin / D, nout), step);
+
+    const double t0 = now_();
+    st.process(ip, (int)(n * D), op);
+    busy.fetch_add((long long)((now_() - t0) * 1e9), std::memory_order_relaxed);
+
+    rout.write_commit(n);
+    rin.read_commit(n * D);
+    polls = 0;
+  }
+}
+
+void stage_pipeline::idle_wait(int& polls)
+{
+  ++polls;
+  if (polls < 64) {
+#if defined(__SSE2__)
+    _mm_pause();
+#endif
+  } else if (polls < 64 + 256) {
+    boost::this_thread::yield();
+  } else {
+    boost::this_thread::sleep(boost::posix_time::microseconds(20));
+  }
+}
+
+size_t stage_pipeline::l2_bytes()
+{
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+  const long v = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (v > 0) return (size_t)v;
+#endif
+  return 256 * 1024;
+}
+
+double stage_pipeline::now_()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::vector<float> stage_pipeline::utilization() const
+{
+  const double wall = now_() - d_t0;
+  std::vector<float> u(d_stages.size(), 0.0f);
+  if (wall <= 0.0) return u;
+  for (size_t k = 0; k < u.size(); ++k)
+    u[k] = (float)(d_stats[k].busy_ns.load(std::memory_order_relaxed) * 1e-9 / wall);
+  return u;
+}
+
+void stage_pipeline::reset_stats()
+{
+  for (size_t k = 0; k < d_stats.size(); ++k) d_stats[k].busy_ns.store(0);
+  d_t0 = now_();
+}
+
+std::string stage_pipeline::describe() const
+{
+  std::string s;
+  for (size_t k = 0; k < d_stages.size(); ++k)
+    s += (k ? " | " : "") + d_stages[k]->describe();
+  return s;
+}
+
+}} // namespace
@@ -0,0 +1,119 @@
+/* -*- c++ -*- */
+#ifndef INCLUDED_HOWTO_STAGE_PIPELINE_H
+#define INCLUDED_HOWTO_STAGE_PIPELINE_H
+
+#include "spsc_ring.h"
+#include <gnuradio/thread/thread.h>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/shared_ptr.hpp>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace gr {
+
+    namespace howto {
+
+	/*
+	 * One stage of a stage_pipeline. Stages own their state (delay lines),
+	 * so a stage only ever sees its own input stream, in order.
+	 */
+	class pipe_stage
+	{
+	public:
+	  virtual ~pipe_stage() {}
+
+	  virtual size_t in_size() const = 0;     // bytes per input item
+	  virtual size_t out_size() const = 0;    // bytes per output item
+	  virtual int decimation() const { return 1; }
+
+	  //! nin is a multiple of decimation(); writes nin / decimation() items
+	  virtual void process(const void* in, int nin, void* out) = 0;
+
+	  //! Back to the state of a fresh stage (zeroed delay lines)
+	  virtual void reset() = 0;
+
+	  virtual std::string describe() const = 0;
+	};
+
+	//! Input items a stage takes per step: bounds the handoff latency
+	static const int PIPE_CHUNK = 1024;
+
+	/*
+	 * Runs a chain of pipe_stages, one thread per stage, connected by
+	 * spsc_rings:
+	 *
+	 *   push() -> ring 0 -> [stage 0] -> ring 1 -> ... -> [stage S-1] -> ring S -> pop()
+	 *
+	 * push() and pop() belong to one outside thread (the block thread).
+	 * Each stage thread takes at most PIPE_CHUNK input items per step and
+	 * commits its output right away, so an item waits at most one step
+	 * per stage; consecutive chunks are in different stages at the same
+	 * time. An idle thread spins briefly, then yields, then naps 20 us
+	 * (idle_wait), so a stage that is fed continuously never sleeps.
+	 *
+	 * Utilization is measured per stage as time inside process() over
+	 * wall time since start() / reset_stats().
+	 */
+	class stage_pipeline
+	{
+	public:
+	  //! ring_bytes per ring (rounded to a power of two of items, at least
+	  //! 4 * PIPE_CHUNK items); stage k runs on cores[k % size] if given
+	  stage_pipeline(const std::vector<boost::shared_ptr<pipe_stage> >& stages,
+	                 size_t ring_bytes, const std::vector<int>& cores);
+	  ~stage_pipeline();
+
+	  //! Resets stages and rings, then launches the stage threads
+	  void start();
+	  //! Joins the stage threads (items still in the rings are kept)
+	  void stop();
+
+	  int stages() const { return (int)d_stages.size(); }
+	  int decimation() const { return d_decim; }    // product of the stages
+	  size_t ring_items(int k) const { return d_rings[k].capacity(); }
+	  const std::vector<int>& cores() const { return d_cores; }
+
+	  //! Copies up to n input items into ring 0, returns how many fit
+	  int push(const void* in, int n);
+	  //! Copies up to n finished items out of the last ring
+	  int pop(void* out, int n);
+	  size_t ready() const { return d_rings.back().readable(); }
+
+	  //! Busy fraction of each stage thread since start() / reset_stats()
+	  std::vector<float> utilization() const;
+	  void reset_stats();
+
+	  //! e.g. "FIR(D=1, 129 taps) | FIR(D=8, 97 taps) | |x|*1"
+	  std::string describe() const;
+
+	  //! Spin, then yield, then short sleeps; call once per empty poll
+	  static void idle_wait(int& polls);
+
+	  //! Per-core L2 size in bytes (sysconf), 256 KiB if unknown
+	  static size_t l2_bytes();
+
+	private:
+	  void worker_(int k);
+	  static double now_();
+
+	  std::vector<boost::shared_ptr<pipe_stage> > d_stages;
+	  boost::ptr_vector<spsc_ring> d_rings;          // stages() + 1
+	  std::vector<int> d_cores;
+	  int d_decim;
+
+	  boost::ptr_vector<gr::thread::thread> d_threads;
+	  std::atomic<bool> d_stop;
+
+	  struct stage_stat {                            // written by the stage thread
+	    std::atomic<long long> busy_ns;
+	    char pad[64 - sizeof(std::atomic<long long>)];
+	  };
+	  std::vector<stage_stat> d_stats;
+	  double d_t0;                                   // start of the stats window
+	};
+
+    } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_STAGE_PIPELINE_H */
@@ -0,0 +1,130 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2025 <+YOU OR YOUR COMPANY+>.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HOWTO_THRESHOLD_SCAN_H
+#define INCLUDED_HOWTO_THRESHOLD_SCAN_H
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace gr {
+  namespace howto {
+
+    /*!
+    * \brief Threshold-crossing search used by the hysteresis detectors.
+    *
+    * Detectors first compute their level array (moving average / envelope) for
+    * the whole chunk and then jump from event to event with scan_first<>().
+    * With SSE, 16 samples are compared per iteration and only the movemask is
+    * tested, so a chunk without transitions costs one compare per sample.
+    */
+    enum scan_cmp_t { SCAN_GT = 0, SCAN_GE = 1, SCAN_LT = 2, SCAN_LE = 3 };
+
+    template<int C, typename T>
+    static inline bool scan_test_(T v, T thr)
+    {
+      switch (C) {
+        case SCAN_GT: return v >  thr;
+        case SCAN_GE: return v >= thr;
+        case SCAN_LT: return v <  thr;
+        default:      return v <= thr;
+      }
+    }
+
+#if defined(__SSE__)
+    template<int C>
+    static inline int scan_mask_(const float* p, __m128 t)
+    {
+      const __m128 v = _mm_loadu_ps(p);
+      switch (C) {
+        case SCAN_GT: return _mm_movemask_ps(_mm_cmpgt_ps(v, t));
+        case SCAN_GE: return _mm_movemask_ps(_mm_cmpge_ps(v, t));
+        case SCAN_LT: return _mm_movemask_ps(_mm_cmplt_ps(v, t));
+        default:      return _mm_movemask_ps(_mm_cmple_ps(v, t));
+      }
+    }
+#endif
+
+#if defined(__SSE2__)
+    template<int C>
+    static inline int scan_mask_(const double* p, __m128d t)
+    {
+      const __m128d v = _mm_loadu_pd(p);
+      switch (C) {
+        case SCAN_GT: return _mm_movemask_pd(_mm_cmpgt_pd(v, t));
+        case SCAN_GE: return _mm_movemask_pd(_mm_cmpge_pd(v, t));
+        case SCAN_LT: return _mm_movemask_pd(_mm_cmplt_pd(v, t));
+        default:      return _mm_movemask_pd(_mm_cmple_pd(v, t));
+      }
+    }
+#endif
+
+    //! Index of the first x[i] (0 <= i < n) satisfying the comparison, or n if none.
+    template<int C>
+    static inline int scan_first(const float* x, int n, float thr)
+    {
+      int i = 0;
+#if defined(__SSE__)
+      const __m128 t = _mm_set1_ps(thr);
+      for (; i + 16 <= n; i += 16) {
+        const int m = scan_mask_<C>(x + i,      t) | scan_mask_<C>(x + i + 4,  t)
+                    | scan_mask_<C>(x + i + 8,  t) | scan_mask_<C>(x + i + 12, t);
+        if (m) break;                 // hit somewhere in these 16: resolve below
+      }
+      for (; i + 4 <= n; i += 4) {
+        if (scan_mask_<C>(x + i, t)) break;
+      }
+#endif
+      for (; i < n; ++i) {
+        if (scan_test_<C>(x[i], thr)) return i;
+      }
+      return n;
+    }
+
+    //! Same on a double level array (8 samples per SSE2 iteration).
+    template<int C>
+    static inline int scan_first(const double* x, int n, double thr)
+    {
+      int i = 0;
+#if defined(__SSE2__)
+      const __m128d t = _mm_set1_pd(thr);
+      for (; i + 8 <= n; i += 8) {
+        const int m = scan_mask_<C>(x + i,     t) | scan_mask_<C>(x + i + 2, t)
+                    | scan_mask_<C>(x + i + 4, t) | scan_mask_<C>(x + i + 6, t);
+        if (m) break;
+      }
+      for (; i + 2 <= n; i += 2) {
+        if (scan_mask_<C>(x + i, t)) break;
+      }
+#endif
+      for (; i < n; ++i) {
+        if (scan_test_<C>(x[i], thr)) return i;
+      }
+      return n;
+    }
+
+  } // namespace howto
+} // namespace gr
+
+#endif /* INCLUDED_HOWTO_THRESHOLD_SCAN_H */
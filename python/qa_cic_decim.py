@@ -0,0 +1,94 @@
+# -*- coding: utf-8 -*-
+# cic_decim_cc / cic_decim_ff: ganancia DC, largo, rechazo y compensacion de droop
+import numpy as np
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+
+FS = 10e6
+R, N = 100, 4
+
+
+class qa_cic_decim(gr_unittest.TestCase):
+
+    def _run_c(self, x, blk):
+        tb = gr.top_block()
+        snk = blocks.vector_sink_c()
+        tb.connect(blocks.vector_source_c(x.astype(np.complex64).tolist(), False), blk, snk)
+        tb.run()
+        return np.array(snk.data(), dtype=np.complex64)
+
+    def _run_f(self, x, blk):
+        tb = gr.top_block()
+        snk = blocks.vector_sink_f()
+        tb.connect(blocks.vector_source_f(x.astype(np.float32).tolist(), False), blk, snk)
+        tb.run()
+        return np.array(snk.data(), dtype=np.float32)
+
+    def _tone_gain_db(self, blk, f, nout=600):
+        D = blk.decimation() * (blk.comp_decimation() if blk.compensate() else 1)
+        n = np.arange(D * nout)
+        y = self._run_c(0.5 * np.exp(2j * np.pi * f / FS * n), blk)
+        y = y[len(y) // 2:]
+        return 10 * np.log10(np.mean(np.abs(y) ** 2) / 0.25 + 1e-30)
+
+    def test_000_dc_and_length(self):
+        blk = howto.cic_decim_cc(R, N, FS)
+        y = self._run_c(np.full(R * 50, 0.3 - 0.7j), blk)
+        self.assertEqual(len(y), 50)
+        self.assertLess(np.max(np.abs(y[N:] - (0.3 - 0.7j))), 1e-5)
+
+    def test_001_alias_rejection(self):
+        # tono a fs/R + 1 kHz: cae sobre 1 kHz despues de decimar
+        self.assertLess(self._tone_gain_db(howto.cic_decim_cc(R, N, FS), FS / R + 1e3), -60.0)
+
+    def test_002_compensation_flattens_passband(self):
+        plain = howto.cic_decim_cc(R, N, FS)
+        comp = howto.cic_decim_cc(R, N, FS, True, 2, 20e3, 5e3)
+        self.assertGreater(len(comp.comp_taps()), 1)
+        self.assertAlmostEqual(sum(comp.comp_taps()), 1.0, places=4)
+        self.assertLess(self._tone_gain_db(plain, 15e3), -1.0)
+        self.assertLess(abs(self._tone_gain_db(comp, 15e3)), 0.1)
+        comp = howto.cic_decim_cc(R, N, FS, True, 2, 20e3, 5e3)
+        self.assertLess(self._tone_gain_db(comp, 30e3), -60.0)
+
+    def test_003_float_matches_complex(self):
+        rng = np.random.RandomState(7)
+        x = rng.uniform(-1.0, 1.0, R * 2 * 200)
+        yc = self._run_c(x.astype(np.complex64), howto.cic_decim_cc(R, N, FS, True, 2, 20e3, 5e3))
+        yf = self._run_f(x, howto.cic_decim_ff(R, N, FS, True, 2, 20e3, 5e3))
+        self.assertEqual(len(yf), 200)
+        self.assertLess(np.max(np.abs(yf - yc.real)), 1e-6)
+
+    def test_004_bad_args(self):
+        self.assertRaises(ValueError, howto.cic_decim_cc, 1, N, FS)
+        self.assertRaises(ValueError, howto.cic_decim_cc, R, 7, FS)
+        # compensador fuera de fs/(2R)
+        self.assertRaises(ValueError, howto.cic_decim_cc, R, N, FS, True, 1, 60e3, 5e3)
+        # cabe en fs/(2R) pero no en el Nyquist final fs/(2 R comp_decim)
+        self.assertRaises(ValueError, howto.cic_decim_cc, R, N, FS, True, 4, 20e3, 5e3)
+        self.assertRaises(ValueError, howto.cic_decim_ff, R, N, FS, True, 4, 20e3, 5e3)
+        howto.cic_decim_cc(R, N, FS, True, 4, 10e3, 2e3)
+
+    def test_005_runtime_rate_change(self):
+        blk = howto.cic_decim_cc(R, N, FS)
+        blk.set_decimation(50)
+        self.assertEqual(blk.decimation(), 50)
+        y = self._run_c(np.ones(50 * 40), blk)
+        self.assertEqual(len(y), 40)
+        self.assertLess(abs(y[-1] - 1.0), 1e-5)
+
+    def test_006_setters_reject_bit_growth(self):
+        # R/N que no caben en los integradores: error en el setter, nada cambia
+        for mk in (howto.cic_decim_cc, howto.cic_decim_ff):
+            blk = mk(R, N, FS)
+            self.assertRaises(ValueError, blk.set_decimation, 2000)
+            self.assertEqual(blk.decimation(), R)
+            blk.set_order(6)
+            self.assertEqual(blk.order(), 6)
+            self.assertRaises(ValueError, blk.set_decimation, 200)
+            self.assertRaises(ValueError, mk(200, 4, FS).set_order, 6)
+            self.assertEqual(blk.decimation(), R)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_cic_decim, "qa_cic_decim.xml")
@@ -5,7 +5,7 @@ from __future__ import print_function
 import time
 import numpy as np
 
-from gnuradio import gr, blocks, gr_unittest
+from gnuradio import gr, blocks, analog, gr_unittest
 from gnuradio.filter import firdes
 import howto
 
@@ -127,6 +127,146 @@ class qa_decimate_fir_cc(gr_unittest.TestCase):
         print("Pico 50 kHz = %.1f dB; Pico ~100 kHz (alias) = %.1f dB; Margen = %.1f dB"
               % (p_in, p_ali, margin_db))
 
+    def _tone_gain_db(self, dec, fs_in, D, f):
+        n_in = 64 * 1024
+        t = np.arange(n_in) / fs_in
+        x = np.exp(1j * 2 * np.pi * f * t).astype(np.complex64)
+        snk = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(blocks.vector_source_c(x.tolist(), False), dec, snk)
+        tb.run()
+        y = np.array(snk.data(), dtype=np.complex64)
+        self.assertEqual(len(y), n_in // D)
+        y = y[len(y) // 2:]                   # fuera del transitorio
+        return 10.0 * np.log10(np.mean(np.abs(y) ** 2) + 1e-30)
+
+    def test_halfband_cascade(self):
+        # D = 8 con cutoff en el Nyquist de salida -> 3 etapas half-band
+        fs_in, D = 8000.0, 8
+        mk = lambda: howto.decimate_fir_cc(D, fs_in, fs_in / (2 * D), 100.0,
+                                           int(firdes.WIN_HAMMING), 6.76, True)
+        self.assertEqual(mk().halfband_stages(), 3)
+        self.assertGreater(self._tone_gain_db(mk(), fs_in, D, 200.0), -0.3)
+        self.assertLess(self._tone_gain_db(mk(), fs_in, D, 700.0), -40.0)
+        self.assertLess(self._tone_gain_db(mk(), fs_in, D, 3000.0), -40.0)
+
+    def test_single_stage_when_disabled(self):
+        dec = howto.decimate_fir_cc(8, 1e6, 20e3, 10e3, int(firdes.WIN_HAMMING), 6.76, False)
+        self.assertFalse(dec.multistage())
+        self.assertEqual(dec.halfband_stages(), 0)
+        self.assertTrue(dec.plan().startswith('FIR(D=8,'))
+
+    def test_multistage_plan(self):
+        # D grande: el plan multi-etapa es mucho mas barato y filtra igual
+        fs_in, D = 1e6, 64
+        cutoff, trans = 0.4 * fs_in / D, 0.1 * fs_in / D
+        mk = lambda ms: howto.decimate_fir_cc(D, fs_in, cutoff, trans,
+                                              int(firdes.WIN_HAMMING), 6.76, ms)
+        single, multi = mk(False), mk(True)
+        print('single:', single.plan())
+        print('multi :', multi.plan())
+        self.assertLess(multi.macs_per_output(), 0.2 * single.macs_per_output())
+        self.assertGreater(self._tone_gain_db(mk(True), fs_in, D, 0.2 * fs_in / D), -0.3)
+        self.assertLess(self._tone_gain_db(mk(True), fs_in, D, 1.46 * fs_in / D), -45.0)
+        self.assertLess(self._tone_gain_db(mk(True), fs_in, D, 20.3 * fs_in / D), -45.0)
+
+    def test_accumulation_policies(self):
+        # float / split / double: el mismo filtro salvo redondeo, en los dos motores
+        rng = np.random.RandomState(7)
+        x = (rng.randn(40000) + 1j * rng.randn(40000)).astype(np.complex64)
+        for ms in (False, True):
+            ys = []
+            for acc in (0, 1, 2):
+                dec = howto.decimate_fir_cc(16, 1e6, 20e3, 2e3, int(firdes.WIN_HAMMING), 6.76, ms)
+                dec.set_accumulation(acc)
+                self.assertEqual(dec.accumulation(), acc)
+                snk = blocks.vector_sink_c()
+                tb = gr.top_block()
+                tb.connect(blocks.vector_source_c(x.tolist(), False), dec, snk)
+                tb.run()
+                ys.append(np.array(snk.data(), dtype=np.complex64))
+            for y in ys[:2]:
+                self.assertEqual(len(y), len(ys[2]))
+                self.assertLess(np.max(np.abs(y - ys[2])) / np.max(np.abs(ys[2])), 1e-5)
+        self.assertRaises(ValueError, dec.set_accumulation, -1)
+
+    def test_cic_plan_takes_sc16_full_scale(self):
+        # DC de fondo de escala sc16 (32767): un CIC del plan no debe dar la vuelta
+        D, fs_in = 10, 1e6
+        fs_out = fs_in / D
+        dec = howto.decimate_fir_cc(D, fs_in, 0.06 * fs_out, 0.2 * fs_out,
+                                    int(firdes.WIN_BLACKMAN), 6.76, True)
+        self.assertFalse(howto.decimate_fir_cc(D, fs_in, 0.06 * fs_out, 0.2 * fs_out,
+                                               int(firdes.WIN_BLACKMAN), 6.76).multistage())
+        x = [complex(32767.0, -32767.0)] * (D * 2000)
+        snk = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(blocks.vector_source_c(x, False), dec, snk)
+        tb.run()
+        y = np.array(snk.data())[1000:]
+        self.assertLess(np.max(np.abs(y - complex(32767.0, -32767.0))), 1.0)
+
+    def test_retune_while_running(self):
+        # D 4 -> 8 con el flowgraph andando: el bloque no se detiene y la
+        # salida sigue sin huecos ni muestras repetidas. Un solo setter, asi
+        # hay un unico cambio de plan (sin disenos intermedios)
+        fs_in, f0, N = 1e6, 10e3, 2000000
+        dec = howto.decimate_fir_cc(4, fs_in, 50e3, 12.5e3, int(firdes.WIN_HAMMING), 6.76, True)
+        snk = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(analog.sig_source_c(fs_in, analog.GR_COS_WAVE, f0, 1.0),
+                   blocks.head(gr.sizeof_gr_complex, N),
+                   blocks.throttle(gr.sizeof_gr_complex, 10e6), dec, snk)
+        p0 = dec.plan()
+        tb.start()
+        t0 = time.time()
+        while len(snk.data()) < 20000 and time.time() - t0 < TIMEOUT_SEC:
+            time.sleep(0.005)
+        dec.set_decimation(8)
+        # el plan cambia cuando work() hace el cambio, no antes
+        while dec.plan() == p0 and time.time() - t0 < TIMEOUT_SEC:
+            time.sleep(0.001)
+        n_switch = len(snk.data())
+        tb.wait()
+        self.assertNotEqual(dec.plan(), p0)
+        self.assertTrue(dec.plan().startswith('HB('))
+        self.assertLess(n_switch + 1000, N // 8)
+
+        y = np.array(snk.data(), dtype=np.complex64)
+        # amplitud constante fuera del transitorio inicial: sin tramo
+        # filtrado contra ceros
+        self.assertLess(np.max(np.abs(np.abs(y[200:]) - 1.0)), 0.01)
+        # avance de fase por salida: 4 muestras y despues 8; solo el salto
+        # de retardo de grupo en el cambio puede no ser ninguno de los dos
+        d = np.angle(y[1:] * np.conj(y[:-1]))
+        step = lambda D: 2 * np.pi * f0 * D / fs_in
+        is4 = np.abs(d - step(4)) < 1e-3
+        is8 = np.abs(d - step(8)) < 1e-3
+        self.assertTrue(is8[200:].any())
+        k = 200 + int(np.argmax(is8[200:]))
+        self.assertTrue(is4[200:k - 1].all() and is8[k:].all())
+        # k (o k + 1) salidas a D = 4, el resto de la entrada a D = 8
+        self.assertLessEqual(abs(len(y) - (k + (N - 4 * k) // 8)), 1)
+
+    def test_bad_retune_keeps_plan(self):
+        # cutoff > fs/2 en marcha: firdes lo rechaza en el hilo de diseno, se
+        # registra y el flowgraph sigue con el plan en uso
+        fs_in, N = 1e6, 400000
+        dec = howto.decimate_fir_cc(4, fs_in, 50e3, 12.5e3, int(firdes.WIN_HAMMING), 6.76)
+        snk = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(analog.sig_source_c(fs_in, analog.GR_COS_WAVE, 10e3, 1.0),
+                   blocks.head(gr.sizeof_gr_complex, N),
+                   blocks.throttle(gr.sizeof_gr_complex, 2e6), dec, snk)
+        p0 = dec.plan()
+        tb.start()
+        t0 = time.time()
+        while len(snk.data()) < 1000 and time.time() - t0 < TIMEOUT_SEC:
+            time.sleep(0.005)
+        dec.set_cutoff(0.6 * fs_in)
+        tb.wait()
+        self.assertEqual(len(snk.data()), N // 4)
+        self.assertEqual(dec.plan(), p0)
 
 if __name__ == '__main__':
     # Ejecuta con el runner estándar de GNU Radio 3.7
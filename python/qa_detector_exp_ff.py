@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+from gnuradio import gr, gr_unittest, blocks
+import math
+import pmt
+import howto_swig as howto
+
+def envelope_ref(xs, N, Nd=0):
+    """Emula el envolvente del bloque: alpha = exp(-1/N); con Nd > 0,
+    alpha de ataque (N) al subir y de caida (Nd) al bajar."""
+    a_att = math.exp(-1.0 / N)
+    a_dec = math.exp(-1.0 / Nd) if Nd > 0 else a_att
+    env = 0.0
+    out = []
+    for x in xs:
+        x2 = x * x
+        a = a_att if x2 > env else a_dec
+        env = x2 + a * (env - x2)
+        out.append(env)
+    return out
+
+class qa_detector_exp_ff(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def _run(self, xs, dut):
+        src = blocks.vector_source_f(xs, repeat=False)
+        snk_out = blocks.vector_sink_f()
+        snk_env = blocks.vector_sink_f()
+        self.tb.connect(src, dut)
+        self.tb.connect((dut, 0), snk_out)
+        self.tb.connect((dut, 1), snk_env)
+        self.tb.run()
+        return list(snk_out.data()), list(snk_env.data())
+
+    def test_001_length_sets_alpha(self):
+        xs = [1.0] * 200 + [0.0] * 200
+        dut = howto.detector_exp_ff(20)
+        self.assertAlmostEqual(dut.alpha(), math.exp(-1.0 / 20), 6)
+        out, env = self._run(xs, dut)
+        self.assertFloatTuplesAlmostEqual(out, xs, 6)
+        self.assertFloatTuplesAlmostEqual(env, envelope_ref(xs, 20), 5)
+        # Constante de tiempo: 1 - 1/e del escalon tras N muestras
+        self.assertAlmostEqual(env[19], 1.0 - math.exp(-1.0), 3)
+
+    def test_002_dual_rate(self):
+        xs = [1.0] * 100 + [0.0] * 300
+        dut = howto.detector_exp_ff(5, 80)
+        out, env = self._run(xs, dut)
+        self.assertFloatTuplesAlmostEqual(env, envelope_ref(xs, 5, 80), 5)
+        # Ataque rapido, caida lenta
+        self.assertGreater(env[30], 0.99)
+        self.assertGreater(env[180], 0.3)
+
+    def test_003_runtime_length(self):
+        dut = howto.detector_exp_ff(10)
+        dut.set_length(100)
+        dut.set_decay_length(400)
+        self.assertEqual(dut.length(), 100)
+        self.assertEqual(dut.decay_length(), 400)
+        self.assertAlmostEqual(dut.alpha(), math.exp(-1.0 / 100), 6)
+
+    def test_004_tags_propagated_once(self):
+        # Cada tag de entrada debe aparecer exactamente una vez en 'out' y en 'env'
+        xs = [0.0] * 1000
+        tags = []
+        for off in range(0, 1000, 10):
+            t = gr.tag_t()
+            t.offset = off
+            t.key = pmt.intern('rx_time')
+            t.value = pmt.from_uint64(off)
+            tags.append(t)
+        src = blocks.vector_source_f(xs, False, 1, tags)
+        dut = howto.detector_exp_ff(10)
+        snk_out = blocks.vector_sink_f()
+        snk_env = blocks.vector_sink_f()
+        self.tb.connect(src, dut)
+        self.tb.connect((dut, 0), snk_out)
+        self.tb.connect((dut, 1), snk_env)
+        self.tb.run()
+        for snk in (snk_out, snk_env):
+            got = sorted(t.offset for t in snk.tags()
+                         if pmt.symbol_to_string(t.key) == 'rx_time')
+            self.assertEqual(got, list(range(0, 1000, 10)))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_detector_exp_ff, "qa_detector_exp_ff.xml")
@@ -21,8 +21,30 @@
 
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
+import pmt
 import howto_swig as howto
 
+def detector_events_ref(xs, thr_high, thr_low, win):
+    """Emula el bloque: media movil de win muestras (ceros al inicio),
+    deteccion desde la muestra win en adelante, histeresis START/STOP."""
+    events = []
+    acc = 0.0
+    active = False
+    for i in range(len(xs)):
+        acc += xs[i]
+        if i >= win:
+            acc -= xs[i - win]
+        if i < win:
+            continue
+        avg = acc / float(win)
+        if not active and avg > thr_high:
+            active = True
+            events.append((i, 'START'))
+        elif active and avg < thr_low:
+            active = False
+            events.append((i, 'STOP'))
+    return events
+
 class qa_detector_ff (gr_unittest.TestCase):
 
     def setUp (self):
@@ -31,10 +53,44 @@ class qa_detector_ff (gr_unittest.TestCase):
     def tearDown (self):
         self.tb = None
 
-    def test_001_t (self):
-        # set up fg
-        self.tb.run ()
-        # check data
+    def _run(self, xs, thr_high, thr_low, win):
+        src = blocks.vector_source_f(xs, repeat=False)
+        dut = howto.detector_ff(thr_high, thr_low, win)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, dut, snk)
+        self.tb.run()
+        tags = [(t.offset, pmt.symbol_to_string(t.value)) for t in snk.tags()
+                if pmt.symbol_to_string(t.key) == 'event']
+        return list(snk.data()), tags
+
+    def test_001_passthrough_and_events(self):
+        # Rafagas separadas por silencio; largo para cruzar varias llamadas a work()
+        xs = []
+        for k in range(6):
+            xs += [0.0] * 3000 + [1.0] * (500 + 37 * k)
+        xs += [0.0] * 100
+        win = 16
+        out, tags = self._run(xs, 0.6, 0.3, win)
+        self.assertFloatTuplesAlmostEqual(out, xs, 6)
+        self.assertEqual(tags, detector_events_ref(xs, 0.6, 0.3, win))
+        self.assertEqual(len(tags), 12)
+
+    def test_002_warmup_delays_events(self):
+        # La ventana aun no esta llena: nada debe dispararse antes de la muestra win
+        win = 64
+        xs = [10.0] * 32 + [0.0] * 200
+        out, tags = self._run(xs, 1.0, 0.5, win)
+        self.assertEqual(tags, detector_events_ref(xs, 1.0, 0.5, win))
+        self.assertEqual(tags[0], (win, 'START'))
+
+    def test_003_average_kept_in_double(self):
+        # Media 1 + 2^-23/3: por encima de 1.0 en double, 1.0 exacto en float
+        win = 3
+        e = 1.0 + 2.0 ** -23
+        xs = [0.0] * 10 + [e, 1.0, 1.0] * 20
+        out, tags = self._run(xs, 1.0, 0.5, win)
+        self.assertEqual(tags, detector_events_ref(xs, 1.0, 0.5, win))
+        self.assertEqual(tags, [(12, 'START')])
 
 
 if __name__ == '__main__':
@@ -36,6 +36,54 @@ class qa_downsample_cc (gr_unittest.TestCase):
         self.tb.run ()
         # check data
 
+    def _x(self, n):
+        return [complex(i, -0.5 * i) for i in range(n)]
+
+    def test_002_phase(self):
+        x = self._x(1003)
+        for D in (2, 5):
+            for p in range(D):
+                tb = gr.top_block()
+                snk = blocks.vector_sink_c()
+                ds = howto.downsample_cc(D, p)
+                self.assertEqual(ds.phase(), p)
+                tb.connect(blocks.vector_source_c(x, False), ds, snk)
+                tb.run()
+                self.assertEqual(list(snk.data()), x[p::D][:len(x) // D])
+
+    def test_003_set_phase(self):
+        ds = howto.downsample_cc(4)
+        self.assertFalse(ds.commutator())
+        ds.set_phase(3)
+        self.assertEqual(ds.phase(), 3)
+        self.assertRaises(ValueError, ds.set_phase, 4)
+        self.assertRaises(ValueError, ds.set_phase, -1)
+        self.assertRaises(ValueError, howto.downsample_cc, 4, 4)
+
+    def test_004_commutator(self):
+        # salida k = fase (phase + k) mod D; con phase 0, igual que
+        # skiphead(k) -> downsample_cc
+        x = self._x(4099)
+        for D, p in ((4, 0), (5, 0), (5, 2), (8, 7)):
+            tb = gr.top_block()
+            src = blocks.vector_source_c(x, False)
+            ds = howto.downsample_cc(D, p, True)
+            self.assertTrue(ds.commutator())
+            tb.connect(src, ds)
+            snks, refs = [], []
+            for k in range(D):
+                snks.append(blocks.vector_sink_c())
+                tb.connect((ds, k), snks[k])
+                if p == 0:
+                    refs.append(blocks.vector_sink_c())
+                    tb.connect(src, blocks.skiphead(gr.sizeof_gr_complex, k),
+                               howto.downsample_cc(D), refs[k])
+            tb.run()
+            for k in range(D):
+                self.assertEqual(list(snks[k].data()), x[(p + k) % D::D][:len(x) // D])
+                if p == 0:
+                    self.assertEqual(list(refs[k].data()), list(snks[k].data()))
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_downsample_cc, "qa_downsample_cc.xml")
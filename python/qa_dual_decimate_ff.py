@@ -122,6 +122,35 @@ class qa_dual_decimate_ff(unittest.TestCase):
         # Sanity: must produce something nonzero
         self.assertGreater(len(y0), 0)
 
+    def test_003_specialized_and_generic_kernels(self):
+        """
+        D en {2,4,8,16,32} usa kernels desenrollados; el resto el generico.
+        Ambos deben coincidir con la media de referencia.
+        """
+        for D0, D1 in [(2, 3), (4, 7), (8, 5), (16, 33), (32, 1)]:
+            cnt = 500
+            x0 = np.random.uniform(-1, 1, cnt * D0).astype(np.float32)
+            x1 = np.random.uniform(-1, 1, cnt * D1).astype(np.float32)
+
+            tb = gr.top_block()
+            src0 = blocks.vector_source_f(x0.tolist(), repeat=False)
+            src1 = blocks.vector_source_f(x1.tolist(), repeat=False)
+            blk = howto.dual_decimate_ff(D0, D1)
+            snk0 = blocks.vector_sink_f()
+            snk1 = blocks.vector_sink_f()
+            tb.connect(src0, (blk, 0))
+            tb.connect(src1, (blk, 1))
+            tb.connect((blk, 0), snk0)
+            tb.connect((blk, 1), snk1)
+            tb.run()
+
+            y0 = np.array(snk0.data(), dtype=np.float32)
+            y1 = np.array(snk1.data(), dtype=np.float32)
+            self.assertEqual(len(y0), cnt)
+            self.assertEqual(len(y1), cnt)
+            np.testing.assert_allclose(y0, avg_blocks(x0, D0, cnt), rtol=1e-5, atol=1e-6)
+            np.testing.assert_allclose(y1, avg_blocks(x1, D1, cnt), rtol=1e-5, atol=1e-6)
+
 
 if __name__ == '__main__':
     unittest.main()
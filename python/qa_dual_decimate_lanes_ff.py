@@ -0,0 +1,78 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+from __future__ import print_function
+import numpy as np
+import unittest
+
+from gnuradio import gr, blocks
+import howto
+
+
+def avg_blocks(x, D, cnt):
+    """Block-wise average with stride D for the first cnt windows."""
+    x = np.asarray(x, dtype=np.float64)
+    return x[:cnt * D].reshape(cnt, D).mean(axis=1).astype(np.float32)
+
+
+class qa_dual_decimate_lanes_ff(unittest.TestCase):
+    """
+    Tests for howto.dual_decimate_lanes_ff: each port is scheduled on its own,
+    so final lengths are n0//D0 and n1//D1 (no lockstep min).
+    """
+
+    def _run(self, x0, x1, D0, D1):
+        tb = gr.top_block()
+        src0 = blocks.vector_source_f(x0.tolist(), repeat=False)
+        src1 = blocks.vector_source_f(x1.tolist(), repeat=False)
+        blk = howto.dual_decimate_lanes_ff(D0, D1)
+        snk0 = blocks.vector_sink_f()
+        snk1 = blocks.vector_sink_f()
+        tb.connect(src0, (blk, 0))
+        tb.connect(src1, (blk, 1))
+        tb.connect((blk, 0), snk0)
+        tb.connect((blk, 1), snk1)
+        tb.run()
+        return (np.array(snk0.data(), dtype=np.float32),
+                np.array(snk1.data(), dtype=np.float32))
+
+    def test_001_independent_lengths(self):
+        n0, n1 = 240, 315
+        D0, D1 = 3, 5
+        x0 = np.linspace(-1.0, 1.0, n0).astype(np.float32)
+        x1 = (0.5 * np.sin(2 * np.pi * 0.03 * np.arange(n1)) + 0.5).astype(np.float32)
+
+        y0, y1 = self._run(x0, x1, D0, D1)
+
+        self.assertEqual(len(y0), n0 // D0)
+        self.assertEqual(len(y1), n1 // D1)
+        np.testing.assert_allclose(y0, avg_blocks(x0, D0, n0 // D0), rtol=1e-5, atol=1e-6)
+        np.testing.assert_allclose(y1, avg_blocks(x1, D1, n1 // D1), rtol=1e-5, atol=1e-6)
+
+    def test_002_stress_asymmetric(self):
+        """
+        D muy asimetrico (2 vs 1000) y entradas de largo muy distinto:
+        el puerto rapido debe entregar todo aunque el lento casi no produzca,
+        y al reves (el puerto 1 con solo 1999 muestras -> 1 salida).
+        """
+        n0, n1 = 400000, 1999
+        D0, D1 = 2, 1000
+        x0 = np.random.uniform(-1, 1, n0).astype(np.float32)
+        x1 = np.random.uniform(-1, 1, n1).astype(np.float32)
+
+        y0, y1 = self._run(x0, x1, D0, D1)
+
+        self.assertEqual(len(y0), n0 // D0)
+        self.assertEqual(len(y1), n1 // D1)
+        np.testing.assert_allclose(y0, avg_blocks(x0, D0, n0 // D0), rtol=1e-5, atol=1e-6)
+        np.testing.assert_allclose(y1, avg_blocks(x1, D1, n1 // D1), rtol=1e-5, atol=1e-5)
+
+    def test_003_setters(self):
+        blk = howto.dual_decimate_lanes_ff(3, 7)
+        blk.set_D0(8)
+        blk.set_D1(0)       # ignorado (< 1)
+        self.assertEqual(blk.D0(), 8)
+        self.assertEqual(blk.D1(), 7)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,71 @@
+# -*- coding: utf-8 -*-
+# fir_pipeline_cf: igual a flex_fir_cc -> decimate_fir_cc -> iq_mag_cf, con cada
+# etapa en su hilo y anillos SPSC entre etapas
+import numpy as np
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+
+FS = 1e6
+FIR = (0, FS, 150e3, 0.0, 30e3, 1.0)      # mode, fs, f1, f2, width, gain
+WIN_HAMMING = 0
+
+
+class qa_fir_pipeline_cf(gr_unittest.TestCase):
+
+    def _x(self, n):
+        rng = np.random.RandomState(5)
+        return (rng.randn(n) + 1j * rng.randn(n)).astype(np.complex64)
+
+    def _run(self, x, *blks):
+        tb = gr.top_block()
+        snk = blocks.vector_sink_f()
+        tb.connect(blocks.vector_source_c(x.tolist(), False), *(blks + (snk,)))
+        tb.run()
+        return np.array(snk.data(), dtype=np.float32)
+
+    def _ref(self, x, D, cutoff, trans, scale):
+        blks = [howto.flex_fir_cc(*FIR)]
+        if D > 1:
+            blks.append(howto.decimate_fir_cc(D, FS, cutoff, trans, WIN_HAMMING, 6.76, True))
+        blks.append(howto.iq_mag_cf(scale))
+        return self._run(x, *blks)
+
+    def test_000_matches_block_chain(self):
+        x = self._x(60001)
+        for D, cutoff, trans in [(1, 0, 0), (4, 100e3, 25e3), (8, 50e3, 12e3), (10, 40e3, 10e3)]:
+            p = howto.fir_pipeline_cf(*(FIR + (D, cutoff, trans, 2.0)))
+            self.assertEqual(p.decimation(), D)
+            self.assertEqual(p.stages(), 3 if D > 1 else 2)
+            y = self._run(x, p)
+            ref = self._ref(x, D, cutoff, trans, 2.0)
+            # nada queda dentro del pipeline al terminar el stream
+            self.assertEqual(len(y), len(x) // D)
+            self.assertLess(np.max(np.abs(y - ref)), 1e-5)
+
+    def test_001_small_rings_and_cores(self):
+        # anillos minimos (se redondean a 4096 items) y etapas fijadas a un core
+        x = self._x(50000)
+        p = howto.fir_pipeline_cf(*(FIR + (4, 100e3, 25e3, 1.0, [0], 1)))
+        self.assertTrue(all(n >= 4096 for n in p.ring_items()))
+        self.assertEqual(len(p.ring_items()), p.stages() + 1)
+        y = self._run(x, p)
+        ref = self._ref(x, 4, 100e3, 25e3, 1.0)
+        self.assertEqual(len(y), len(ref))
+        self.assertLess(np.max(np.abs(y - ref)), 1e-5)
+
+    def test_002_utilization(self):
+        p = howto.fir_pipeline_cf(*(FIR + (4, 100e3, 25e3, 1.0)))
+        self._run(self._x(100000), p)
+        u = p.stage_utilization()
+        self.assertEqual(len(u), p.stages())
+        self.assertTrue(all(0.0 <= v <= 1.0 for v in u))
+        self.assertTrue(u[0] > 0.0)         # la FIR larga hizo trabajo
+        self.assertIn("|x|", p.describe())
+
+    def test_003_invalid(self):
+        self.assertRaises(ValueError, howto.fir_pipeline_cf, *(FIR + (0, 100e3, 25e3, 1.0)))
+        self.assertRaises(ValueError, howto.fir_pipeline_cf, *(FIR + (4, 0.0, 25e3, 1.0)))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_fir_pipeline_cf, "qa_fir_pipeline_cf.xml")
@@ -0,0 +1,46 @@
+# -*- coding: utf-8 -*-
+# Bloques fixed_fir generados (apps/howto_fixed_fir_gen.py): salida = convolucion
+# con sus taps (y decimacion), igual que filter.fir_filter_ccf
+import numpy as np
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+
+BLOCKS = [(howto.fixed_lp15_cc, 15, 1),
+          (howto.fixed_lp31_cc, 31, 1),
+          (howto.fixed_lp63_cc, 63, 1),
+          (howto.fixed_aa_decim4_cc, 63, 4)]
+
+
+class qa_fixed_fir(gr_unittest.TestCase):
+
+    def _run(self, x, blk):
+        tb = gr.top_block()
+        snk = blocks.vector_sink_c()
+        tb.connect(blocks.vector_source_c(x.tolist(), False), blk, snk)
+        tb.run()
+        return np.array(snk.data(), dtype=np.complex64)
+
+    def test_000_matches_convolution(self):
+        rng = np.random.RandomState(11)
+        x = (rng.randn(4003) + 1j * rng.randn(4003)).astype(np.complex64)
+        for make, N, D in BLOCKS:
+            blk = make()
+            h = np.array(blk.taps())
+            self.assertEqual(len(h), N)
+            self.assertEqual(blk.decimation(), D)
+            self.assertAlmostEqual(h.sum(), 1.0, places=5)
+            y = self._run(x, blk)
+            ref = np.convolve(x, h)[:len(x)][::D]
+            self.assertEqual(len(y), len(x) // D)
+            self.assertLess(np.max(np.abs(y - ref[:len(y)])), 1e-5)
+
+    def test_001_anti_alias_rejection(self):
+        # tono en 0.3 fs: despues de decimar por 4 caeria sobre 0.2 fs_out
+        n = np.arange(4 * 2000)
+        x = np.exp(2j * np.pi * 0.3 * n).astype(np.complex64)
+        y = self._run(x, howto.fixed_aa_decim4_cc())[100:]
+        self.assertLess(20 * np.log10(np.max(np.abs(y))), -70.0)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_fixed_fir, "qa_fixed_fir.xml")
@@ -68,3 +68,80 @@ class qa_flex_fir(unittest.TestCase):
         self.assertGreater(np.sum(np.abs(y)), 0.1)         # no todo ceros
         self.assertGreater(np.max(np.abs(y)), 1e-2)        # algún tap significativo
 
+    def test_cf_output_parts(self):
+        # real/imag filtran un solo carril; mag usa el filtro complejo completo
+        fs = 48000.0
+        x = (np.random.randn(3000) + 1j*np.random.randn(3000)).astype(np.complex64)
+        ref = self._run_and_get(x, howto.flex_fir_cc(2, fs, 2000.0, 6000.0, 400.0, 1.5))
+        parts = [(0, ref.real), (1, ref.imag), (2, np.abs(ref))]   # OUT_REAL/IMAG/MAG
+        for out, want in parts:
+            blk = howto.flex_fir_cf(2, fs, 2000.0, 6000.0, 400.0, 1.5, out)
+            self.assertEqual(blk.output(), out)
+            y = self._run_and_get(x, blk)
+            self.assertEqual(len(y), len(x))
+            self.assertLess(np.max(np.abs(y - want)), 1e-4)
+        self.assertRaises(ValueError, howto.flex_fir_cf, 0, fs, 1e3, 0.0, 300.0, 1.0, 3)
+
+    def test_ff_spec_driven_length(self):
+        # Kaiser: el largo justo para la atenuacion pedida, no 4*fs/width
+        fs, f1, w = 48000.0, 3000.0, 600.0
+        legacy = howto.flex_fir_ff(0, fs, f1, 0.0, w, 1.0)
+        self.assertEqual(legacy.ntaps(), 321)
+        self.assertEqual(legacy.macs_per_sample(), 161)
+        for atten in (40.0, 60.0):
+            blk = howto.flex_fir_ff(0, fs, f1, 0.0, w, 1.0, atten)
+            self.assertLess(blk.ntaps(), legacy.ntaps())
+            n = 4096
+            imp = np.zeros(n, dtype=np.float32); imp[0] = 1.0
+            h = self._run_and_get(imp, blk)[:blk.ntaps()]
+            self.assertEqual(len(blk.taps()), blk.ntaps())
+            H = np.abs(np.fft.rfft(h, n))
+            f = np.arange(len(H)) * fs / n
+            self.assertLess(20*np.log10(H[f >= f1 + w/2].max()), -atten + 1.0)
+            self.assertLess(np.max(np.abs(20*np.log10(H[f <= f1 - w/2]))), 0.15)
+        # un ripple de 0.1 dB exige ~45 dB: mas taps que 40 dB solos
+        blk = howto.flex_fir_ff(0, fs, f1, 0.0, w, 1.0, 40.0, 0.1)
+        self.assertGreater(blk.ntaps(), howto.flex_fir_ff(0, fs, f1, 0.0, w, 1.0, 40.0).ntaps())
+        blk.set_attenuation(0.0); blk.set_ripple(0.0)
+        self.assertEqual(blk.ntaps(), legacy.ntaps())
+        # complejo: dos carriles; cf real: uno
+        self.assertEqual(howto.flex_fir_cc(0, fs, f1, 0.0, w, 1.0).macs_per_sample(), 322)
+        self.assertEqual(howto.flex_fir_cf(0, fs, f1, 0.0, w, 1.0, 0).macs_per_sample(), 161)
+
+    def test_cc_threads_match_single(self):
+        # 2001 taps: cada work() supera el umbral y se reparte entre hilos
+        fs = 20e6
+        x = (np.random.randn(50000) + 1j*np.random.randn(50000)).astype(np.complex64)
+        ref = self._run_and_get(x, howto.flex_fir_cc(0, fs, 1e6, 0.0, 4e4, 1.0))
+        blk = howto.flex_fir_cc(0, fs, 1e6, 0.0, 4e4, 1.0)
+        blk.set_threads(4)
+        self.assertEqual(blk.threads(), 4)
+        y = self._run_and_get(x, blk)
+        self.assertEqual(len(y), len(ref))
+        self.assertLess(np.max(np.abs(y - ref)), 1e-6)
+        blk.set_threads(1)
+        self.assertEqual(blk.threads(), 1)
+
+    def test_accumulation_policies(self):
+        # 0 = float, 1 = split, 2 = double: mismas salidas salvo redondeo
+        fs = 1e6
+        x = np.random.randn(20000).astype(np.float32)
+        x[::97] *= 1e3                                # alto rango dinamico
+        ys = []
+        for acc in (0, 1, 2):
+            blk = howto.flex_fir_ff(0, fs, 1e5, 0.0, 1e3, 1.0)   # ~4000 taps
+            blk.set_accumulation(acc)
+            self.assertEqual(blk.accumulation(), acc)
+            ys.append(self._run_and_get(x, blk))
+        ref = ys[2]
+        scale = np.max(np.abs(ref))
+        for y in ys[:2]:
+            self.assertLess(np.max(np.abs(y - ref)) / scale, 1e-5)
+        xc = (x + 1j * x[::-1]).astype(np.complex64)
+        a = howto.flex_fir_cc(0, fs, 1e5, 0.0, 1e3, 1.0)
+        b = howto.flex_fir_cc(0, fs, 1e5, 0.0, 1e3, 1.0)
+        b.set_accumulation(2)
+        ya, yb = self._run_and_get(xc, a), self._run_and_get(xc, b)
+        self.assertLess(np.max(np.abs(ya - yb)) / np.max(np.abs(yb)), 1e-5)
+        self.assertRaises(ValueError, blk.set_accumulation, 3)
+
@@ -0,0 +1,70 @@
+# -*- coding: utf-8 -*-
+# flex_fir_bank_ff: cada salida identica a flex_fir_ff con los mismos parametros
+import numpy as np
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+
+FS = 48000.0
+MODES = [0, 1, 2, 2, 0]
+F1 = [3000.0, 9000.0, 2000.0, 12000.0, 500.0]
+F2 = [0.0, 0.0, 6000.0, 18000.0, 0.0]
+WIDTH = [600.0, 900.0, 400.0, 1200.0, 300.0]   # largos de taps distintos
+GAIN = [1.0, 0.5, 2.0, 1.0, 1.0]
+
+
+class qa_flex_fir_bank_ff(gr_unittest.TestCase):
+
+    def _x(self, n=5000):
+        return np.random.RandomState(3).randn(n).astype(np.float32)
+
+    def _run_single(self, x, b):
+        tb = gr.top_block()
+        snk = blocks.vector_sink_f()
+        tb.connect(blocks.vector_source_f(x.tolist(), False),
+                   howto.flex_fir_ff(MODES[b], FS, F1[b], F2[b], WIDTH[b], GAIN[b]), snk)
+        tb.run()
+        return np.array(snk.data(), dtype=np.float32)
+
+    def _run_bank(self, x, bank, nouts):
+        tb = gr.top_block()
+        tb.connect(blocks.vector_source_f(x.tolist(), False), bank)
+        snks = [blocks.vector_sink_f() for _ in range(nouts)]
+        for b, s in enumerate(snks):
+            tb.connect((bank, b), s)
+        tb.run()
+        return [np.array(s.data(), dtype=np.float32) for s in snks]
+
+    def test_000_matches_flex_fir_ff(self):
+        x = self._x()
+        bank = howto.flex_fir_bank_ff(FS, MODES, F1, F2, WIDTH, GAIN)
+        self.assertEqual(bank.nbands(), len(MODES))
+        self.assertEqual(bank.ntaps(), max(len(bank.taps(b)) for b in range(len(MODES))))
+        ys = self._run_bank(x, bank, len(MODES))
+        for b, y in enumerate(ys):
+            ref = self._run_single(x, b)
+            self.assertEqual(len(y), len(x))
+            self.assertLess(np.max(np.abs(y - ref)), 1e-4)
+
+    def test_001_trailing_outputs_unconnected(self):
+        x = self._x(3000)
+        bank = howto.flex_fir_bank_ff(FS, MODES, F1, F2, WIDTH, GAIN)
+        ys = self._run_bank(x, bank, 2)
+        for b in range(2):
+            self.assertLess(np.max(np.abs(ys[b] - self._run_single(x, b))), 1e-4)
+
+    def test_002_set_band(self):
+        x = self._x(3000)
+        bank = howto.flex_fir_bank_ff(FS, MODES, F1, F2, WIDTH, GAIN)
+        bank.set_band(0, MODES[1], F1[1], F2[1], WIDTH[1], GAIN[1])
+        ys = self._run_bank(x, bank, 2)
+        self.assertLess(np.max(np.abs(ys[0] - ys[1])), 1e-6)
+        self.assertRaises(IndexError, bank.set_band, len(MODES), 0, 1e3, 0, 100.0, 1.0)
+
+    def test_003_bad_args(self):
+        self.assertRaises(ValueError, howto.flex_fir_bank_ff, FS, [], [], [], [], [])
+        self.assertRaises(ValueError, howto.flex_fir_bank_ff, FS, [0, 0], [1e3], [0.0, 0.0],
+                          [100.0, 100.0], [1.0, 1.0])
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_flex_fir_bank_ff, "qa_flex_fir_bank_ff.xml")
@@ -0,0 +1,77 @@
+# -*- coding: utf-8 -*-
+# flex_fir_sc16c / flex_fir_sc8c (float y fixed point) contra flex_fir_cc
+import numpy as np
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+
+
+class qa_flex_fir_sc(gr_unittest.TestCase):
+
+    def _run(self, src, blk):
+        tb = gr.top_block()
+        snk = blocks.vector_sink_c()
+        tb.connect(src, blk, snk)
+        tb.run()
+        return np.array(snk.data(), dtype=np.complex64)
+
+    def _reference(self, z, fs):
+        ref = howto.flex_fir_cc(0, fs, 3000.0, 0.0, 1000.0, 1.0)
+        return self._run(blocks.vector_source_c(z.astype(np.complex64).tolist(), False), ref)
+
+    def _check(self, make, iq, full, tol_fixed):
+        fs = 48000.0
+        z = (iq[:, 0] + 1j * iq[:, 1]) / float(full)
+        ref = self._reference(z, fs)
+        for fixed in (False, True):
+            blk = make(0, fs, 3000.0, 0.0, 1000.0, 1.0, fixed)
+            if full == 32768:
+                src = blocks.vector_source_s(iq.ravel().tolist(), False, 2)
+            else:
+                src = blocks.vector_source_b((iq.ravel() & 0xFF).tolist(), False, 2)
+            y = self._run(src, blk)
+            self.assertEqual(len(y), len(ref))
+            tol = tol_fixed if fixed else 1e-5
+            self.assertLess(np.max(np.abs(y - ref)), tol)
+            if fixed:
+                self.assertGreaterEqual(blk.taps_shift(), 0)
+            else:
+                self.assertEqual(blk.taps_shift(), -1)
+
+    def test_000_sc16(self):
+        rng = np.random.RandomState(3)
+        self._check(howto.flex_fir_sc16c, rng.randint(-32768, 32768, size=(5000, 2)), 32768, 5e-3)
+
+    def test_001_sc8(self):
+        rng = np.random.RandomState(4)
+        self._check(howto.flex_fir_sc8c, rng.randint(-128, 128, size=(5000, 2)), 128, 5e-3)
+
+    def test_002_switch_fixed_at_runtime(self):
+        iq = np.tile([[1000, -1000]], (2000, 1))
+        blk = howto.flex_fir_sc16c(0, 48000.0, 3000.0, 0.0, 1000.0, 1.0, False)
+        blk.set_fixed_point(True)
+        self.assertTrue(blk.fixed_point())
+        y = self._run(blocks.vector_source_s(iq.ravel().tolist(), False, 2), blk)
+        # lleno el historial, la DC sale con ganancia sum(taps)
+        dc = (1000 - 1000j) / 32768.0
+        self.assertLess(abs(y[-1] - dc * sum(blk.taps())), 1e-4)
+
+    def test_003_path_queries_before_work(self):
+        # shift y MACs validos sin correr work(), y del camino que corre de verdad
+        mk = lambda g, fixed: howto.flex_fir_sc16c(0, 48000.0, 3000.0, 0.0, 1000.0, g, fixed)
+        blk = mk(1.0, True)
+        n = len(blk.taps())
+        self.assertGreater(n, 0)
+        self.assertGreaterEqual(blk.taps_shift(), 0)
+        self.assertEqual(blk.macs_per_sample(), 2 * n)
+        blk.set_fixed_point(False)
+        self.assertEqual(blk.taps_shift(), -1)
+        self.assertEqual(blk.macs_per_sample(), 2 * ((n + 1) // 2))
+        # taps fuera de int16: pide fixed pero corre el camino float
+        big = mk(1e6, True)
+        self.assertTrue(big.fixed_point())
+        self.assertEqual(big.taps_shift(), -1)
+        self.assertEqual(big.macs_per_sample(), 2 * ((n + 1) // 2))
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_flex_fir_sc, "qa_flex_fir_sc.xml")
@@ -0,0 +1,98 @@
+# -*- coding: utf-8 -*-
+# freq_xlating_decimate_fir_cc contra mezclador + decimate_fir_cc
+import time
+import numpy as np
+from gnuradio import gr, gr_unittest, blocks, analog
+import howto_swig as howto
+
+FS, D = 1e6, 8
+CUT, TW = 40e3, 10e3
+
+
+class qa_freq_xlating_decimate_fir_cc(gr_unittest.TestCase):
+
+    def _run(self, x, blk):
+        tb = gr.top_block()
+        snk = blocks.vector_sink_c()
+        tb.connect(blocks.vector_source_c(x.astype(np.complex64).tolist(), False), blk, snk)
+        tb.run()
+        return np.array(snk.data(), dtype=np.complex128)
+
+    def _make(self, f0):
+        return howto.freq_xlating_decimate_fir_cc(D, FS, f0, CUT, TW, 0, 6.76)
+
+    def test_000_tone_moves_to_baseband(self):
+        f0 = 123456.0
+        n = np.arange(80000)
+        y = self._run(np.exp(2j * np.pi * (f0 + 5e3) / FS * n), self._make(f0))[1000:]
+        self.assertLess(abs(np.mean(np.abs(y)) - 1.0), 0.01)
+        f = np.mean(np.angle(y[1:] * np.conj(y[:-1]))) * (FS / D) / (2 * np.pi)
+        self.assertAlmostEqual(f, 5e3, delta=1.0)
+
+    def test_001_matches_mixer_then_decimator(self):
+        f0 = -210e3
+        rng = np.random.RandomState(5)
+        x = rng.randn(40000) + 1j * rng.randn(40000)
+        mixed = x * np.exp(-2j * np.pi * f0 / FS * np.arange(len(x)))
+        ref = self._run(mixed, howto.decimate_fir_cc(D, FS, CUT, TW, 0, 6.76, False))
+        y = self._run(x, self._make(f0))
+        self.assertEqual(len(y), len(ref))
+        y, ref = y[100:], ref[100:]
+        # misma salida salvo una fase constante
+        rot = np.vdot(ref, y) / np.vdot(ref, ref)
+        self.assertAlmostEqual(abs(rot), 1.0, places=4)
+        self.assertLess(np.max(np.abs(y - rot * ref)), 1e-3)
+
+    def test_002_retune_keeps_taps_length(self):
+        blk = self._make(0.0)
+        taps0 = blk.taps()
+        self.assertLess(max(abs(t.imag) for t in taps0), 1e-9)
+        blk.set_center_freq(100e3)
+        self.assertEqual(blk.center_freq(), 100e3)
+        n = np.arange(40000)
+        y = self._run(np.exp(2j * np.pi * 100e3 / FS * n), blk)[1000:]
+        self.assertEqual(len(blk.taps()), len(taps0))
+        self.assertGreater(max(abs(t.imag) for t in blk.taps()), 1e-4)
+        # el tono en 100 kHz queda en DC
+        self.assertLess(np.std(np.angle(y[1:] * np.conj(y[:-1]))), 1e-3)
+
+    def test_003_retune_while_running(self):
+        # tono en 105 kHz, centro 100 -> 110 kHz en marcha: +5 kHz pasa a
+        # -5 kHz sin salto de fase ni de amplitud y sin muestras de mas o de menos
+        N = 2000000
+        blk = self._make(100e3)
+        snk = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(analog.sig_source_c(FS, analog.GR_COS_WAVE, 105e3, 1.0),
+                   blocks.head(gr.sizeof_gr_complex, N),
+                   blocks.throttle(gr.sizeof_gr_complex, 10e6), blk, snk)
+        taps0 = blk.taps()
+        tb.start()
+        t0 = time.time()
+        while len(snk.data()) < 2000 and time.time() - t0 < 5.0:
+            time.sleep(0.001)
+        blk.set_center_freq(110e3)
+        while blk.taps() == taps0 and time.time() - t0 < 5.0:
+            time.sleep(0.001)
+        n_switch = len(snk.data())
+        tb.wait()
+        self.assertNotEqual(blk.taps(), taps0)
+
+        y = np.array(snk.data(), dtype=np.complex128)
+        self.assertEqual(len(y), N // D)
+        self.assertLess(n_switch + 1000, len(y))
+        y = y[1000:]
+        self.assertLess(np.max(np.abs(np.abs(y) - 1.0)), 0.01)
+        # cada paso de fase es el de +5 kHz o el de -5 kHz, y cambia una sola vez
+        d = np.angle(y[1:] * np.conj(y[:-1]))
+        s = 2 * np.pi * 5e3 * D / FS
+        up = np.abs(d - s) < 1e-3
+        dn = np.abs(d + s) < 1e-3
+        self.assertTrue((up | dn).all())
+        self.assertTrue(dn.any())
+        k = int(np.argmax(dn))
+        self.assertTrue(up[:k].all() and dn[k:].all())
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_freq_xlating_decimate_fir_cc, "qa_freq_xlating_decimate_fir_cc.xml")
@@ -0,0 +1,66 @@
+# -*- coding: utf-8 -*-
+# iq_select_multi_cf: cada salida igual a un iq_select_cf con ese modo
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+import math
+
+
+class qa_iq_select_multi_cf(gr_unittest.TestCase):
+
+    def _x(self, n):
+        # incluye los ejes (fase +-pi, 0) y el origen
+        x = [1+0j, 0+1j, -1+0j, 0-1j, 0j, -3+4j]
+        x += [complex(math.cos(0.37 * i) * (1 + i % 5), math.sin(0.11 * i)) for i in range(n)]
+        return x
+
+    def _run(self, x, blk, nports):
+        tb = gr.top_block()
+        snks = [blocks.vector_sink_f() for _ in range(nports)]
+        tb.connect(blocks.vector_source_c(x, False), blk)
+        for k in range(nports):
+            tb.connect((blk, k), snks[k])
+        tb.run()
+        return [list(s.data()) for s in snks]
+
+    def _ref(self, x, scale, mode):
+        return self._run(x, howto.iq_select_cf(scale, mode), 1)[0]
+
+    def test_000_matches_iq_select(self):
+        x = self._x(3000)
+        modes = [0, 1, 2, 3, 4, 5]
+        ys = self._run(x, howto.iq_select_multi_cf(0.5, modes), len(modes))
+        for m, y in zip(modes, ys):
+            self.assertFloatTuplesAlmostEqual(y, self._ref(x, 0.5, m), 6)
+
+    def test_001_repeated_and_invalid(self):
+        # modo repetido, modo invalido (-1) y salida sin modo -> ceros
+        x = self._x(1500)
+        blk = howto.iq_select_multi_cf(2.0, [3, 5, 3, -1])
+        ys = self._run(x, blk, 5)
+        self.assertEqual(ys[0], ys[2])
+        self.assertFloatTuplesAlmostEqual(ys[0], self._ref(x, 2.0, 3), 6)
+        self.assertFloatTuplesAlmostEqual(ys[1], self._ref(x, 2.0, 5), 6)
+        self.assertEqual(ys[3], [0.0] * len(x))
+        self.assertEqual(ys[4], [0.0] * len(x))
+
+    def test_002_fewer_connected(self):
+        # solo se conectan las dos primeras salidas de cuatro modos
+        x = self._x(1000)
+        ys = self._run(x, howto.iq_select_multi_cf(1.0, [1, 0, 2, 4]), 2)
+        self.assertFloatTuplesAlmostEqual(ys[0], self._ref(x, 1.0, 1), 6)
+        self.assertFloatTuplesAlmostEqual(ys[1], self._ref(x, 1.0, 0), 6)
+
+    def test_003_runtime_modes(self):
+        blk = howto.iq_select_multi_cf(1.0, [0])
+        blk.set_modes([4, 1])
+        blk.set_scale(3.0)
+        self.assertEqual(list(blk.modes()), [4, 1])
+        self.assertAlmostEqual(blk.scale(), 3.0)
+        x = self._x(500)
+        ys = self._run(x, blk, 2)
+        self.assertFloatTuplesAlmostEqual(ys[0], self._ref(x, 3.0, 4), 6)
+        self.assertFloatTuplesAlmostEqual(ys[1], self._ref(x, 3.0, 1), 6)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_iq_select_multi_cf, "qa_iq_select_multi_cf.xml")
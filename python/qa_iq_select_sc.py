@@ -0,0 +1,50 @@
+# -*- coding: utf-8 -*-
+# iq_select_sc16f / iq_select_sc8f contra iq_select_cf con la entrada ya normalizada
+import numpy as np
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+
+
+def _iq(n, full, seed):
+    rng = np.random.RandomState(seed)
+    return rng.randint(-full, full, size=(n, 2))
+
+
+class qa_iq_select_sc(gr_unittest.TestCase):
+
+    def _run(self, src, blk):
+        tb = gr.top_block()
+        snk = blocks.vector_sink_f()
+        tb.connect(src, blk, snk)
+        tb.run()
+        return np.array(snk.data(), dtype=np.float32)
+
+    def _reference(self, z, mode, scale):
+        ref = howto.iq_select_cf(scale, mode)
+        return self._run(blocks.vector_source_c(z.astype(np.complex64).tolist(), False), ref)
+
+    def test_000_sc16_all_modes(self):
+        iq = _iq(1000, 32768, 1)
+        z = (iq[:, 0] + 1j * iq[:, 1]) / 32768.0
+        for mode in range(6):
+            src = blocks.vector_source_s(iq.ravel().tolist(), False, 2)
+            y = self._run(src, howto.iq_select_sc16f(0.5, mode))
+            np.testing.assert_allclose(y, self._reference(z, mode, 0.5), rtol=1e-5, atol=1e-6)
+
+    def test_001_sc8_all_modes(self):
+        iq = _iq(1000, 128, 2)
+        z = (iq[:, 0] + 1j * iq[:, 1]) / 128.0
+        for mode in range(6):
+            # vector_source_b es unsigned: se pasan los bytes en complemento a 2
+            src = blocks.vector_source_b((iq.ravel() & 0xFF).tolist(), False, 2)
+            y = self._run(src, howto.iq_select_sc8f(2.0, mode))
+            np.testing.assert_allclose(y, self._reference(z, mode, 2.0), rtol=1e-5, atol=1e-6)
+
+    def test_002_full_scale_mag(self):
+        src = blocks.vector_source_s([-32768, 0, 16384, 0, 0, -16384], False, 2)
+        y = self._run(src, howto.iq_select_sc16f(1.0, 0))
+        self.assertFloatTuplesAlmostEqual(y.tolist(), [1.0, 0.5, 0.5], 6)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_iq_select_sc, "qa_iq_select_sc.xml")
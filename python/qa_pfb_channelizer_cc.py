@@ -0,0 +1,99 @@
+# -*- coding: utf-8 -*-
+# pfb_channelizer_cc: cada salida igual a mezclar + filtrar + diezmar
+import time
+import numpy as np
+from gnuradio import gr, gr_unittest, blocks, analog
+import howto_swig as howto
+
+FS = 1e6
+
+
+class qa_pfb_channelizer_cc(gr_unittest.TestCase):
+
+    def _run(self, x, blk, nouts):
+        tb = gr.top_block()
+        tb.connect(blocks.vector_source_c(x.astype(np.complex64).tolist(), False), blk)
+        sinks = []
+        for k in range(nouts):
+            snk = blocks.vector_sink_c()
+            tb.connect((blk, k), snk)
+            sinks.append(snk)
+        tb.run()
+        return [np.array(s.data(), dtype=np.complex128) for s in sinks]
+
+    def _reference(self, x, taps, M, k, S):
+        # mezcla a k*fs/M, filtra y toma la muestra S-1, 2S-1, ...
+        m = np.arange(len(x))
+        z = np.convolve(x * np.exp(-2j * np.pi * k * m / M), taps)[:len(x)]
+        return z[S - 1::S]
+
+    def _check(self, M, os):
+        rng = np.random.RandomState(M + os)
+        x = rng.randn(M * 400) + 1j * rng.randn(M * 400)
+        blk = howto.pfb_channelizer_cc(M, FS, 0.5 * FS / M, 0.2 * FS / M, os)
+        ys = self._run(x, blk, M)
+        taps = np.array(blk.taps())
+        S = M // os
+        for k in range(M):
+            ref = self._reference(x, taps, M, k, S)
+            self.assertEqual(len(ys[k]), len(ref))
+            self.assertLess(np.max(np.abs(ys[k] - ref)), 1e-3)
+
+    def test_000_critically_sampled(self):
+        self._check(8, 1)
+
+    def test_001_oversampled(self):
+        self._check(8, 2)
+
+    def test_002_tone_lands_in_its_channel(self):
+        M = 16
+        n = np.arange(M * 2000)
+        x = np.exp(2j * np.pi * (3 * FS / M + 2e3) / FS * n)
+        ys = self._run(x, howto.pfb_channelizer_cc(M, FS, 0.5 * FS / M, 0.2 * FS / M), M)
+        p = [np.mean(np.abs(y[200:]) ** 2) for y in ys]
+        self.assertEqual(int(np.argmax(p)), 3)
+        self.assertAlmostEqual(p[3], 1.0, delta=0.02)
+        self.assertLess(max(p[k] for k in range(M) if k not in (2, 3, 4)), 1e-4)
+
+    def test_003_partial_outputs(self):
+        M = 8
+        x = np.ones(M * 100)
+        ys = self._run(x, howto.pfb_channelizer_cc(M, FS, 0.5 * FS / M, 0.2 * FS / M), 2)
+        self.assertEqual(len(ys), 2)
+        self.assertAlmostEqual(abs(ys[0][-1]), 1.0, places=3)
+        self.assertLess(abs(ys[1][-1]), 1e-3)
+
+    def test_004_retune_keeps_phase(self):
+        # set_cutoff en marcha: ni transitorio a cero ni salto de fase
+        M = 16
+        N = M * 200000
+        f = 3 * FS / M + 2e3
+        tb = gr.top_block()
+        src = analog.sig_source_c(FS, analog.GR_COS_WAVE, f, 1.0)
+        blk = howto.pfb_channelizer_cc(M, FS, 0.5 * FS / M, 0.2 * FS / M)
+        tb.connect(src, blocks.head(gr.sizeof_gr_complex, N),
+                   blocks.throttle(gr.sizeof_gr_complex, 10e6), blk)
+        for k in range(3):
+            tb.connect((blk, k), blocks.null_sink(gr.sizeof_gr_complex))
+        snk = blocks.vector_sink_c()
+        tb.connect((blk, 3), snk)
+        taps0 = blk.taps()
+        tb.start()
+        while len(snk.data()) < 2000:
+            time.sleep(0.001)
+        blk.set_cutoff(0.4 * FS / M)
+        while blk.taps() == taps0:
+            time.sleep(0.001)
+        n_switch = len(snk.data())
+        tb.wait()
+        y = np.array(snk.data(), dtype=np.complex128)
+        self.assertEqual(len(y), N // M)
+        self.assertLess(n_switch + 1000, len(y))
+        # misma longitud de prototipo, misma latencia: la fase avanza igual
+        self.assertLess(np.max(np.abs(np.abs(y[200:]) - 1.0)), 0.02)
+        step = np.angle(y[201:] * np.conj(y[200:-1]))
+        self.assertLess(np.max(np.abs(step - 2 * np.pi * 2e3 * M / FS)), 1e-3)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_pfb_channelizer_cc, "qa_pfb_channelizer_cc.xml")
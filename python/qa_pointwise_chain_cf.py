@@ -0,0 +1,57 @@
+# -*- coding: utf-8 -*-
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+import numpy as np
+
+class qa_pointwise_chain_cf(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def _run(self, blk, x):
+        src = blocks.vector_source_c(x.tolist(), repeat=False)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, blk, snk)
+        self.tb.run()
+        return np.array(snk.data(), dtype=np.float32)
+
+    def test_001_matches_block_chain(self):
+        # iq_mag_cf(s) -> square_ff -> gain_ff(g)  ==  pointwise_chain_cf(0, True, g*s*s)
+        s, g = 0.5, 3.0
+        x = (np.random.randn(4096) + 1j * np.random.randn(4096)).astype(np.complex64)
+
+        src = blocks.vector_source_c(x.tolist(), repeat=False)
+        mag = howto.iq_mag_cf(s)
+        sq = howto.square_ff()
+        gn = howto.gain_ff(g)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, mag, sq, gn, snk)
+        self.tb.run()
+        ref = np.array(snk.data(), dtype=np.float32)
+
+        self.tb = gr.top_block()
+        y = self._run(howto.pointwise_chain_cf(0, True, g * s * s), x)
+        np.testing.assert_allclose(y, ref, rtol=1e-5, atol=1e-5)
+
+    def test_002_modes(self):
+        x = np.array([3+4j, -1+1j, 0-2j, 0.5+0j], dtype=np.complex64)
+        g = 2.0
+        refs = [np.abs(x), np.abs(x)**2, np.angle(x), x.real, x.imag, np.abs(np.angle(x))]
+        for mode, f in enumerate(refs):
+            for sq in (False, True):
+                self.tb = gr.top_block()
+                y = self._run(howto.pointwise_chain_cf(mode, sq, g), x)
+                exp = g * (f ** 2 if sq else f)
+                np.testing.assert_allclose(y, exp.astype(np.float32), rtol=1e-5, atol=1e-5,
+                                           err_msg="mode %d square %d" % (mode, sq))
+
+    def test_003_invalid_mode_zero(self):
+        x = np.array([1+1j, 2+2j], dtype=np.complex64)
+        y = self._run(howto.pointwise_chain_cf(9, True, 1.0), x)
+        self.assertFloatTuplesAlmostEqual(y.tolist(), [0.0, 0.0], 6)
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_pointwise_chain_cf, "qa_pointwise_chain_cf.xml")
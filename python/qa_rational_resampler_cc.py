@@ -0,0 +1,70 @@
+# -*- coding: utf-8 -*-
+# rational_resampler_cc: largo, ganancia en banda, rechazo e indices de tags
+import numpy as np
+import pmt
+from gnuradio import gr, gr_unittest, blocks
+import howto_swig as howto
+
+
+class qa_rational_resampler_cc(gr_unittest.TestCase):
+
+    def _make(self, L, M, fs=1e6):
+        fo = min(fs, fs * L / float(M))
+        return howto.rational_resampler_cc(L, M, fs, 0.4 * fo, 0.1 * fo, 0, 6.76)
+
+    def _run(self, x, blk, tags=()):
+        tb = gr.top_block()
+        src = blocks.vector_source_c(x.astype(np.complex64).tolist(), False, 1, list(tags))
+        snk = blocks.vector_sink_c()
+        tb.connect(src, blk, snk)
+        tb.run()
+        return np.array(snk.data(), dtype=np.complex64), snk.tags()
+
+    def _tone(self, blk, f, fs=1e6, n=30000):
+        x = np.exp(2j * np.pi * f / fs * np.arange(n))
+        y, _ = self._run(x, blk)
+        return y[len(y) // 2:]
+
+    def test_000_reduced_ratio_and_length(self):
+        blk = howto.rational_resampler_cc(3072, 2500, 30.72e6, 10e6, 2e6)
+        self.assertEqual((blk.interpolation(), blk.decimation()), (768, 625))
+        for L, M in ((3, 2), (2, 3), (625, 768), (5, 1)):
+            y, _ = self._run(np.ones(6000), self._make(L, M))
+            self.assertLessEqual(abs(len(y) - 6000 * L // M), 1)
+
+    def test_001_passband_tone(self):
+        for L, M in ((3, 2), (2, 3), (625, 768)):
+            fs_out = 1e6 * L / M
+            y = self._tone(self._make(L, M), 0.1 * min(1e6, fs_out))
+            self.assertLess(abs(np.mean(np.abs(y)) - 1.0), 0.01)
+            # frecuencia a la salida: misma frecuencia absoluta
+            ph = np.angle(y[1:] * np.conj(y[:-1]))
+            self.assertAlmostEqual(np.mean(ph) * fs_out / (2 * np.pi), 0.1 * min(1e6, fs_out), delta=10.0)
+
+    def test_002_stopband_tone(self):
+        # 2/3: la salida es 666 kHz; un tono a 400 kHz tiene que desaparecer
+        y = self._tone(self._make(2, 3), 400e3)
+        self.assertLess(20 * np.log10(np.max(np.abs(y))), -45.0)
+
+    def test_003_tag_offsets(self):
+        L, M = 3, 4
+        offs = [0, 1, 7, 100, 1001, 2990]
+        tags = []
+        for o in offs:
+            t = gr.tag_t()
+            t.offset = o
+            t.key = pmt.intern("mark")
+            t.value = pmt.from_long(o)
+            tags.append(t)
+        _, out = self._run(np.zeros(3000), self._make(L, M), tags)
+        got = sorted((pmt.to_long(t.value), t.offset) for t in out)
+        want = [(o, (o * L + M - 1) // M) for o in offs]
+        self.assertEqual(got, want)
+
+    def test_004_bad_args(self):
+        self.assertRaises(ValueError, howto.rational_resampler_cc, 0, 2, 1e6, 1e5, 1e4)
+        self.assertRaises(ValueError, howto.rational_resampler_cc, 3, 2, 1e6, -1.0, 1e4)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_rational_resampler_cc, "qa_rational_resampler_cc.xml")
@@ -13,12 +13,30 @@
 #include "howto/moving_avg_history_ff.h"
 #include "howto/iq_mag_cf.h"
 #include "howto/iq_select_cf.h"
+#include "howto/iq_select_sc16f.h"
+#include "howto/iq_select_sc8f.h"
+#include "howto/pointwise_chain_cf.h"
 #include "howto/flex_fir_ff.h"
 #include "howto/flex_fir_cc.h"
 #include "howto/flex_fir_cf.h"
+#include "howto/flex_fir_sc16c.h"
+#include "howto/flex_fir_sc8c.h"
 #include "howto/downsample_cc.h"
 #include "howto/decimate_fir_cc.h"
+#include "howto/cic_decim_cc.h"
+#include "howto/cic_decim_ff.h"
+#include "howto/rational_resampler_cc.h"
+#include "howto/freq_xlating_decimate_fir_cc.h"
+#include "howto/pfb_channelizer_cc.h"
+#include "howto/flex_fir_bank_ff.h"
+#include "howto/fixed_lp15_cc.h"
+#include "howto/fixed_lp31_cc.h"
+#include "howto/fixed_lp63_cc.h"
+#include "howto/fixed_aa_decim4_cc.h"
+#include "howto/fir_pipeline_cf.h"
+#include "howto/iq_select_multi_cf.h"
 #include "howto/dual_decimate_ff.h"
+#include "howto/dual_decimate_lanes_ff.h"
 #include "howto/detector_ff.h"
 #include "howto/gate_ff.h"
 #include "howto/detector_exp_ff.h"
@@ -37,18 +55,54 @@ GR_SWIG_BLOCK_MAGIC2(howto, moving_avg_history_ff);
 GR_SWIG_BLOCK_MAGIC2(howto, iq_mag_cf);
 %include "howto/iq_select_cf.h"
 GR_SWIG_BLOCK_MAGIC2(howto, iq_select_cf);
+%include "howto/iq_select_sc16f.h"
+GR_SWIG_BLOCK_MAGIC2(howto, iq_select_sc16f);
+%include "howto/iq_select_sc8f.h"
+GR_SWIG_BLOCK_MAGIC2(howto, iq_select_sc8f);
+%include "howto/pointwise_chain_cf.h"
+GR_SWIG_BLOCK_MAGIC2(howto, pointwise_chain_cf);
 %include "howto/flex_fir_ff.h"
 GR_SWIG_BLOCK_MAGIC2(howto, flex_fir_ff);
 %include "howto/flex_fir_cc.h"
 GR_SWIG_BLOCK_MAGIC2(howto, flex_fir_cc);
 %include "howto/flex_fir_cf.h"
 GR_SWIG_BLOCK_MAGIC2(howto, flex_fir_cf);
+%include "howto/flex_fir_sc16c.h"
+GR_SWIG_BLOCK_MAGIC2(howto, flex_fir_sc16c);
+%include "howto/flex_fir_sc8c.h"
+GR_SWIG_BLOCK_MAGIC2(howto, flex_fir_sc8c);
 %include "howto/downsample_cc.h"
 GR_SWIG_BLOCK_MAGIC2(howto, downsample_cc);
 %include "howto/decimate_fir_cc.h"
 GR_SWIG_BLOCK_MAGIC2(howto, decimate_fir_cc);
+%include "howto/cic_decim_cc.h"
+GR_SWIG_BLOCK_MAGIC2(howto, cic_decim_cc);
+%include "howto/cic_decim_ff.h"
+GR_SWIG_BLOCK_MAGIC2(howto, cic_decim_ff);
+%include "howto/rational_resampler_cc.h"
+GR_SWIG_BLOCK_MAGIC2(howto, rational_resampler_cc);
+%include "howto/freq_xlating_decimate_fir_cc.h"
+GR_SWIG_BLOCK_MAGIC2(howto, freq_xlating_decimate_fir_cc);
+%include "howto/pfb_channelizer_cc.h"
+GR_SWIG_BLOCK_MAGIC2(howto, pfb_channelizer_cc);
+%include "howto/flex_fir_bank_ff.h"
+GR_SWIG_BLOCK_MAGIC2(howto, flex_fir_bank_ff);
+%include "howto/fixed_lp15_cc.h"
+GR_SWIG_BLOCK_MAGIC2(howto, fixed_lp15_cc);
+%include "howto/fixed_lp31_cc.h"
+GR_SWIG_BLOCK_MAGIC2(howto, fixed_lp31_cc);
+%include "howto/fixed_lp63_cc.h"
+GR_SWIG_BLOCK_MAGIC2(howto, fixed_lp63_cc);
+%include "howto/fixed_aa_decim4_cc.h"
+GR_SWIG_BLOCK_MAGIC2(howto, fixed_aa_decim4_cc);
+%include "howto/fir_pipeline_cf.h"
+GR_SWIG_BLOCK_MAGIC2(howto, fir_pipeline_cf);
+%include "howto/iq_select_multi_cf.h"
+GR_SWIG_BLOCK_MAGIC2(howto, iq_select_multi_cf);
 %include "howto/dual_decimate_ff.h"
 GR_SWIG_BLOCK_MAGIC2(howto, dual_decimate_ff);
+%include "howto/dual_decimate_lanes_ff.h"
+GR_SWIG_BLOCK_MAGIC2(howto, dual_decimate_lanes_ff);
 %include "howto/gate_ff.h"
 GR_SWIG_BLOCK_MAGIC2(howto, gate_ff);
 %include "howto/detector_ff.h"